@@ -94,6 +94,7 @@ void internal_aes_gcm_ghash_update(struct internal_aes_gcm_state *state,
 	put_be_block(state->hash_state, dg);
 }
 
+#ifdef ARM64
 static void encrypt_pl(struct internal_aes_gcm_state *state,
 		       const struct internal_aes_gcm_key *ek, uint64_t dg[2],
 		       const uint8_t *src, size_t num_blocks, uint8_t *dst)
@@ -132,7 +133,6 @@ static void decrypt_pl(struct internal_aes_gcm_state *state,
 	}
 }
 
-#ifdef ARM64
 static void update_payload_2block(struct internal_aes_gcm_state *state,
 				  const struct internal_aes_gcm_key *ek,
 				  uint64_t dg[2], TEE_OperationMode mode,
@@ -168,6 +168,36 @@ static void update_payload_2block(struct internal_aes_gcm_state *state,
 	}
 }
 
+static void update_payload_4block(struct internal_aes_gcm_state *state,
+				  const struct internal_aes_gcm_key *ek,
+				  uint64_t dg[2], TEE_OperationMode mode,
+				  const void *src, size_t num_blocks, void *dst)
+{
+	assert(num_blocks && !(num_blocks % 4));
+
+	if (mode == TEE_MODE_ENCRYPT) {
+		/*
+		 * pmull_gcm_encrypt_4x() computes the key stream itself,
+		 * so rewind the counter to the block the key stream in
+		 * buf_cryp was computed for. When done buf_cryp is updated
+		 * with the key stream of the block following the last
+		 * one, as expected by the callers.
+		 */
+		internal_aes_gcm_dec_ctr(state);
+		pmull_gcm_encrypt_4x(num_blocks, dg, dst, src,
+				     &state->ghash_key, state->ctr, ek->data,
+				     ek->rounds);
+		pmull_gcm_load_round_keys(ek->data, ek->rounds);
+		pmull_gcm_encrypt_block(state->buf_cryp, (uint8_t *)state->ctr,
+					ek->rounds);
+		internal_aes_gcm_inc_ctr(state);
+	} else {
+		pmull_gcm_decrypt_4x(num_blocks, dg, dst, src,
+				     &state->ghash_key, state->ctr, ek->data,
+				     ek->rounds);
+	}
+}
+
 /* Overriding the __weak function */
 void
 internal_aes_gcm_update_payload_blocks(struct internal_aes_gcm_state *state,
@@ -175,17 +205,30 @@ internal_aes_gcm_update_payload_blocks(struct internal_aes_gcm_state *state,
 				       TEE_OperationMode mode, const void *src,
 				       size_t num_blocks, void *dst)
 {
-	size_t nb = ROUNDDOWN(num_blocks, 2);
+	size_t nb4 = ROUNDDOWN(num_blocks, 4);
+	size_t nb = 0;
 	uint32_t vfp_state = 0;
 	uint64_t dg[2] = { 0 };
 
 	get_be_block(dg, state->hash_state);
 	vfp_state = thread_kernel_enable_vfp();
 
+	/*
+	 * The bulk is handled four blocks at a time by
+	 * pmull_gcm_encrypt_4x() and pmull_gcm_decrypt_4x().
+	 */
+	if (nb4) {
+		update_payload_4block(state, ek, dg, mode, src, nb4, dst);
+		src = (const uint8_t *)src + nb4 * TEE_AES_BLOCK_SIZE;
+		dst = (uint8_t *)dst + nb4 * TEE_AES_BLOCK_SIZE;
+		num_blocks -= nb4;
+	}
+
 	/*
 	 * pmull_gcm_encrypt() and pmull_gcm_decrypt() can only handle
 	 * blocks in multiples of two.
 	 */
+	nb = ROUNDDOWN(num_blocks, 2);
 	if (nb)
 		update_payload_2block(state, ek, dg, mode, src, nb, dst);
 
@@ -206,6 +249,44 @@ internal_aes_gcm_update_payload_blocks(struct internal_aes_gcm_state *state,
 #endif /*ARM64*/
 
 #ifdef ARM32
+/*
+ * Number of blocks processed by each pass of update_payload_chunked(),
+ * small enough to keep the chunk in the L1 data cache between the passes.
+ */
+#define GCM_CHUNK_BLOCKS	64
+
+/*
+ * There aren't enough NEON registers on AArch32 to keep the round keys
+ * and the state of an aggregated GHASH at the same time, so instead of a
+ * fused kernel the payload is processed in chunks with one AES-CTR pass
+ * and one GHASH pass each. This still amortizes the loading of the round
+ * keys and lets ce_aes_ctr_encrypt() interleave three blocks at a time.
+ */
+static void update_payload_chunked(struct internal_aes_gcm_state *state,
+				   const struct internal_aes_gcm_key *ek,
+				   uint64_t dg[2], TEE_OperationMode mode,
+				   const uint8_t *src, size_t num_blocks,
+				   uint8_t *dst)
+{
+	size_t n = 0;
+
+	while (num_blocks) {
+		n = MIN(num_blocks, (size_t)GCM_CHUNK_BLOCKS);
+
+		/* Hash the ciphertext before it may be overwritten */
+		if (mode == TEE_MODE_DECRYPT)
+			pmull_ghash_update(n, dg, src, &state->ghash_key, NULL);
+		ce_aes_ctr_encrypt(dst, src, (const uint8_t *)ek->data,
+				   ek->rounds, n, (uint8_t *)state->ctr, 1);
+		if (mode == TEE_MODE_ENCRYPT)
+			pmull_ghash_update(n, dg, dst, &state->ghash_key, NULL);
+
+		src += n * TEE_AES_BLOCK_SIZE;
+		dst += n * TEE_AES_BLOCK_SIZE;
+		num_blocks -= n;
+	}
+}
+
 /* Overriding the __weak function */
 void
 internal_aes_gcm_update_payload_blocks(struct internal_aes_gcm_state *state,
@@ -220,10 +301,18 @@ internal_aes_gcm_update_payload_blocks(struct internal_aes_gcm_state *state,
 	get_be_block(dg, state->hash_state);
 	vfp_state = thread_kernel_enable_vfp();
 
-	if (mode == TEE_MODE_ENCRYPT)
-		encrypt_pl(state, ek, dg, src, num_blocks, dst);
-	else
-		decrypt_pl(state, ek, dg, src, num_blocks, dst);
+	if (mode == TEE_MODE_ENCRYPT) {
+		/* See update_payload_4block() above */
+		internal_aes_gcm_dec_ctr(state);
+		update_payload_chunked(state, ek, dg, mode, src, num_blocks,
+				       dst);
+		ce_aes_ecb_encrypt(state->buf_cryp, (const uint8_t *)state->ctr,
+				   (const uint8_t *)ek->data, ek->rounds, 1, 1);
+		internal_aes_gcm_inc_ctr(state);
+	} else {
+		update_payload_chunked(state, ek, dg, mode, src, num_blocks,
+				       dst);
+	}
 
 	thread_kernel_disable_vfp(vfp_state);
 	put_be_block(state->hash_state, dg);
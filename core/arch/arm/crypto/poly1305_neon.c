@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <assert.h>
+#include <crypto/crypto_accel.h>
+#include <kernel/thread.h>
+
+/* Prototype for assembly function */
+void poly1305_neon_blocks(uint32_t h[5], const uint32_t r[5],
+			  const uint8_t *src, unsigned int blocks);
+
+void crypto_accel_poly1305_blocks(uint32_t h[5], const uint32_t r[5],
+				  const void *src, unsigned int block_count)
+{
+	uint32_t vfp_state = 0;
+
+	assert(block_count && !(block_count & 1));
+
+	vfp_state = thread_kernel_enable_vfp();
+	poly1305_neon_blocks(h, r, src, block_count);
+	thread_kernel_disable_vfp(vfp_state);
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <arm.h>
+#include <crypto/crypto_accel.h>
+#include <kernel/thread.h>
+#include <stdbool.h>
+
+/* Prototype for assembly function */
+void sha512_ce_transform(uint64_t state[8], const void *src,
+			 unsigned int block_count);
+
+/* Result of probing ID_AA64ISAR0_EL1, only written once it's known */
+static enum { INSNS_UNKNOWN, INSNS_ABSENT, INSNS_PRESENT } sha512_insns;
+
+static bool have_sha512_insns(void)
+{
+	uint64_t isar0 = 0;
+
+	if (sha512_insns == INSNS_UNKNOWN) {
+		isar0 = read_id_aa64isar0_el1();
+		if (((isar0 >> ID_AA64ISAR0_EL1_SHA2_SHIFT) &
+		     ID_AA64ISAR0_EL1_SHA2_MASK) >= FEAT_SHA512_IMPLEMENTED)
+			sha512_insns = INSNS_PRESENT;
+		else
+			sha512_insns = INSNS_ABSENT;
+	}
+
+	return sha512_insns == INSNS_PRESENT;
+}
+
+TEE_Result crypto_accel_sha512_compress(uint64_t state[8], const void *src,
+					unsigned int block_count)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sha512_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sha512_ce_transform(state, src, block_count);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <arm.h>
+#include <crypto/crypto_accel.h>
+#include <kernel/thread.h>
+#include <stdbool.h>
+
+/* Prototype for assembly function */
+void sm3_ce_transform(uint32_t state[8], const void *src,
+		      unsigned int block_count);
+
+static enum { INSNS_UNKNOWN, INSNS_ABSENT, INSNS_PRESENT } sm3_insns;
+
+static bool have_sm3_insns(void)
+{
+	uint64_t isar0 = 0;
+
+	if (sm3_insns == INSNS_UNKNOWN) {
+		isar0 = read_id_aa64isar0_el1();
+		if (((isar0 >> ID_AA64ISAR0_EL1_SM3_SHIFT) &
+		     ID_AA64ISAR0_EL1_SM3_MASK) >= FEAT_SM3_IMPLEMENTED)
+			sm3_insns = INSNS_PRESENT;
+		else
+			sm3_insns = INSNS_ABSENT;
+	}
+
+	return sm3_insns == INSNS_PRESENT;
+}
+
+TEE_Result crypto_accel_sm3_compress(uint32_t state[8], const void *src,
+				     unsigned int block_count)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sm3_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sm3_ce_transform(state, src, block_count);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <arm.h>
+#include <crypto/crypto_accel.h>
+#include <kernel/thread.h>
+#include <stdbool.h>
+
+/* Prototypes for assembly functions */
+void sm4_ce_crypt_ecb(void *out, const void *in, const uint32_t rk[32],
+		      unsigned int block_count);
+void sm4_ce_cbc_encrypt(void *out, const void *in, const uint32_t rk[32],
+			unsigned int block_count, void *iv);
+void sm4_ce_cbc_decrypt(void *out, const void *in, const uint32_t rk[32],
+			unsigned int block_count, void *iv);
+void sm4_ce_ctr_encrypt(void *out, const void *in, const uint32_t rk[32],
+			unsigned int block_count, void *ctr);
+
+static enum { INSNS_UNKNOWN, INSNS_ABSENT, INSNS_PRESENT } sm4_insns;
+
+static bool have_sm4_insns(void)
+{
+	uint64_t isar0 = 0;
+
+	if (sm4_insns == INSNS_UNKNOWN) {
+		isar0 = read_id_aa64isar0_el1();
+		if (((isar0 >> ID_AA64ISAR0_EL1_SM4_SHIFT) &
+		     ID_AA64ISAR0_EL1_SM4_MASK) >= FEAT_SM4_IMPLEMENTED)
+			sm4_insns = INSNS_PRESENT;
+		else
+			sm4_insns = INSNS_ABSENT;
+	}
+
+	return sm4_insns == INSNS_PRESENT;
+}
+
+TEE_Result crypto_accel_sm4_ecb(void *out, const void *in,
+				const uint32_t rk[32],
+				unsigned int block_count)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sm4_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sm4_ce_crypt_ecb(out, in, rk, block_count);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
+
+TEE_Result crypto_accel_sm4_cbc_enc(void *out, const void *in,
+				    const uint32_t rk[32],
+				    unsigned int block_count, void *iv)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sm4_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sm4_ce_cbc_encrypt(out, in, rk, block_count, iv);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
+
+TEE_Result crypto_accel_sm4_cbc_dec(void *out, const void *in,
+				    const uint32_t rk[32],
+				    unsigned int block_count, void *iv)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sm4_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sm4_ce_cbc_decrypt(out, in, rk, block_count, iv);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
+
+TEE_Result crypto_accel_sm4_ctr_be_enc(void *out, const void *in,
+				       const uint32_t rk[32],
+				       unsigned int block_count, void *iv)
+{
+	uint32_t vfp_state = 0;
+
+	if (!have_sm4_insns())
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	vfp_state = thread_kernel_enable_vfp();
+	sm4_ce_ctr_encrypt(out, in, rk, block_count, iv);
+	thread_kernel_disable_vfp(vfp_state);
+
+	return TEE_SUCCESS;
+}
@@ -22,3 +22,32 @@ srcs-y += sha256_armv8a_ce.c
 srcs-$(CFG_ARM64_core) += sha256_armv8a_ce_a64.S
 srcs-$(CFG_ARM32_core) += sha256_armv8a_ce_a32.S
 endif
+
+ifeq ($(CFG_CRYPTO_SHA512_ARM_CE),y)
+srcs-$(CFG_ARM64_core) += sha512_armv8a_ce.c
+srcs-$(CFG_ARM64_core) += sha512_armv8a_ce_a64.S
+endif
+
+ifeq ($(CFG_CRYPTO_SM3_ARM_CE),y)
+srcs-$(CFG_ARM64_core) += sm3_armv8a_ce.c
+srcs-$(CFG_ARM64_core) += sm3_armv8a_ce_a64.S
+endif
+
+ifeq ($(CFG_CRYPTO_SM4_ARM_CE),y)
+srcs-$(CFG_ARM64_core) += sm4_armv8a_ce.c
+srcs-$(CFG_ARM64_core) += sm4_armv8a_ce_a64.S
+endif
+
+ifeq ($(CFG_CRYPTO_CHACHA20_POLY1305_ARM_NEON),y)
+srcs-y += chacha20_neon.c
+srcs-$(CFG_ARM64_core) += chacha20_neon_a64.S
+srcs-$(CFG_ARM32_core) += chacha20_neon_a32.S
+srcs-y += poly1305_neon.c
+srcs-$(CFG_ARM64_core) += poly1305_neon_a64.S
+srcs-$(CFG_ARM32_core) += poly1305_neon_a32.S
+endif
+
+ifeq ($(CFG_CRYPTO_MPI_ARM_ASM),y)
+srcs-$(CFG_ARM64_core) += mpi_montmul_a64.S
+srcs-$(CFG_ARM32_core) += mpi_montmul_a32.S
+endif
@@ -36,6 +36,21 @@ void pmull_gcm_decrypt(int blocks, uint64_t dg[2], uint8_t dst[],
 		       const struct internal_ghash_key *ghash_key,
 		       uint64_t ctr[], const uint64_t rk[], int rounds);
 
+/*
+ * Fused AES-CTR and GHASH processing four blocks at a time, @blocks must
+ * be a non-zero multiple of 4. The key stream is computed from @ctr which
+ * is updated to the counter following the last block.
+ */
+void pmull_gcm_encrypt_4x(int blocks, uint64_t dg[2], uint8_t dst[],
+			  const uint8_t src[],
+			  const struct internal_ghash_key *ghash_key,
+			  uint64_t ctr[], const uint64_t rk[], int rounds);
+
+void pmull_gcm_decrypt_4x(int blocks, uint64_t dg[2], uint8_t dst[],
+			  const uint8_t src[],
+			  const struct internal_ghash_key *ghash_key,
+			  uint64_t ctr[], const uint64_t rk[], int rounds);
+
 uint32_t pmull_gcm_aes_sub(uint32_t input);
 
 void pmull_gcm_encrypt_block(uint8_t dst[], const uint8_t src[], int rounds);
@@ -614,6 +614,58 @@ bool thread_is_in_normal_mode(void);
  */
 bool thread_is_from_abort_mode(void);
 
+/*
+ * struct thread_admission_stats - statistics of the thread admission queue
+ * @depth:		Number of calls currently waiting for a thread
+ * @max_depth:		Largest number of calls waiting at the same time
+ * @admitted:		Number of calls assigned a thread after waiting
+ * @expired:		Number of calls dropped from the queue after
+ *			CFG_CORE_THREAD_ADMISSION_TIMEOUT_MS
+ * @overflows:		Number of calls refused while the queue was full
+ * @avg_wait_us:	Average time in microseconds admitted calls waited
+ * @max_wait_us:	Longest time in microseconds an admitted call waited
+ */
+struct thread_admission_stats {
+	uint32_t depth;
+	uint32_t max_depth;
+	uint32_t admitted;
+	uint32_t expired;
+	uint32_t overflows;
+	uint32_t avg_wait_us;
+	uint32_t max_wait_us;
+};
+
+/*
+ * struct thread_core_stats - per core statistics of thread scheduling
+ * @allocs:		Number of threads allocated for standard calls
+ * @alloc_migrations:	Number of those threads last run on another core
+ * @resumes:		Number of threads resumed from RPC
+ * @resume_migrations:	Number of those threads last run on another core
+ */
+struct thread_core_stats {
+	uint32_t allocs;
+	uint32_t alloc_migrations;
+	uint32_t resumes;
+	uint32_t resume_migrations;
+};
+
+/*
+ * thread_get_core_stats() - Get thread scheduling statistics of a core
+ * @core_pos:	Core position, less than CFG_TEE_CORE_NB_CORE
+ * @stats:	Returned statistics
+ */
+void thread_get_core_stats(size_t core_pos, struct thread_core_stats *stats);
+
+#ifdef CFG_CORE_THREAD_ADMISSION
+void thread_get_admission_stats(struct thread_admission_stats *stats);
+#else
+static inline void
+thread_get_admission_stats(struct thread_admission_stats *stats)
+{
+	*stats = (struct thread_admission_stats){ };
+}
+#endif
+
 /*
  * Disables and empties the prealloc RPC cache one reference at a time. If
  * all threads are idle this function returns true and a cookie of one shm
@@ -463,6 +463,19 @@ void core_mmu_get_user_map(struct core_mmu_user_map *map);
  */
 void core_mmu_set_user_map(struct core_mmu_user_map *map);
 
+/*
+ * core_mmu_set_user_page() - Update a page of the active user VA space
+ * @va:		Page aligned user virtual address
+ * @pa:		Physical address to map
+ * @attr:	TEE_MATTR_* attributes of the mapping
+ *
+ * Updates the translation table populated by core_mmu_create_user_map()
+ * for the current thread without reallocating any tables, so it can be
+ * used from the abort handler. The page must be covered by a region of
+ * the user mode context.
+ */
+void core_mmu_set_user_page(vaddr_t va, paddr_t pa, uint32_t attr);
+
 /*
  * struct core_mmu_table_info - Properties for a translation table
  * @table:	Pointer to translation table
@@ -4,15 +4,18 @@
  */
 
 #include <arm.h>
+#include <config.h>
 #include <kernel/abort.h>
 #include <kernel/linker.h>
 #include <kernel/misc.h>
 #include <kernel/panic.h>
+#include <kernel/spinlock.h>
 #include <kernel/tee_ta_manager.h>
 #include <kernel/user_mode_ctx.h>
 #include <mm/core_mmu.h>
 #include <mm/mobj.h>
 #include <mm/tee_pager.h>
+#include <mm/vm.h>
 #include <tee/tee_svc.h>
 #include <trace.h>
 #include <unw/unwind.h>
@@ -454,6 +457,35 @@ bool abort_is_write_fault(struct abort_info *ai)
 	       (ai->fault_descr & BIT(write_not_read));
 }
 
+/*
+ * A write to a page shared copy-on-write, from user mode or by TEE core
+ * accessing user memory, is resolved by giving the page a private copy.
+ */
+static bool handle_cow_fault(struct abort_info *ai)
+{
+	struct ts_ctx *ctx = NULL;
+
+	if (!IS_ENABLED(CFG_TA_SHARE_RELOC_PAGES) ||
+	    !abort_is_write_fault(ai) ||
+	    core_mmu_get_fault_type(ai->fault_descr) !=
+	    CORE_MMU_FAULT_WRITE_PERMISSION ||
+	    thread_get_id_may_fail() == THREAD_ID_INVALID)
+		return false;
+
+	ctx = thread_get_tsd()->ctx;
+	if (!is_user_mode_ctx(ctx))
+		return false;
+
+	/*
+	 * Breaking the page allocates memory, which takes spinlocks. Core
+	 * code must not access user memory while holding a spinlock, if
+	 * it did we could deadlock here.
+	 */
+	assert_have_no_spinlock();
+
+	return vm_handle_cow_fault(to_user_mode_ctx(ctx), ai->va);
+}
+
 static enum fault_type get_fault_type(struct abort_info *ai)
 {
 	if (abort_is_user_exception(ai)) {
@@ -528,6 +560,8 @@ void abort_handler(uint32_t abort_type, struct thread_abort_regs *regs)
 	case FAULT_TYPE_IGNORE:
 		break;
 	case FAULT_TYPE_USER_MODE_PANIC:
+		if (handle_cow_fault(&ai))
+			break;
 		DMSG("[abort] abort in User mode (TA will panic)");
 		save_abort_info_in_tsd(&ai);
 		vfp_disable();
@@ -544,6 +578,8 @@ void abort_handler(uint32_t abort_type, struct thread_abort_regs *regs)
 			abort_print_error(&ai);
 			panic("abort outside thread context");
 		}
+		if (handle_cow_fault(&ai))
+			break;
 		thread_kernel_save_vfp();
 		handled = tee_pager_handle_fault(&ai);
 		thread_kernel_restore_vfp();
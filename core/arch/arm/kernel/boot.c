@@ -15,6 +15,7 @@
 #include <keep.h>
 #include <kernel/asan.h>
 #include <kernel/boot.h>
+#include <kernel/boot_profile.h>
 #include <kernel/linker.h>
 #include <kernel/misc.h>
 #include <kernel/panic.h>
@@ -1337,6 +1338,7 @@ void __weak boot_init_primary_late(unsigned long fdt)
 	}
 
 	call_finalcalls();
+	boot_profile_print();
 	IMSG("Primary CPU switching to normal world boot");
 }
 
@@ -8,6 +8,7 @@
 #include <ffa.h>
 #include <keep.h>
 #include <kernel/abort.h>
+#include <kernel/lz4.h>
 #include <kernel/stmm_sp.h>
 #include <kernel/user_mode_ctx.h>
 #include <mm/fobj.h>
@@ -75,6 +76,7 @@ static const unsigned int stmm_ns_comm_buf_size = 4 * SMALL_PAGE_SIZE;
 extern unsigned char stmm_image[];
 extern const unsigned int stmm_image_size;
 extern const unsigned int stmm_image_uncompressed_size;
+extern const unsigned int stmm_image_lz4;
 
 static struct stmm_ctx *stmm_alloc_ctx(const TEE_UUID *uuid)
 {
@@ -205,6 +207,12 @@ static void uncompress_image(void *dst, size_t dst_size, void *src,
 		.zfree = zfree,
 	};
 
+	if (stmm_image_lz4) {
+		if (lz4_unpack(src, src_size, dst, dst_size))
+			panic("lz4_unpack");
+		return;
+	}
+
 	if (inflateInit(&strm) != Z_OK)
 		panic("inflateInit");
 
@@ -14,6 +14,7 @@
 #include <keep.h>
 #include <kernel/asan.h>
 #include <kernel/boot.h>
+#include <kernel/delay.h>
 #include <kernel/linker.h>
 #include <kernel/lockdep.h>
 #include <kernel/misc.h>
@@ -32,6 +33,7 @@
 #include <mm/vm.h>
 #include <smccc.h>
 #include <sm/sm.h>
+#include <string.h>
 #include <trace.h>
 #include <util.h>
 
@@ -41,6 +43,11 @@ struct thread_ctx threads[CFG_NUM_THREADS];
 
 struct thread_core_local thread_core_local[CFG_TEE_CORE_NB_CORE] __nex_bss;
 
+/* Protected by thread_global_lock */
+static struct thread_core_stats thread_core_stats[CFG_TEE_CORE_NB_CORE];
+
+#define THREAD_CORE_POS_NONE	SIZE_MAX
+
 /*
  * Stacks
  *
@@ -534,6 +541,130 @@ void __nostackcheck thread_clr_boot_thread(void)
 	l->curr_thread = THREAD_ID_INVALID;
 }
 
+#ifdef CFG_CORE_THREAD_ADMISSION
+/*
+ * Admission queue of calls which couldn't be served because all threads
+ * were busy. A call is identified by its first four arguments, with the
+ * SMC ABI that is the function ID and the physical address of the
+ * message buffer which is unique for each call in progress. The normal
+ * world retries a call refused with OPTEE_SMC_RETURN_ETHREAD_LIMIT once
+ * another call has returned. Free threads are reserved for the queued
+ * calls, any of them retrying while a thread is free is admitted since
+ * the normal world may wake its waiters in any order and a free thread
+ * must not be left idle waiting for the head of the queue. Calls not
+ * queued only get the threads left over. Entries not retried within
+ * CFG_CORE_THREAD_ADMISSION_TIMEOUT_MS are dropped to bound the time a
+ * thread can be held back for a caller which has given up.
+ *
+ * Protected by thread_global_lock.
+ */
+struct admission_entry {
+	uint32_t args[4];
+	uint64_t stamp;
+};
+
+static struct admission_entry
+	admission_queue[CFG_CORE_THREAD_ADMISSION_QUEUE_SIZE];
+static size_t admission_count;
+static struct thread_admission_stats admission_stats;
+static uint64_t admission_total_wait;
+
+static uint32_t admission_cnt2us(uint64_t cnt)
+{
+	return (cnt * 1000000ULL) / read_cntfrq();
+}
+
+static void admission_remove(size_t idx)
+{
+	admission_count--;
+	memmove(admission_queue + idx, admission_queue + idx + 1,
+		(admission_count - idx) * sizeof(struct admission_entry));
+	admission_stats.depth = admission_count;
+}
+
+static void admission_expire(uint64_t now)
+{
+	uint64_t timeout = arm_cnt_us2cnt(CFG_CORE_THREAD_ADMISSION_TIMEOUT_MS *
+					  1000);
+
+	while (admission_count && now - admission_queue[0].stamp > timeout) {
+		admission_remove(0);
+		admission_stats.expired++;
+	}
+}
+
+static int admission_find(const uint32_t args[4])
+{
+	size_t n = 0;
+
+	for (n = 0; n < admission_count; n++)
+		if (!memcmp(admission_queue[n].args, args,
+			    sizeof(admission_queue[n].args)))
+			return n;
+
+	return -1;
+}
+
+/*
+ * Called with thread_global_lock held. Returns true if the call
+ * described by @args may be assigned one of the @num_free free threads.
+ */
+static bool thread_admit(const uint32_t args[4], size_t num_free)
+{
+	uint64_t now = barrier_read_counter_timer();
+	uint64_t wait = 0;
+	int pos = 0;
+
+	admission_expire(now);
+	pos = admission_find(args);
+
+	if (pos < 0) {
+		/* Free threads not claimed by queued calls may be used */
+		if (num_free > admission_count)
+			return true;
+		if (admission_count == ARRAY_SIZE(admission_queue)) {
+			admission_stats.overflows++;
+			return false;
+		}
+		memcpy(admission_queue[admission_count].args, args,
+		       sizeof(admission_queue[admission_count].args));
+		admission_queue[admission_count].stamp = now;
+		admission_count++;
+		admission_stats.depth = admission_count;
+		admission_stats.max_depth = MAX(admission_stats.max_depth,
+						admission_stats.depth);
+		return false;
+	}
+
+	if (!num_free)
+		return false;
+
+	wait = now - admission_queue[pos].stamp;
+	admission_remove(pos);
+	admission_stats.admitted++;
+	admission_total_wait += wait;
+	admission_stats.max_wait_us = MAX(admission_stats.max_wait_us,
+					  admission_cnt2us(wait));
+	return true;
+}
+
+void thread_get_admission_stats(struct thread_admission_stats *stats)
+{
+	thread_lock_global();
+	*stats = admission_stats;
+	if (admission_stats.admitted)
+		stats->avg_wait_us = admission_cnt2us(admission_total_wait /
+						      admission_stats.admitted);
+	thread_unlock_global();
+}
+#else
+static bool thread_admit(const uint32_t args[4] __unused,
+			 size_t num_free __unused)
+{
+	return true;
+}
+#endif /*CFG_CORE_THREAD_ADMISSION*/
+
 static void __thread_alloc_and_run(uint32_t a0, uint32_t a1, uint32_t a2,
 				   uint32_t a3, uint32_t a4, uint32_t a5,
 				   uint32_t a6, uint32_t a7,
@@ -541,18 +672,42 @@ static void __thread_alloc_and_run(uint32_t a0, uint32_t a1, uint32_t a2,
 {
 	size_t n;
 	struct thread_core_local *l = thread_get_core_local();
+	const uint32_t args[4] = { a0, a1, a2, a3 };
+	size_t core_pos = get_core_pos();
 	bool found_thread = false;
+	size_t num_free = 0;
+	size_t free_idx = 0;
 
 	assert(l->curr_thread == THREAD_ID_INVALID);
 
 	thread_lock_global();
 
+	/*
+	 * Prefer a free thread which last ran on this core since its stack
+	 * is more likely to still be in the caches of this core, else
+	 * take the first free thread.
+	 */
 	for (n = 0; n < CFG_NUM_THREADS; n++) {
-		if (threads[n].state == THREAD_STATE_FREE) {
-			threads[n].state = THREAD_STATE_ACTIVE;
-			found_thread = true;
+		if (threads[n].state != THREAD_STATE_FREE)
+			continue;
+		if (!num_free || (threads[n].last_core_pos == core_pos &&
+				  threads[free_idx].last_core_pos != core_pos))
+			free_idx = n;
+		num_free++;
+		if (!IS_ENABLED(CFG_CORE_THREAD_ADMISSION) &&
+		    threads[free_idx].last_core_pos == core_pos)
 			break;
-		}
+	}
+
+	if (thread_admit(args, num_free) && num_free) {
+		n = free_idx;
+		threads[n].state = THREAD_STATE_ACTIVE;
+		thread_core_stats[core_pos].allocs++;
+		if (threads[n].last_core_pos != core_pos &&
+		    threads[n].last_core_pos != THREAD_CORE_POS_NONE)
+			thread_core_stats[core_pos].alloc_migrations++;
+		threads[n].last_core_pos = core_pos;
+		found_thread = true;
 	}
 
 	thread_unlock_global();
@@ -674,6 +829,7 @@ void thread_resume_from_rpc(uint32_t thread_id, uint32_t a0, uint32_t a1,
 {
 	size_t n = thread_id;
 	struct thread_core_local *l = thread_get_core_local();
+	size_t core_pos = get_core_pos();
 	bool found_thread = false;
 
 	assert(l->curr_thread == THREAD_ID_INVALID);
@@ -682,6 +838,10 @@ void thread_resume_from_rpc(uint32_t thread_id, uint32_t a0, uint32_t a1,
 
 	if (n < CFG_NUM_THREADS && threads[n].state == THREAD_STATE_SUSPENDED) {
 		threads[n].state = THREAD_STATE_ACTIVE;
+		thread_core_stats[core_pos].resumes++;
+		if (threads[n].last_core_pos != core_pos)
+			thread_core_stats[core_pos].resume_migrations++;
+		threads[n].last_core_pos = core_pos;
 		found_thread = true;
 	}
 
@@ -1083,9 +1243,19 @@ void thread_init_threads(void)
 	for (n = 0; n < CFG_NUM_THREADS; n++) {
 		TAILQ_INIT(&threads[n].tsd.sess_stack);
 		SLIST_INIT(&threads[n].tsd.pgt_cache);
+		threads[n].last_core_pos = THREAD_CORE_POS_NONE;
 	}
 }
 
+void thread_get_core_stats(size_t core_pos, struct thread_core_stats *stats)
+{
+	assert(core_pos < CFG_TEE_CORE_NB_CORE);
+
+	thread_lock_global();
+	*stats = thread_core_stats[core_pos];
+	thread_unlock_global();
+}
+
 void __nostackcheck thread_init_thread_core_local(void)
 {
 	size_t n = 0;
@@ -1646,6 +1646,9 @@ static void set_pg_region(struct core_mmu_table_info *dir_info,
 			if (mobj_get_pa(region->mobj, offset, granule,
 					&r.pa) != TEE_SUCCESS)
 				panic("Failed to get PA of unpaged mobj");
+			r.attr = region->attr;
+			if (vm_region_page_is_cow(region, offset))
+				r.attr &= ~(TEE_MATTR_UW | TEE_MATTR_PW);
 			set_region(pg_info, &r);
 		}
 		r.va += r.size;
@@ -1938,6 +1941,28 @@ void core_mmu_populate_user_map(struct core_mmu_table_info *dir_info,
 		set_pg_region(dir_info, r, &pgt, &pg_info);
 }
 
+void core_mmu_set_user_page(vaddr_t va, paddr_t pa, uint32_t attr)
+{
+	struct pgt_cache *pgt_cache = &thread_get_tsd()->pgt_cache;
+	vaddr_t vabase = ROUNDDOWN(va, CORE_MMU_PGDIR_SIZE);
+	struct pgt *pgt = NULL;
+
+	assert(!(va & SMALL_PAGE_MASK));
+
+	SLIST_FOREACH(pgt, pgt_cache, link) {
+		if (pgt->vabase != vabase)
+			continue;
+
+		core_mmu_set_entry_primitive(pgt->tbl, CORE_MMU_PGDIR_LEVEL,
+					     (va - vabase) / SMALL_PAGE_SIZE,
+					     pa, attr);
+		tlbi_mva_allasid(va);
+		return;
+	}
+
+	panic("No translation table for user page");
+}
+
 TEE_Result core_mmu_remove_mapping(enum teecore_memtypes type, void *addr,
 				   size_t len)
 {
@@ -121,6 +121,7 @@ static const struct syscall_entry tee_svc_syscall_table[] = {
 	SYSCALL_ENTRY(syscall_not_supported),
 	SYSCALL_ENTRY(syscall_not_supported),
 	SYSCALL_ENTRY(syscall_cache_operation),
+	SYSCALL_ENTRY(syscall_cryp_update_vec),
 };
 
 /*
@@ -141,6 +142,7 @@ static const struct syscall_entry ldelf_syscall_table[] = {
 	SYSCALL_ENTRY(ldelf_syscall_set_prot),
 	SYSCALL_ENTRY(ldelf_syscall_remap),
 	SYSCALL_ENTRY(ldelf_syscall_gen_rnd_num),
+	SYSCALL_ENTRY(ldelf_syscall_share_reloc),
 };
 
 #ifdef TRACE_SYSCALLS
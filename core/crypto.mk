@@ -47,10 +47,25 @@ CFG_CRYPTO_ECC ?= y
 CFG_CRYPTO_SM2_PKE ?= y
 CFG_CRYPTO_SM2_DSA ?= y
 CFG_CRYPTO_SM2_KEP ?= y
+# Curve25519 based X25519 key agreement (RFC 7748) and pure Ed25519
+# signatures (RFC 8032)
+CFG_CRYPTO_X25519 ?= y
+CFG_CRYPTO_ED25519 ?= y
+# Precomputed fixed-base comb tables for the P-256 and P-384 generators,
+# speeds up ECDSA signing and ECC key generation with LibTomCrypt. The
+# tables are built on first use and take 3 KiB of heap per curve.
+CFG_CRYPTO_ECC_COMB ?= y
+# Dedicated constant-time P-256 field and point arithmetic with fixed size
+# limbs for ECDSA and ECDH, used instead of the generic LibTomCrypt code
+# for TEE_ECC_CURVE_NIST_P256.
+CFG_CRYPTO_ECC_P256_CT ?= y
 
 # Authenticated encryption
 CFG_CRYPTO_CCM ?= y
 CFG_CRYPTO_GCM ?= y
+# ChaCha20-Poly1305 (RFC 8439), exposed as the OP-TEE extension
+# TEE_ALG_CHACHA20_POLY1305
+CFG_CRYPTO_CHACHA20_POLY1305 ?= y
 # Default uses the OP-TEE internal AES-GCM implementation
 CFG_CRYPTO_AES_GCM_FROM_CRYPTOLIB ?= n
 
@@ -63,7 +78,7 @@ CFG_CRYPTO_SHA256:=y
 endif
 endif
 
-$(eval $(call cryp-enable-all-depends,CFG_WITH_SOFTWARE_PRNG, AES ECB SHA256))
+$(eval $(call cryp-enable-all-depends,CFG_WITH_SOFTWARE_PRNG, AES ECB CTR SHA256))
 
 ifeq ($(CFG_CRYPTO_WITH_CE),y)
 
@@ -82,12 +97,59 @@ CFG_CORE_CRYPTO_SHA1_ACCEL ?= $(CFG_CRYPTO_SHA1_ARM_CE)
 CFG_CRYPTO_AES_ARM_CE ?= $(CFG_CRYPTO_AES)
 CFG_CORE_CRYPTO_AES_ACCEL ?= $(CFG_CRYPTO_AES_ARM_CE)
 
+# CFG_TA_MBEDTLS_ARM_CE builds the AES, GHASH, SHA-1 and SHA-256 routines
+# above into the TA flavour of libmbedtls too. User mode depends on the
+# lazy enabling of the VFP/NEON unit in the core, so CFG_WITH_VFP is needed.
+CFG_TA_MBEDTLS_ARM_CE ?= $(CFG_WITH_VFP)
+
+# The SHA-512 instructions (FEAT_SHA512) are an optional ARMv8.2 extension
+# of AArch64 only. When enabled, support is probed at runtime from
+# ID_AA64ISAR0_EL1 and the compression function of LibTomCrypt is used on
+# CPUs without it. The same transform serves SHA-384, SHA-512/256 and HMAC
+# over these. MbedTLS can't fall back once its compression function is
+# replaced, so it always uses its own.
+# The SM3 and SM4 instructions (FEAT_SM3, FEAT_SM4) are optional ARMv8.2
+# AArch64 extensions too and are probed the same way, the generic C code
+# in core/crypto is used when they are missing.
+ifeq ($(CFG_ARM64_core),y)
+CFG_CRYPTO_SHA512_ARM_CE ?= $(call cfg-one-enabled, CFG_CRYPTO_SHA384 \
+					CFG_CRYPTO_SHA512 CFG_CRYPTO_SHA512_256)
+CFG_CRYPTO_SM3_ARM_CE ?= $(CFG_CRYPTO_SM3)
+CFG_CRYPTO_SM4_ARM_CE ?= $(CFG_CRYPTO_SM4)
+else
+$(call force,CFG_CRYPTO_SHA512_ARM_CE,n,only available on AArch64)
+$(call force,CFG_CRYPTO_SM3_ARM_CE,n,only available on AArch64)
+$(call force,CFG_CRYPTO_SM4_ARM_CE,n,only available on AArch64)
+endif
+CFG_CORE_CRYPTO_SHA512_ACCEL ?= $(CFG_CRYPTO_SHA512_ARM_CE)
+CFG_CORE_CRYPTO_SM3_ACCEL ?= $(CFG_CRYPTO_SM3_ARM_CE)
+CFG_CORE_CRYPTO_SM4_ACCEL ?= $(CFG_CRYPTO_SM4_ARM_CE)
+
 else #CFG_CRYPTO_WITH_CE
 
 CFG_AES_GCM_TABLE_BASED ?= y
+$(call force,CFG_TA_MBEDTLS_ARM_CE,n,requires CFG_CRYPTO_WITH_CE)
 
 endif #!CFG_CRYPTO_WITH_CE
 
+# ChaCha20 and Poly1305 only need the Advanced SIMD (NEON) instructions, not
+# the Cryptographic Extensions. These are mandatory on AArch64, they are
+# optional on ARMv7-A so the ARM32 build has to opt in, for instance on
+# Cortex-A7 or Cortex-A9 platforms implementing NEON. Either way the core
+# must be able to use the VFP/SIMD registers.
+ifeq ($(CFG_ARM64_core),y)
+CFG_CRYPTO_CHACHA20_POLY1305_ARM_NEON ?= $(call cfg-all-enabled,CFG_CRYPTO_CHACHA20_POLY1305 CFG_WITH_VFP)
+else
+CFG_CRYPTO_CHACHA20_POLY1305_ARM_NEON ?= n
+endif
+CFG_CORE_CRYPTO_CHACHA20_POLY1305_ACCEL ?= $(CFG_CRYPTO_CHACHA20_POLY1305_ARM_NEON)
+
+# Montgomery multiplication for the bignum library used by RSA, DH and DSA,
+# in AArch64 or ARMv7 assembly. Only the base instruction set is needed
+# (UMULH on AArch64, UMAAL on ARMv7), no VFP context is touched.
+CFG_CRYPTO_MPI_ARM_ASM ?= y
+CFG_CORE_CRYPTO_MPI_ACCEL ?= $(CFG_CRYPTO_MPI_ARM_ASM)
+
 
 # Cryptographic extensions can only be used safely when OP-TEE knows how to
 # preserve the VFP context
@@ -103,6 +165,15 @@ endif
 ifeq ($(CFG_CRYPTO_AES_ARM_CE),y)
 $(call force,CFG_WITH_VFP,y,required by CFG_CRYPTO_AES_ARM_CE)
 endif
+ifeq ($(CFG_CRYPTO_SHA512_ARM_CE),y)
+$(call force,CFG_WITH_VFP,y,required by CFG_CRYPTO_SHA512_ARM_CE)
+endif
+ifeq ($(CFG_CRYPTO_SM3_ARM_CE),y)
+$(call force,CFG_WITH_VFP,y,required by CFG_CRYPTO_SM3_ARM_CE)
+endif
+ifeq ($(CFG_CRYPTO_SM4_ARM_CE),y)
+$(call force,CFG_WITH_VFP,y,required by CFG_CRYPTO_SM4_ARM_CE)
+endif
 
 cryp-enable-all-depends = $(call cfg-enable-all-depends,$(strip $(1)),$(foreach v,$(2),CFG_CRYPTO_$(v)))
 $(eval $(call cryp-enable-all-depends,CFG_REE_FS, AES ECB CTR HMAC SHA256 GCM))
@@ -133,6 +204,12 @@ $(eval $(call cryp-dep-one, DES, ECB CBC))
 $(eval $(call cryp-dep-one, SM2_PKE, ECC))
 $(eval $(call cryp-dep-one, SM2_DSA, ECC))
 $(eval $(call cryp-dep-one, SM2_KEP, ECC))
+$(eval $(call cryp-dep-one, ECC_COMB, ECC))
+$(eval $(call cryp-dep-one, ECC_P256_CT, ECC))
+# Ed25519 hashes the key and message with SHA-512
+$(eval $(call cryp-dep-one, ED25519, SHA512))
+# The NEON kernels use the VFP/SIMD registers, possibly explicitly enabled
+$(eval $(call cfg-depends-all,CFG_CRYPTO_CHACHA20_POLY1305_ARM_NEON,CFG_CRYPTO_CHACHA20_POLY1305 CFG_WITH_VFP))
 
 ###############################################################
 # libtomcrypt (LTC) specifics, phase #1
@@ -154,21 +231,24 @@ core-ltc-vars = AES DES
 core-ltc-vars += ECB CBC CTR CTS XTS
 core-ltc-vars += MD5 SHA1 SHA224 SHA256 SHA384 SHA512 SHA512_256
 core-ltc-vars += HMAC CMAC CBC_MAC
-core-ltc-vars += CCM
+core-ltc-vars += CCM CHACHA20_POLY1305
 ifeq ($(CFG_CRYPTO_AES_GCM_FROM_CRYPTOLIB),y)
 core-ltc-vars += GCM
 endif
-core-ltc-vars += RSA DSA DH ECC
+core-ltc-vars += RSA DSA DH ECC ECC_COMB
 core-ltc-vars += SIZE_OPTIMIZATION
 core-ltc-vars += SM2_PKE
 core-ltc-vars += SM2_DSA
 core-ltc-vars += SM2_KEP
+core-ltc-vars += X25519 ED25519
 # Assigned selected CFG_CRYPTO_xxx as _CFG_CORE_LTC_xxx
 $(foreach v, $(core-ltc-vars), $(eval _CFG_CORE_LTC_$(v) := $(CFG_CRYPTO_$(v))))
 _CFG_CORE_LTC_MPI := $(CFG_CORE_MBEDTLS_MPI)
 _CFG_CORE_LTC_AES_ACCEL := $(CFG_CORE_CRYPTO_AES_ACCEL)
 _CFG_CORE_LTC_SHA1_ACCEL := $(CFG_CORE_CRYPTO_SHA1_ACCEL)
 _CFG_CORE_LTC_SHA256_ACCEL := $(CFG_CORE_CRYPTO_SHA256_ACCEL)
+_CFG_CORE_LTC_SHA512_ACCEL := $(CFG_CORE_CRYPTO_SHA512_ACCEL)
+_CFG_CORE_LTC_ECC_P256 := $(CFG_CRYPTO_ECC_P256_CT)
 endif
 
 ###############################################################
@@ -182,9 +262,12 @@ _CFG_CORE_LTC_DSA := $(CFG_CRYPTO_DSA)
 _CFG_CORE_LTC_MPI := $(CFG_CRYPTO_DSA)
 _CFG_CORE_LTC_SHA256_DESC := $(CFG_CRYPTO_DSA)
 _CFG_CORE_LTC_SHA384_DESC := $(CFG_CRYPTO_DSA)
-_CFG_CORE_LTC_SHA512_DESC := $(CFG_CRYPTO_DSA)
+_CFG_CORE_LTC_SHA512_DESC := $(call cfg-one-enabled, CFG_CRYPTO_DSA CFG_CRYPTO_ED25519)
+_CFG_CORE_LTC_X25519 := $(CFG_CRYPTO_X25519)
+_CFG_CORE_LTC_ED25519 := $(CFG_CRYPTO_ED25519)
 _CFG_CORE_LTC_XTS := $(CFG_CRYPTO_XTS)
 _CFG_CORE_LTC_CCM := $(CFG_CRYPTO_CCM)
+_CFG_CORE_LTC_CHACHA20_POLY1305 := $(CFG_CRYPTO_CHACHA20_POLY1305)
 _CFG_CORE_LTC_AES_DESC := $(call cfg-one-enabled, CFG_CRYPTO_XTS CFG_CRYPTO_CCM)
 endif
 
@@ -198,6 +281,7 @@ _CFG_CORE_LTC_SHA256_DESC := $(call cfg-one-enabled, _CFG_CORE_LTC_SHA256_DESC \
 _CFG_CORE_LTC_SHA384_DESC := $(call cfg-one-enabled, _CFG_CORE_LTC_SHA384_DESC \
 						     _CFG_CORE_LTC_SHA384)
 _CFG_CORE_LTC_SHA512_DESC := $(call cfg-one-enabled, _CFG_CORE_LTC_SHA512_DESC \
+						     _CFG_CORE_LTC_SHA384_DESC \
 						     _CFG_CORE_LTC_SHA512_256 \
 						     _CFG_CORE_LTC_SHA512)
 _CFG_CORE_LTC_AES_DESC := $(call cfg-one-enabled, _CFG_CORE_LTC_AES_DESC \
@@ -214,16 +298,21 @@ else
 _CFG_CORE_LTC_OPTEE_THREAD := n
 endif
 _CFG_CORE_LTC_HWSUPP_PMULL := $(CFG_HWSUPP_PMULL)
+_CFG_CORE_LTC_CHACHA20_POLY1305_ACCEL := $(CFG_CORE_CRYPTO_CHACHA20_POLY1305_ACCEL)
 
 # Assign aggregated variables
 ltc-one-enabled = $(call cfg-one-enabled,$(foreach v,$(1),_CFG_CORE_LTC_$(v)))
 _CFG_CORE_LTC_ACIPHER := $(call ltc-one-enabled, RSA DSA DH ECC)
-_CFG_CORE_LTC_AUTHENC := $(and $(filter y,$(_CFG_CORE_LTC_AES_DESC)), \
-			       $(filter y,$(call ltc-one-enabled, CCM GCM)))
+_CFG_CORE_LTC_CURVE25519 := $(call ltc-one-enabled, X25519 ED25519)
+_CFG_CORE_LTC_PK := $(call ltc-one-enabled, ACIPHER CURVE25519)
+_CFG_CORE_LTC_AUTHENC := $(or $(and $(filter y,$(_CFG_CORE_LTC_AES_DESC)), \
+				   $(filter y,$(call ltc-one-enabled, CCM GCM))), \
+			      $(filter y,$(_CFG_CORE_LTC_CHACHA20_POLY1305)))
 _CFG_CORE_LTC_CIPHER := $(call ltc-one-enabled, AES_DESC DES)
 _CFG_CORE_LTC_HASH := $(call ltc-one-enabled, MD5 SHA1 SHA224 SHA256 SHA384 \
 					      SHA512)
-_CFG_CORE_LTC_MAC := $(call ltc-one-enabled, HMAC CMAC CBC_MAC)
+_CFG_CORE_LTC_MAC := $(call ltc-one-enabled, HMAC CMAC CBC_MAC \
+					     CHACHA20_POLY1305)
 _CFG_CORE_LTC_CBC := $(call ltc-one-enabled, CBC CBC_MAC)
 _CFG_CORE_LTC_ASN1 := $(call ltc-one-enabled, RSA DSA ECC)
 
@@ -5,15 +5,22 @@
  * This is an implementation of the Fortuna cryptographic PRNG as defined in
  * https://www.schneier.com/academic/paperfiles/fortuna.pdf
  * There's one small exception, see comment in restart_pool() below.
+ *
+ * Random data is not produced directly by the Fortuna generator, instead
+ * there's one generator per CPU keyed from the output of the Fortuna
+ * generator, see struct fortuna_gen below.
  */
 
 #include <assert.h>
 #include <crypto/crypto.h>
+#include <kernel/misc.h>
 #include <kernel/mutex.h>
 #include <kernel/refcount.h>
 #include <kernel/spinlock.h>
 #include <kernel/tee_time.h>
+#include <kernel/thread.h>
 #include <string.h>
+#include <string_ext.h>
 #include <types_ext.h>
 #include <utee_defines.h>
 #include <util.h>
@@ -22,6 +29,7 @@
 #define BLOCK_SIZE		16
 #define KEY_SIZE		32
 #define CIPHER_ALGO		TEE_ALG_AES_ECB_NOPAD
+#define GEN_CIPHER_ALGO		TEE_ALG_AES_CTR
 #define HASH_ALGO		TEE_ALG_SHA256
 #define MIN_POOL_SIZE		64
 #define MAX_EVENT_DATA_LEN	32U
@@ -38,6 +46,8 @@
  *			which pools should be used in the reseed process
  * @next_reseed_time:	If we have a secure time, the earliest next time we
  *			may reseed
+ * @next_reseed_ms:	@next_reseed_time in milliseconds, truncated to 32
+ *			bits, read without holding state_mu
  *
  * To minimize the delay in crypto_rng_add_event() there's @pool_spin_lock
  * which protects everything needed by this function.
@@ -53,11 +63,38 @@ static struct fortuna_state {
 	uint32_t reseed_count;
 #ifndef CFG_SECURE_TIME_SOURCE_REE
 	TEE_Time next_reseed_time;
+	unsigned int next_reseed_ms;
 #endif
 } state;
 
 static struct mutex state_mu = MUTEX_INITIALIZER;
 
+/*
+ * struct fortuna_gen - per CPU generator
+ * @mu:			Serializes users of this generator
+ * @ctx:		AES-CTR cipher context producing the random numbers
+ * @reseed_count:	Value of state.reseed_count when last keyed
+ * @keyed:		True if @ctx has been keyed
+ *
+ * Each generator is keyed with output from the Fortuna generator and is
+ * keyed again each time the Fortuna generator has been reseeded, so the
+ * output of all generators depends on the latest seed as required by
+ * Fortuna. As with the Fortuna generator a new key is generated after
+ * each request.
+ *
+ * A generator is selected based on the current CPU, but since the
+ * thread may be rescheduled on another CPU at any time @mu is still
+ * needed. It's normally uncontended so random data can be produced in
+ * parallel on all CPUs, @state_mu is only taken when a generator needs
+ * a new key from the Fortuna generator or the pools need to be updated.
+ */
+static struct fortuna_gen {
+	struct mutex mu;
+	void *ctx;
+	uint32_t reseed_count;
+	bool keyed;
+} gens[CFG_TEE_CORE_NB_CORE];
+
 static struct {
 	struct {
 		uint8_t snum;
@@ -127,11 +164,36 @@ static void fortuna_done(void)
 	state.ctx = NULL;
 }
 
+static TEE_Result gens_init(void)
+{
+	TEE_Result res = TEE_SUCCESS;
+	size_t n = 0;
+
+	for (n = 0; n < ARRAY_SIZE(gens); n++) {
+		mutex_init(&gens[n].mu);
+		res = crypto_cipher_alloc_ctx(&gens[n].ctx, GEN_CIPHER_ALGO);
+		if (res)
+			return res;
+	}
+
+	return TEE_SUCCESS;
+}
+
+static void gens_done(void)
+{
+	size_t n = 0;
+
+	for (n = 0; n < ARRAY_SIZE(gens); n++) {
+		crypto_cipher_free_ctx(gens[n].ctx);
+		gens[n].ctx = NULL;
+	}
+}
+
 TEE_Result crypto_rng_init(const void *data, size_t dlen)
 {
 	TEE_Result res;
 	uint8_t key[KEY_SIZE];
-	void *ctx;
+	void *ctx = NULL;
 	size_t n;
 
 	COMPILE_TIME_ASSERT(sizeof(state.counter) == BLOCK_SIZE);
@@ -154,20 +216,26 @@ TEE_Result crypto_rng_init(const void *data, size_t dlen)
 	if (res)
 		goto err;
 
+	res = gens_init();
+	if (res)
+		goto err;
+
 	res = key_from_data(state.reseed_ctx, data, dlen, key);
 	if (res)
-		return res;
+		goto err;
 
 	res = crypto_cipher_alloc_ctx(&ctx, CIPHER_ALGO);
 	if (res)
-		return res;
+		goto err;
 	res = cipher_init(ctx, key);
 	if (res)
-		return res;
+		goto err;
 	inc_counter(state.counter);
 	state.ctx = ctx;
 	return TEE_SUCCESS;
 err:
+	crypto_cipher_free_ctx(ctx);
+	gens_done();
 	fortuna_done();
 	return res;
 }
@@ -368,7 +436,33 @@ static bool reseed_rate_limiting(void)
 	 */
 	return false;
 }
+
+static bool reseed_may_be_due(void)
+{
+	return true;
+}
 #else
+static unsigned int time_to_ms(const TEE_Time *time)
+{
+	return time->seconds * 1000 + time->millis;
+}
+
+/*
+ * Called without holding state_mu, tells if reseed_rate_limiting() may
+ * allow a reseed.
+ */
+static bool reseed_may_be_due(void)
+{
+	unsigned int next = atomic_load_uint(&state.next_reseed_ms);
+	TEE_Time time = { };
+
+	if (tee_time_get_sys_time(&time))
+		return true;
+
+	/* Wrapping difference, the interval is only 100 ms */
+	return (int)(time_to_ms(&time) - next) >= 0;
+}
+
 static bool reseed_rate_limiting(void)
 {
 	TEE_Result res;
@@ -388,6 +482,8 @@ static bool reseed_rate_limiting(void)
 
 	/* Time to reseed, calculate next time reseed is OK */
 	TEE_TIME_ADD(time, time_100ms, state.next_reseed_time);
+	atomic_store_uint(&state.next_reseed_ms,
+			  time_to_ms(&state.next_reseed_time));
 	return false;
 }
 #endif
@@ -473,40 +569,142 @@ static TEE_Result maybe_reseed(void)
 	return TEE_SUCCESS;
 }
 
-static TEE_Result fortuna_read(void *buf, size_t blen)
+static TEE_Result gen_set_key(struct fortuna_gen *gen, uint8_t key[KEY_SIZE])
 {
-	TEE_Result res;
+	static const uint8_t iv[BLOCK_SIZE];
+	TEE_Result res = TEE_SUCCESS;
 
-	if (!state.ctx)
-		return TEE_ERROR_BAD_STATE;
+	/* A fresh key is used each time so the counter can start from 0 */
+	if (gen->keyed)
+		crypto_cipher_final(gen->ctx);
+	res = crypto_cipher_init(gen->ctx, TEE_MODE_ENCRYPT, key, KEY_SIZE,
+				 NULL, 0, iv, sizeof(iv));
+	gen->keyed = !res;
+	memzero_explicit(key, KEY_SIZE);
+
+	return res;
+}
+
+/* Called with state_mu held */
+static TEE_Result gen_key_from_fortuna(struct fortuna_gen *gen)
+{
+	uint8_t new_key[KEY_SIZE];
+	uint8_t gen_key[KEY_SIZE];
+	TEE_Result res = TEE_SUCCESS;
+
+	res = generate_random_data(gen_key, sizeof(gen_key));
+	if (res)
+		return res;
+
+	res = generate_blocks(new_key, KEY_SIZE / BLOCK_SIZE);
+	if (res)
+		return res;
+	crypto_cipher_final(state.ctx);
+	res = cipher_init(state.ctx, new_key);
+	memzero_explicit(new_key, sizeof(new_key));
+	if (res)
+		return res;
+
+	gen->reseed_count = state.reseed_count;
+	return gen_set_key(gen, gen_key);
+}
+
+static bool gen_needs_fortuna(struct fortuna_gen *gen)
+{
+	/*
+	 * These reads are done without holding state_mu, they only tell
+	 * if it's worth taking state_mu. Any of the conditions are
+	 * checked again with state_mu held. A full pool0 only counts once
+	 * the reseed rate limit allows a reseed, else every request would
+	 * take state_mu until then.
+	 */
+	return !gen->keyed ||
+	       gen->reseed_count != atomic_load_uint(&state.reseed_count) ||
+	       (atomic_load_uint(&state.pool0_length) >= MIN_POOL_SIZE &&
+		reseed_may_be_due()) ||
+	       atomic_load_uint(&ring_buffer.begin) !=
+	       atomic_load_uint(&ring_buffer.end);
+}
+
+static TEE_Result update_gen(struct fortuna_gen *gen)
+{
+	TEE_Result res = TEE_SUCCESS;
 
 	mutex_lock(&state_mu);
 
+	if (!state.ctx) {
+		res = TEE_ERROR_BAD_STATE;
+		goto out;
+	}
+
 	res = maybe_reseed();
 	if (res)
 		goto out;
 
-	if (blen) {
-		uint8_t new_key[KEY_SIZE];
+	if (!gen->keyed || gen->reseed_count != state.reseed_count) {
+		res = gen_key_from_fortuna(gen);
+		if (res)
+			goto out;
+	}
 
-		res = generate_random_data(buf, blen);
+	res = drain_ring_buffer();
+out:
+	if (res && state.ctx)
+		fortuna_done();
+	mutex_unlock(&state_mu);
+
+	return res;
+}
+
+static struct fortuna_gen *get_gen(void)
+{
+	uint32_t exceptions = thread_mask_exceptions(THREAD_EXCP_FOREIGN_INTR);
+	size_t pos = get_core_pos();
+
+	thread_unmask_exceptions(exceptions);
+
+	return gens + pos;
+}
+
+static TEE_Result fortuna_read(void *buf, size_t blen)
+{
+	struct fortuna_gen *gen = NULL;
+	TEE_Result res = TEE_SUCCESS;
+
+	if (!state.ctx)
+		return TEE_ERROR_BAD_STATE;
+
+	gen = get_gen();
+	mutex_lock(&gen->mu);
+
+	if (gen_needs_fortuna(gen)) {
+		res = update_gen(gen);
 		if (res)
 			goto out;
+	}
 
-		res = generate_blocks(new_key, KEY_SIZE / BLOCK_SIZE);
+	if (blen) {
+		uint8_t new_key[KEY_SIZE] = { };
+
+		/* The key stream of AES-CTR is the encrypted counter */
+		memset(buf, 0, blen);
+		res = crypto_cipher_update(gen->ctx, TEE_MODE_ENCRYPT, false,
+					   buf, blen, buf);
 		if (res)
 			goto out;
-		crypto_cipher_final(state.ctx);
-		res = cipher_init(state.ctx, new_key);
+
+		res = crypto_cipher_update(gen->ctx, TEE_MODE_ENCRYPT, false,
+					   new_key, sizeof(new_key), new_key);
 		if (res)
 			goto out;
+		res = gen_set_key(gen, new_key);
 	}
-
-	res = drain_ring_buffer();
 out:
-	if (res)
-		fortuna_done();
-	mutex_unlock(&state_mu);
+	if (res && gen->keyed) {
+		crypto_cipher_final(gen->ctx);
+		gen->keyed = false;
+	}
+	mutex_unlock(&gen->mu);
 
 	return res;
 }
@@ -14,7 +14,9 @@
 
 #include "sm4.h"
 #include <assert.h>
+#include <crypto/crypto_accel.h>
 #include <string.h>
+#include <tee_api_types.h>
 
 #define GET_UINT32_BE(n, b, i)				\
 	do {						\
@@ -163,24 +165,28 @@ static void sm4_setkey(uint32_t SK[32], const uint8_t key[16])
 static void sm4_one_round(uint32_t sk[32], const uint8_t input[16],
 			  uint8_t output[16])
 {
+	uint32_t x0 = 0;
+	uint32_t x1 = 0;
+	uint32_t x2 = 0;
+	uint32_t x3 = 0;
 	uint32_t i = 0;
-	uint32_t ulbuf[36];
 
-	memset(ulbuf, 0, sizeof(ulbuf));
+	GET_UINT32_BE(x0, input, 0);
+	GET_UINT32_BE(x1, input, 4);
+	GET_UINT32_BE(x2, input, 8);
+	GET_UINT32_BE(x3, input, 12);
 
-	GET_UINT32_BE(ulbuf[0], input, 0);
-	GET_UINT32_BE(ulbuf[1], input, 4);
-	GET_UINT32_BE(ulbuf[2], input, 8);
-	GET_UINT32_BE(ulbuf[3], input, 12);
-
-	for (i = 0; i < 32; i++)
-		ulbuf[i + 4] = sm4F(ulbuf[i], ulbuf[i + 1], ulbuf[i + 2],
-				    ulbuf[i + 3], sk[i]);
+	for (i = 0; i < 32; i += 4) {
+		x0 = sm4F(x0, x1, x2, x3, sk[i]);
+		x1 = sm4F(x1, x2, x3, x0, sk[i + 1]);
+		x2 = sm4F(x2, x3, x0, x1, sk[i + 2]);
+		x3 = sm4F(x3, x0, x1, x2, sk[i + 3]);
+	}
 
-	PUT_UINT32_BE(ulbuf[35], output, 0);
-	PUT_UINT32_BE(ulbuf[34], output, 4);
-	PUT_UINT32_BE(ulbuf[33], output, 8);
-	PUT_UINT32_BE(ulbuf[32], output, 12);
+	PUT_UINT32_BE(x3, output, 0);
+	PUT_UINT32_BE(x2, output, 4);
+	PUT_UINT32_BE(x1, output, 8);
+	PUT_UINT32_BE(x0, output, 12);
 }
 
 void sm4_setkey_enc(struct sm4_context *ctx, const uint8_t key[16])
@@ -205,6 +211,12 @@ void sm4_crypt_ecb(struct sm4_context *ctx, size_t length, const uint8_t *input,
 {
 	assert(!(length % 16));
 
+#ifdef CFG_CORE_CRYPTO_SM4_ACCEL
+	if (crypto_accel_sm4_ecb(output, input, ctx->sk,
+				 length / 16) == TEE_SUCCESS)
+		return;
+#endif
+
 	while (length > 0) {
 		sm4_one_round(ctx->sk, input, output);
 		input  += 16;
@@ -221,6 +233,18 @@ void sm4_crypt_cbc(struct sm4_context *ctx, size_t length, uint8_t iv[16],
 
 	assert(!(length % 16));
 
+#ifdef CFG_CORE_CRYPTO_SM4_ACCEL
+	if (ctx->mode == SM4_ENCRYPT) {
+		if (crypto_accel_sm4_cbc_enc(output, input, ctx->sk,
+					     length / 16, iv) == TEE_SUCCESS)
+			return;
+	} else {
+		if (crypto_accel_sm4_cbc_dec(output, input, ctx->sk,
+					     length / 16, iv) == TEE_SUCCESS)
+			return;
+	}
+#endif
+
 	if (ctx->mode == SM4_ENCRYPT) {
 		while (length > 0) {
 			for (i = 0; i < 16; i++)
@@ -254,6 +278,12 @@ void sm4_crypt_ctr(struct sm4_context *ctx, size_t length, uint8_t ctr[16],
 
 	assert(!(length % 16));
 
+#ifdef CFG_CORE_CRYPTO_SM4_ACCEL
+	if (crypto_accel_sm4_ctr_be_enc(output, input, ctx->sk,
+					length / 16, ctr) == TEE_SUCCESS)
+		return;
+#endif
+
 	while (length > 0) {
 		memcpy(temp, ctr, 16);
 		sm4_one_round(ctx->sk, ctr, ctr);
@@ -8,6 +8,7 @@
 #include <initcall.h>
 #include <io.h>
 #include <kernel/boot.h>
+#include <kernel/deferred_init.h>
 #include <kernel/delay.h>
 #include <kernel/dt.h>
 #include <kernel/panic.h>
@@ -166,13 +167,16 @@ static TEE_Result map_controller(void)
 }
 #endif
 
+DECLARE_DEFERRED_INIT(rngb_init);
+
 TEE_Result crypto_rng_read(void *buf, size_t len)
 {
 	uint32_t *rngbuf = buf;
 	uint32_t status = 0;
 	uint32_t val = 0;
 
-	if (!rngb.ready)
+	/* Waits for or runs the self test and seeding if not done yet */
+	if (deferred_init_wait(DEFERRED_INIT(rngb_init)) || !rngb.ready)
 		return TEE_ERROR_BAD_STATE;
 
 	assert(buf);
@@ -229,4 +233,8 @@ static TEE_Result rngb_init(void)
 	return TEE_SUCCESS;
 }
 
-driver_init(rngb_init);
+/*
+ * The self test and the initial seeding can take up to SEED_TIMEOUT, with
+ * CFG_DEFERRED_DRIVER_INIT=y that's done while normal world boots.
+ */
+driver_init_deferred(rngb_init);
@@ -167,6 +167,21 @@ struct ecc_keypair {
 	const struct crypto_ecc_keypair_ops *ops; /* Key Operations */
 };
 
+/* Curve25519 keys are fixed size byte strings, see RFC 7748 and RFC 8032 */
+struct x25519_keypair {
+	uint8_t priv[32];	/* Private value, the scalar k */
+	uint8_t pub[32];	/* Public value, the u-coordinate */
+};
+
+struct ed25519_keypair {
+	uint8_t priv[32];	/* Private value, the seed hashed into s */
+	uint8_t pub[32];	/* Public value, the encoded point A */
+};
+
+struct ed25519_public_key {
+	uint8_t pub[32];	/* Public value, the encoded point A */
+};
+
 /*
  * Key allocation functions
  * Allocate the bignum's inside a key structure.
@@ -200,6 +215,10 @@ TEE_Result crypto_acipher_gen_dsa_key(struct dsa_keypair *key, size_t key_size);
 TEE_Result crypto_acipher_gen_dh_key(struct dh_keypair *key, struct bignum *q,
 				     size_t xbits, size_t key_size);
 TEE_Result crypto_acipher_gen_ecc_key(struct ecc_keypair *key, size_t key_size);
+TEE_Result crypto_acipher_gen_x25519_key(struct x25519_keypair *key,
+					 size_t key_size);
+TEE_Result crypto_acipher_gen_ed25519_key(struct ed25519_keypair *key,
+					  size_t key_size);
 
 TEE_Result crypto_acipher_dh_shared_secret(struct dh_keypair *private_key,
 					   struct bignum *public_key,
@@ -252,6 +271,20 @@ TEE_Result crypto_acipher_sm2_pke_decrypt(struct ecc_keypair *key,
 TEE_Result crypto_acipher_sm2_pke_encrypt(struct ecc_public_key *key,
 					  const uint8_t *src, size_t src_len,
 					  uint8_t *dst, size_t *dst_len);
+/*
+ * X25519 and pure Ed25519, @public_key points to a 32-byte public value.
+ * Ed25519 signs and verifies the message itself, not a digest of it.
+ */
+TEE_Result crypto_acipher_x25519_shared_secret(struct x25519_keypair *priv_key,
+					       const uint8_t *public_key,
+					       uint8_t *secret,
+					       size_t *secret_len);
+TEE_Result crypto_acipher_ed25519_sign(struct ed25519_keypair *key,
+				       const uint8_t *msg, size_t msg_len,
+				       uint8_t *sig, size_t *sig_len);
+TEE_Result crypto_acipher_ed25519_verify(const uint8_t *public_key,
+					 const uint8_t *msg, size_t msg_len,
+					 const uint8_t *sig, size_t sig_len);
 
 struct sm2_kep_parms {
 	uint8_t *out;
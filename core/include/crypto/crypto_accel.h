@@ -44,4 +44,49 @@ void crypto_accel_sha1_compress(uint32_t state[5], const void *src,
 				unsigned int block_count);
 void crypto_accel_sha256_compress(uint32_t state[8], const void *src,
 				  unsigned int block_count);
+
+/*
+ * The SHA-512, SM3 and SM4 functions return TEE_ERROR_NOT_SUPPORTED when
+ * the CPU lacks the instructions, the caller is then expected to fall back
+ * to a generic implementation. @rk is the SM4 key schedule in the order it
+ * is to be applied, that is reversed for decryption.
+ */
+TEE_Result crypto_accel_sha512_compress(uint64_t state[8], const void *src,
+					unsigned int block_count);
+TEE_Result crypto_accel_sm3_compress(uint32_t state[8], const void *src,
+				     unsigned int block_count);
+
+TEE_Result crypto_accel_sm4_ecb(void *out, const void *in,
+				const uint32_t rk[32],
+				unsigned int block_count);
+TEE_Result crypto_accel_sm4_cbc_enc(void *out, const void *in,
+				    const uint32_t rk[32],
+				    unsigned int block_count, void *iv);
+TEE_Result crypto_accel_sm4_cbc_dec(void *out, const void *in,
+				    const uint32_t rk[32],
+				    unsigned int block_count, void *iv);
+TEE_Result crypto_accel_sm4_ctr_be_enc(void *out, const void *in,
+				       const uint32_t rk[32],
+				       unsigned int block_count, void *iv);
+
+/*
+ * @state is the ChaCha20 input block, the block counter in state[12] is
+ * advanced by @block_count and is not carried into state[13]. @h and @r
+ * are the Poly1305 accumulator and key in five 26-bit limbs, @block_count
+ * must be a non-zero multiple of 2.
+ */
+void crypto_accel_chacha20_xor(void *out, const void *in, uint32_t state[16],
+			       unsigned int block_count);
+void crypto_accel_poly1305_blocks(uint32_t h[5], const uint32_t r[5],
+				  const void *src, unsigned int block_count);
+
+/*
+ * Montgomery multiplication of @len native word limbs, least significant
+ * limb first: @d receives (@a * @b + u * @n) / 2^(@len * word size) in
+ * @len + 1 limbs. The result is below 2 * @n, the final subtraction is
+ * left to the caller. @mm is -@n^-1 modulo 2^(word size) and @len must
+ * be at least 2.
+ */
+void crypto_accel_mpi_montmul(void *d, const void *a, const void *b,
+			      const void *n, unsigned long mm, size_t len);
 #endif /*__CRYPTO_CRYPTO_ACCEL_H*/
@@ -10,15 +10,27 @@
 #include <tee_api_types.h>
 #include <trace.h>
 
+#if TRACE_LEVEL >= TRACE_DEBUG || defined(CFG_BOOT_PROFILE)
+#define __INITCALL_HAS_NAME	1
+#endif
+
 struct initcall {
 	TEE_Result (*func)(void);
-#if TRACE_LEVEL >= TRACE_DEBUG
+#ifdef __INITCALL_HAS_NAME
 	int level;
 	const char *func_name;
 #endif
 };
 
-#if TRACE_LEVEL >= TRACE_DEBUG
+#ifdef __INITCALL_HAS_NAME
+#define INITCALL_LEVEL(call)	((call)->level)
+#define INITCALL_NAME(call)	((call)->func_name)
+#else
+#define INITCALL_LEVEL(call)	0
+#define INITCALL_NAME(call)	NULL
+#endif
+
+#ifdef __INITCALL_HAS_NAME
 #define __define_initcall(type, lvl, fn) \
 	SCATTERED_ARRAY_DEFINE_PG_ITEM_ORDERED(type ## call, lvl, \
 					       struct initcall) = \
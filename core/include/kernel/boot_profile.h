@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: BSD-2-Clause */
+/*
+ * Copyright (c) 2026, agent
+ */
+#ifndef __KERNEL_BOOT_PROFILE_H
+#define __KERNEL_BOOT_PROFILE_H
+
+#include <compiler.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <tee_api_types.h>
+
+enum boot_profile_type {
+	BOOT_PROFILE_PREINITCALL,
+	BOOT_PROFILE_INITCALL,
+	BOOT_PROFILE_FINALCALL,
+	BOOT_PROFILE_DT_PROBE,
+};
+
+#define BOOT_PROFILE_NAME_LEN	32
+
+/*
+ * struct boot_profile_record - Timed call as reported to normal world
+ * @name: Initcall function name or DT driver name
+ * @node: FDT node name for DT probes, empty otherwise
+ * @type: One of BOOT_PROFILE_*
+ * @level: Initcall level, or probe attempt for DT probes where values
+ *	   above 1 are re-probes of deferred drivers
+ * @res: Value returned by the call
+ * @start_us: Time since the counter started when the call was made
+ * @duration_us: Duration of the call
+ *
+ * Durations of initcalls include the DT probes they run.
+ */
+struct boot_profile_record {
+	char name[BOOT_PROFILE_NAME_LEN];
+	char node[BOOT_PROFILE_NAME_LEN];
+	uint32_t type;
+	uint32_t level;
+	uint32_t res;
+	uint32_t pad;
+	uint64_t start_us;
+	uint64_t duration_us;
+};
+
+#ifdef CFG_BOOT_PROFILE
+/* Returns a timestamp to pass to boot_profile_add() */
+uint64_t boot_profile_start(void);
+
+/* Records a call started at @start, silently dropped if the table is full */
+void boot_profile_add(enum boot_profile_type type, unsigned int level,
+		      const char *name, const char *node, uint64_t start,
+		      TEE_Result res);
+
+/* Prints the recorded calls, called just before the first exit to NW */
+void boot_profile_print(void);
+
+/*
+ * boot_profile_get_records() - Copy recorded calls
+ * @first:	Index of the first record to copy
+ * @recs:	Output array
+ * @num_recs:	[in] number of elements in @recs, [out] number copied
+ * @total:	[out] total number of records
+ * @dropped:	[out] number of calls not recorded due to a full table
+ */
+void boot_profile_get_records(size_t first, struct boot_profile_record *recs,
+			      size_t *num_recs, size_t *total,
+			      size_t *dropped);
+#else
+static inline uint64_t boot_profile_start(void)
+{
+	return 0;
+}
+
+static inline void
+boot_profile_add(enum boot_profile_type type __unused,
+		 unsigned int level __unused, const char *name __unused,
+		 const char *node __unused, uint64_t start __unused,
+		 TEE_Result res __unused)
+{
+}
+
+static inline void boot_profile_print(void)
+{
+}
+
+static inline void
+boot_profile_get_records(size_t first __unused,
+			 struct boot_profile_record *recs __unused,
+			 size_t *num_recs, size_t *total, size_t *dropped)
+{
+	*num_recs = 0;
+	*total = 0;
+	*dropped = 0;
+}
+#endif
+
+#endif /*__KERNEL_BOOT_PROFILE_H*/
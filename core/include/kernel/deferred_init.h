@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: BSD-2-Clause */
+/*
+ * Copyright (c) 2026, agent
+ */
+#ifndef __KERNEL_DEFERRED_INIT_H
+#define __KERNEL_DEFERRED_INIT_H
+
+#include <compiler.h>
+#include <scattered_array.h>
+#include <sys/queue.h>
+#include <tee_api_types.h>
+
+/*
+ * Deferred driver initialization
+ *
+ * A driver with a slow initialization which isn't needed to boot normal
+ * world can register it with driver_init_deferred() instead of
+ * driver_init(), or at runtime with deferred_init_add(), for instance
+ * from a DT probe function which only registers the device.
+ *
+ * With CFG_DEFERRED_DRIVER_INIT=y deferred initializations are run in an
+ * asynchronous notification bottom half. It's requested with
+ * deferred_init_schedule() on the first yielding call from normal world
+ * once asynchronous notifications are started, so the call itself isn't
+ * delayed. With CFG_DEFERRED_DRIVER_INIT=n they are run at boot at the
+ * driver_init_late() level.
+ *
+ * A consumer of a device with a deferred initialization must call
+ * deferred_init_wait() before using the device. If the initialization
+ * is still pending it's run by the caller, if it's running in another
+ * thread the caller waits for it to complete. This way consumers only
+ * wait for the devices they actually need, and devices are still
+ * initialized on demand if normal world never starts asynchronous
+ * notifications. During boot, before normal world is started,
+ * deferred_init_wait() runs the initialization directly. After boot
+ * deferred_init_wait() must only be called from a thread.
+ */
+
+enum deferred_init_state {
+	DEFERRED_INIT_PENDING,
+	DEFERRED_INIT_RUNNING,
+	DEFERRED_INIT_DONE,
+};
+
+/*
+ * struct deferred_init - A deferred initialization
+ * @name:	Name used in traces
+ * @init:	Initialization function
+ * @state:	One of DEFERRED_INIT_*, private
+ * @res:	Result of @init once DEFERRED_INIT_DONE, private
+ * @thread_id:	Thread running @init if DEFERRED_INIT_RUNNING, private
+ * @link:	Link in the list of deferred_init_add() entries, private
+ */
+struct deferred_init {
+	const char *name;
+	TEE_Result (*init)(struct deferred_init *di);
+	enum deferred_init_state state;
+	TEE_Result res;
+	short int thread_id;
+	SLIST_ENTRY(deferred_init) link;
+};
+
+struct deferred_initcall {
+	struct deferred_init *di;
+};
+
+#define DEFERRED_INIT_INITIALIZER(_name, _init) \
+	{ .name = (_name), .init = (_init), .state = DEFERRED_INIT_PENDING, }
+
+/*
+ * Registers @fn, a TEE_Result (*)(void) function, as a deferred driver
+ * initialization. Consumers in other files can wait for it with
+ * deferred_init_wait(DEFERRED_INIT(fn)) after DECLARE_DEFERRED_INIT(fn).
+ */
+#define driver_init_deferred(fn) \
+	static TEE_Result __deferred_init_call_##fn(struct deferred_init *di \
+						    __unused) \
+	{ \
+		return fn(); \
+	} \
+	struct deferred_init __deferred_init_##fn = \
+		DEFERRED_INIT_INITIALIZER(#fn, __deferred_init_call_##fn); \
+	SCATTERED_ARRAY_DEFINE_PG_ITEM(deferred_initcall, \
+				       struct deferred_initcall) = \
+		{ .di = &__deferred_init_##fn, }
+
+#define DECLARE_DEFERRED_INIT(fn) \
+	extern struct deferred_init __deferred_init_##fn
+
+#define DEFERRED_INIT(fn)	(&__deferred_init_##fn)
+
+/*
+ * Adds a deferred initialization at runtime, @di must have been
+ * initialized with DEFERRED_INIT_INITIALIZER(). If added after deferred
+ * initializations have been run @di is run when first waited for.
+ */
+void deferred_init_add(struct deferred_init *di);
+
+/*
+ * Runs @di unless already done and returns the result of its
+ * initialization function.
+ */
+TEE_Result deferred_init_wait(struct deferred_init *di);
+
+/* Runs all pending deferred initializations, only the first call has effect */
+void deferred_init_run_all(void);
+
+/*
+ * Requests a bottom half to run all pending deferred initializations if
+ * asynchronous notifications are started, only the first such call has
+ * effect.
+ */
+#ifdef CFG_DEFERRED_DRIVER_INIT
+void deferred_init_schedule(void);
+#else
+static inline void deferred_init_schedule(void)
+{
+}
+#endif
+
+#endif /*__KERNEL_DEFERRED_INIT_H*/
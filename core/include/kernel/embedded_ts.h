@@ -12,11 +12,16 @@
 #include <tee_api_types.h>
 #include <util.h>
 
+/* Compression algorithm of struct embedded_ts::ts */
+#define EMB_TS_COMP_DEFLATE	0
+#define EMB_TS_COMP_LZ4		1
+
 struct embedded_ts {
 	uint32_t flags;
 	TEE_UUID uuid;
 	uint32_t size;
 	uint32_t uncompressed_size; /* 0: not compressed */
+	uint32_t compression; /* EMB_TS_COMP_* if compressed */
 	const uint8_t *ts; /* @size bytes */
 };
 
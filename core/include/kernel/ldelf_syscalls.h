@@ -37,6 +37,8 @@ TEE_Result ldelf_syscall_remap(unsigned long old_va, vaddr_t *new_va,
 			       size_t num_bytes, size_t pad_begin,
 			       size_t pad_end);
 TEE_Result ldelf_syscall_gen_rnd_num(void *buf, size_t num_bytes);
+TEE_Result ldelf_syscall_share_reloc(unsigned long va, size_t num_bytes,
+				     unsigned long ref_va);
 void ldelf_sess_cleanup(struct ts_session *sess);
 
 #endif /* KERNEL_LDELF_SYSCALLS_H */
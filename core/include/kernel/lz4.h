@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-2-Clause */
+/*
+ * Copyright (c) 2026, agent
+ */
+#ifndef __KERNEL_LZ4_H
+#define __KERNEL_LZ4_H
+
+#include <stddef.h>
+#include <tee_api_types.h>
+#include <util.h>
+
+/*
+ * Images compressed with scripts/lz4_pack.py are split into blocks of
+ * LZ4_PACK_BLOCK_SIZE bytes (the last one may be shorter) which are
+ * compressed independently of each other. Each block is preceded by a
+ * little endian 32-bit header holding the size of the block data. If
+ * LZ4_PACK_STORED is set in the header the block is stored uncompressed.
+ *
+ * This allows an image to be decompressed one block at a time without
+ * keeping a history window of previously decompressed data.
+ */
+#define LZ4_PACK_BLOCK_SIZE	(32 * 1024)
+#define LZ4_PACK_STORED		BIT32(31)
+#define LZ4_PACK_HDR_SIZE	4
+
+/*
+ * lz4_decompress_block() - Decompress a raw LZ4 block
+ * @src:	Compressed block
+ * @src_len:	Size of the compressed block
+ * @dst:	Output buffer
+ * @dst_len:	[in] size of @dst, [out] number of bytes decompressed
+ *
+ * Returns TEE_SUCCESS on success or TEE_ERROR_BAD_FORMAT if the block is
+ * malformed or doesn't fit in @dst.
+ */
+TEE_Result lz4_decompress_block(const void *src, size_t src_len, void *dst,
+				size_t *dst_len);
+
+/*
+ * lz4_pack_next_block() - Decompress the next block of a packed image
+ * @src:	Packed image
+ * @src_len:	Size of the packed image
+ * @src_offs:	[in/out] offset of the next block header in @src
+ * @dst:	Output buffer
+ * @dst_len:	Expected size of the decompressed block
+ */
+TEE_Result lz4_pack_next_block(const void *src, size_t src_len,
+			       size_t *src_offs, void *dst, size_t dst_len);
+
+/*
+ * lz4_unpack() - Decompress a complete packed image
+ * @src:	Packed image
+ * @src_len:	Size of the packed image
+ * @dst:	Output buffer
+ * @dst_len:	Size of the decompressed image
+ */
+TEE_Result lz4_unpack(const void *src, size_t src_len, void *dst,
+		      size_t dst_len);
+
+#endif /*__KERNEL_LZ4_H*/
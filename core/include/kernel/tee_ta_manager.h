@@ -34,10 +34,19 @@ struct param_val {
 	uint32_t b;
 };
 
+/*
+ * struct param_mem - memory reference parameter
+ * @mobj:	memory object backing the memory reference
+ * @size:	size of the memory reference
+ * @offs:	offset of the memory reference into @mobj
+ * @readonly:	true if the memory reference must be mapped read-only
+ *		into a user mode context
+ */
 struct param_mem {
 	struct mobj *mobj;
 	size_t size;
 	size_t offs;
+	bool readonly;
 };
 
 struct tee_ta_param {
@@ -6,6 +6,7 @@
 #ifndef __KERNEL_TS_STORE_H
 #define __KERNEL_TS_STORE_H
 
+#include <stdbool.h>
 #include <tee_api_types.h>
 
 struct ts_store_handle;
@@ -81,4 +82,21 @@ struct ts_store_ops {
 	int __tee_sp_store_##prio __unused; \
 	SCATTERED_ARRAY_DEFINE_PG_ITEM_ORDERED(sp_stores, prio, \
 					       struct ts_store_ops)
+/*
+ * ree_fs_ta_cache_shrink() - Evict all cached REE FS TA binaries
+ *
+ * Called when secure memory for a TA can't be allocated, the cached
+ * binaries are kept in the same pool.
+ *
+ * Returns true if any memory was freed.
+ */
+#ifdef CFG_REE_FS_TA_CACHE
+bool ree_fs_ta_cache_shrink(void);
+#else
+static inline bool ree_fs_ta_cache_shrink(void)
+{
+	return false;
+}
+#endif
+
 #endif /*__KERNEL_TS_STORE_H*/
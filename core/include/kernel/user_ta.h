@@ -7,6 +7,7 @@
 #define KERNEL_USER_TA_H
 
 #include <assert.h>
+#include <kernel/handle.h>
 #include <kernel/tee_ta_manager.h>
 #include <kernel/user_mode_ctx_struct.h>
 #include <kernel/thread.h>
@@ -26,6 +27,7 @@ SLIST_HEAD(load_seg_head, load_seg);
  * struct user_ta_ctx - user TA context
  * @open_sessions:	List of sessions opened by this TA
  * @cryp_states:	List of cryp states created by this TA
+ * @cryp_state_db:	Handles of the cryp states, used as state ids by the TA
  * @objects:		List of storage objects opened by this TA
  * @storage_enums:	List of storage enumerators opened by this TA
  * @ta_time_offs:	Time reference used by the TA
@@ -35,6 +37,7 @@ SLIST_HEAD(load_seg_head, load_seg);
 struct user_ta_ctx {
 	struct tee_ta_session_head open_sessions;
 	struct tee_cryp_state_head cryp_states;
+	struct handle_db cryp_state_db;
 	struct tee_obj_head objects;
 	struct tee_storage_enum_head storage_enums;
 	void *ta_time_offs;
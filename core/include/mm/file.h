@@ -105,5 +105,37 @@ void file_put(struct file *f);
  */
 struct file_slice *file_find_slice(struct file *f, unsigned int page_offset);
 
+/*
+ * file_add_reloc_slice() - Add a relocated snapshot of a writeable segment
+ * @f:		File pointer
+ * @fobj:	Fobj holding the segment as relocated by ldelf, must not be
+ *		modified after this call
+ * @va:		User space address the segment was relocated for
+ *
+ * File must be in locked state.
+ *
+ * Returns TEE_SUCCESS on success or a TEE_ERROR_* code on failure.
+ */
+TEE_Result file_add_reloc_slice(struct file *f, struct fobj *fobj,
+				vaddr_t va);
+
+/*
+ * file_find_reloc_slice() - Find a relocated snapshot of a segment
+ * @f:		File pointer
+ * @va:		User space address the segment was relocated for
+ * @num_pages:	Size of the segment in pages
+ *
+ * File must be in locked state.
+ *
+ * Returns the fobj holding the snapshot or NULL if not found. The
+ * returned fobj is only guaranteed to remain valid while the file is
+ * locked.
+ */
+struct fobj *file_find_reloc_slice(struct file *f, vaddr_t va,
+				   unsigned int num_pages);
+
+/* Returns the number of pages held by relocated snapshots of all files */
+size_t file_get_reloc_num_pages(void);
+
 #endif /*__MM_FILE_H*/
 
@@ -152,27 +152,97 @@ static inline vaddr_t fobj_get_iv_vaddr(struct fobj *fobj,
 }
 #endif
 
+#ifndef CFG_PAGED_USER_TA
+/*
+ * fobj_sec_mem_alloc() - Allocates storage directly in secure memory
+ * @num_pages:	Number of pages
+ *
+ * Returns a valid pointer on success or NULL on failure.
+ */
+struct fobj *fobj_sec_mem_alloc(unsigned int num_pages);
+#endif
+
 /*
  * fobj_ta_mem_alloc() - Allocates TA memory
  * @num_pages:	Number of pages
  *
  * If paging of user TAs read/write paged fobj is allocated otherwise a
- * fobj which uses unpaged secure memory directly.
+ * fobj which uses unpaged secure memory directly. If the allocation
+ * fails cached TA binaries are evicted and the allocation is tried again.
  *
  * Returns a valid pointer on success or NULL on failure.
  */
-#ifdef CFG_PAGED_USER_TA
-#define fobj_ta_mem_alloc(num_pages)	fobj_rw_paged_alloc(num_pages)
-#else
+struct fobj *fobj_ta_mem_alloc(unsigned int num_pages);
+
 /*
- * fobj_sec_mem_alloc() - Allocates storage directly in secure memory
- * @num_pages:	Number of pages
+ * struct fobj_cow_stats - copy-on-write statistics
+ * @shared_pages:	Number of pages currently resolved to a parent fobj
+ * @num_breaks:		Number of private page copies made so far
+ */
+struct fobj_cow_stats {
+	size_t shared_pages;
+	size_t num_breaks;
+};
+
+#ifdef CFG_TA_SHARE_RELOC_PAGES
+/*
+ * fobj_cow_alloc() - Allocates a copy-on-write fobj
+ * @parent:	Fobj holding the initial content, must not be modified
+ *		while referenced by a copy-on-write fobj
+ *
+ * All pages of the returned fobj initially resolve to the pages of
+ * @parent, fobj_cow_break() gives a page its own private copy.
  *
  * Returns a valid pointer on success or NULL on failure.
  */
-struct fobj *fobj_sec_mem_alloc(unsigned int num_pages);
+struct fobj *fobj_cow_alloc(struct fobj *parent);
+
+/*
+ * fobj_cow_break() - Gives a page of a copy-on-write fobj a private copy
+ * @fobj:	Copy-on-write fobj
+ * @page_idx:	Index of the page
+ *
+ * Does nothing if the page already is private. May be called concurrently
+ * for the same page, only one private copy is kept. Only takes spinlocks
+ * so it can be called from the abort handler, as long as the aborting
+ * context doesn't hold any spinlock itself.
+ *
+ * Returns TEE_SUCCESS on success or a TEE_ERROR_* code on failure.
+ */
+TEE_Result fobj_cow_break(struct fobj *fobj, unsigned int page_idx);
+
+/*
+ * fobj_cow_page_is_shared() - Tells if a page still resolves to the parent
+ * @fobj:	Fobj
+ * @page_idx:	Index of the page
+ *
+ * Returns false if @fobj isn't a copy-on-write fobj.
+ */
+bool fobj_cow_page_is_shared(struct fobj *fobj, unsigned int page_idx);
+
+void fobj_cow_get_stats(struct fobj_cow_stats *stats);
+#else
+static inline struct fobj *fobj_cow_alloc(struct fobj *parent __unused)
+{
+	return NULL;
+}
+
+static inline TEE_Result fobj_cow_break(struct fobj *fobj __unused,
+					unsigned int page_idx __unused)
+{
+	return TEE_ERROR_NOT_SUPPORTED;
+}
 
-#define fobj_ta_mem_alloc(num_pages)	fobj_sec_mem_alloc(num_pages)
+static inline bool fobj_cow_page_is_shared(struct fobj *fobj __unused,
+					   unsigned int page_idx __unused)
+{
+	return false;
+}
+
+static inline void fobj_cow_get_stats(struct fobj_cow_stats *stats)
+{
+	*stats = (struct fobj_cow_stats){ };
+}
 #endif
 
 /*
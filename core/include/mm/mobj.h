@@ -318,4 +318,13 @@ struct mobj *mobj_seccpy_shm_alloc(size_t size);
 
 struct mobj *mobj_with_fobj_alloc(struct fobj *fobj, struct file *file);
 
+/*
+ * mobj_with_fobj_get_file() - Get the file a mobj is mapping
+ * @mobj:	Mobj pointer
+ *
+ * Returns the file passed to mobj_with_fobj_alloc() with an increased
+ * reference counter, or NULL if @mobj isn't mapping a file.
+ */
+struct file *mobj_with_fobj_get_file(struct mobj *mobj);
+
 #endif /*__MM_MOBJ_H*/
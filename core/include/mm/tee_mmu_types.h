@@ -57,6 +57,11 @@
  * functions.
  */
 #define VM_FLAG_READONLY		BIT(4)
+/*
+ * The mapping is writeable but its pages are shared copy-on-write with
+ * other instances of the TA, pages still shared are mapped read-only.
+ */
+#define VM_FLAG_COW			BIT(5)
 
 /*
  * Set of flags used by tee_mmu_is_vbuf_inside_ta_private() and
@@ -57,6 +57,33 @@ TEE_Result vm_set_prot(struct user_mode_ctx *uctx, vaddr_t va, size_t len,
 
 TEE_Result vm_unmap(struct user_mode_ctx *uctx, vaddr_t va, size_t len);
 
+#ifdef CFG_TA_SHARE_RELOC_PAGES
+/*
+ * Returns true if the page at offset @offs into the mobj of @r is still
+ * shared copy-on-write and must be mapped read-only.
+ */
+bool vm_region_page_is_cow(struct vm_region *r, size_t offs);
+
+/*
+ * Gives the page at @va a private copy if it's shared copy-on-write and
+ * updates the active translation table. Called from the abort handler on
+ * a write permission fault, returns false if the fault isn't handled.
+ */
+bool vm_handle_cow_fault(struct user_mode_ctx *uctx, vaddr_t va);
+#else
+static inline bool vm_region_page_is_cow(struct vm_region *r __unused,
+					 size_t offs __unused)
+{
+	return false;
+}
+
+static inline bool vm_handle_cow_fault(struct user_mode_ctx *uctx __unused,
+				       vaddr_t va __unused)
+{
+	return false;
+}
+#endif
+
 /* Map parameters for a user TA */
 TEE_Result vm_map_param(struct user_mode_ctx *uctx, struct tee_ta_param *param,
 			void *param_va[TEE_NUM_PARAMS]);
@@ -24,6 +24,14 @@
  *
  * [in]     value[0].a-b    UUID
  * [out]    memref[1]	    Buffer with TA
+ *
+ * The TA can also be loaded in parts by supplying a third parameter, the
+ * buffer is then filled with as much of the TA as fits, starting at the
+ * supplied offset, and the updated size of memref[1] is the number of
+ * bytes written. This is not supported by all versions of tee-supplicant,
+ * TEE_ERROR_BAD_PARAMETERS is returned in that case.
+ *
+ * [in/out] value[2].a	    [in] Offset into the TA, [out] Size of the TA
  */
 #define OPTEE_RPC_CMD_LOAD_TA		U(0)
 
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <arm.h>
+#include <atomic.h>
+#include <inttypes.h>
+#include <kernel/boot_profile.h>
+#include <string.h>
+#include <string_ext.h>
+#include <trace.h>
+#include <util.h>
+
+struct boot_profile_entry {
+	const char *name;
+	const char *node;
+	uint64_t start;
+	uint64_t ticks;
+	TEE_Result res;
+	uint16_t level;
+	uint8_t type;
+};
+
+static struct boot_profile_entry entries[CFG_BOOT_PROFILE_ENTRIES];
+/* Number of calls made, including those not recorded */
+static uint32_t num_calls;
+
+static const char * const type_names[] = {
+	[BOOT_PROFILE_PREINITCALL] = "preinit",
+	[BOOT_PROFILE_INITCALL] = "init",
+	[BOOT_PROFILE_FINALCALL] = "final",
+	[BOOT_PROFILE_DT_PROBE] = "probe",
+};
+
+static uint64_t ticks_to_us(uint64_t ticks)
+{
+	uint32_t freq = read_cntfrq();
+
+	if (!freq)
+		return 0;
+
+	return (ticks / freq) * 1000000 + (ticks % freq) * 1000000 / freq;
+}
+
+static size_t num_entries(void)
+{
+	return MIN(atomic_load_u32(&num_calls), ARRAY_SIZE(entries));
+}
+
+uint64_t boot_profile_start(void)
+{
+	return barrier_read_counter_timer();
+}
+
+void boot_profile_add(enum boot_profile_type type, unsigned int level,
+		      const char *name, const char *node, uint64_t start,
+		      TEE_Result res)
+{
+	uint64_t end = barrier_read_counter_timer();
+	struct boot_profile_entry *e = NULL;
+	uint32_t idx = atomic_inc32(&num_calls) - 1;
+
+	if (idx >= ARRAY_SIZE(entries))
+		return;
+
+	e = entries + idx;
+	e->name = name;
+	e->node = node;
+	e->start = start;
+	e->ticks = end - start;
+	e->res = res;
+	e->level = MIN(level, (unsigned int)UINT16_MAX);
+	e->type = type;
+}
+
+void boot_profile_print(void)
+{
+	size_t n = num_entries();
+	size_t i = 0;
+
+	IMSG("Boot profile: %zu calls, %"PRIu64" us since counter start",
+	     n, ticks_to_us(barrier_read_counter_timer()));
+	IMSG("     start us   duration us  type    lvl  name");
+	for (i = 0; i < n; i++) {
+		struct boot_profile_entry *e = entries + i;
+
+		IMSG("%14"PRIu64" %13"PRIu64"  %-7s %3u  %s%s%s res %#"PRIx32,
+		     ticks_to_us(e->start), ticks_to_us(e->ticks),
+		     type_names[e->type], e->level,
+		     e->name ? e->name : "?", e->node ? " on " : "",
+		     e->node ? e->node : "", e->res);
+	}
+
+	if (atomic_load_u32(&num_calls) > n)
+		IMSG("Boot profile: %zu calls not recorded",
+		     atomic_load_u32(&num_calls) - n);
+}
+
+void boot_profile_get_records(size_t first, struct boot_profile_record *recs,
+			      size_t *num_recs, size_t *total,
+			      size_t *dropped)
+{
+	size_t n = num_entries();
+	size_t i = 0;
+
+	*total = n;
+	*dropped = atomic_load_u32(&num_calls) - n;
+	if (first >= n) {
+		*num_recs = 0;
+		return;
+	}
+
+	*num_recs = MIN(*num_recs, n - first);
+	for (i = 0; i < *num_recs; i++) {
+		struct boot_profile_entry *e = entries + first + i;
+		struct boot_profile_record *r = recs + i;
+
+		memset(r, 0, sizeof(*r));
+		if (e->name)
+			strlcpy(r->name, e->name, sizeof(r->name));
+		if (e->node)
+			strlcpy(r->node, e->node, sizeof(r->node));
+		r->type = e->type;
+		r->level = e->level;
+		r->res = e->res;
+		r->start_us = ticks_to_us(e->start);
+		r->duration_us = ticks_to_us(e->ticks);
+	}
+}
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <atomic.h>
+#include <config.h>
+#include <initcall.h>
+#include <kernel/boot_profile.h>
+#include <kernel/deferred_init.h>
+#include <kernel/mutex.h>
+#include <kernel/notif.h>
+#include <kernel/panic.h>
+#include <kernel/thread.h>
+#include <trace.h>
+
+#define deferred_initcall_begin \
+	SCATTERED_ARRAY_BEGIN(deferred_initcall, struct deferred_initcall)
+#define deferred_initcall_end \
+	SCATTERED_ARRAY_END(deferred_initcall, struct deferred_initcall)
+
+static SLIST_HEAD(, deferred_init) deferred_init_list =
+	SLIST_HEAD_INITIALIZER(deferred_init_list);
+
+/* Protects the state of all deferred_init and deferred_init_list */
+static struct mutex deferred_init_mu = MUTEX_INITIALIZER;
+static struct condvar deferred_init_cv = CONDVAR_INITIALIZER;
+
+static uint32_t run_all_started;
+static bool boot_done;
+
+/*
+ * Outside of a thread this can only be used during boot, before normal
+ * world is started, when the boot CPU runs alone and no locking is
+ * needed. Blocking isn't possible in the atomic contexts found after
+ * boot, so it's an error to get here from one of those.
+ */
+static bool in_thread(void)
+{
+	if (thread_get_id_may_fail() != THREAD_ID_INVALID)
+		return true;
+	if (boot_done)
+		panic("Deferred init outside of a thread");
+	return false;
+}
+
+static void lock(void)
+{
+	if (in_thread())
+		mutex_lock(&deferred_init_mu);
+}
+
+static void unlock(void)
+{
+	if (in_thread())
+		mutex_unlock(&deferred_init_mu);
+}
+
+void deferred_init_add(struct deferred_init *di)
+{
+	lock();
+	SLIST_INSERT_HEAD(&deferred_init_list, di, link);
+	unlock();
+}
+
+/* Called with the lock held, returns with it held */
+static void run_init(struct deferred_init *di)
+{
+	uint64_t __maybe_unused start = 0;
+	TEE_Result res = TEE_SUCCESS;
+
+	di->state = DEFERRED_INIT_RUNNING;
+	di->thread_id = thread_get_id_may_fail();
+	unlock();
+
+	DMSG("Deferred init %s()", di->name);
+	start = boot_profile_start();
+	res = di->init(di);
+	boot_profile_add(BOOT_PROFILE_INITCALL, 0, di->name, NULL, start,
+			 res);
+	if (res)
+		EMSG("Deferred init %s() failed: %#"PRIx32, di->name, res);
+
+	lock();
+	di->res = res;
+	di->state = DEFERRED_INIT_DONE;
+	if (in_thread())
+		condvar_broadcast(&deferred_init_cv);
+}
+
+TEE_Result deferred_init_wait(struct deferred_init *di)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	lock();
+	while (di->state == DEFERRED_INIT_RUNNING) {
+		if (!in_thread() || di->thread_id == thread_get_id())
+			panic("Deferred init dependency loop");
+		condvar_wait(&deferred_init_cv, &deferred_init_mu);
+	}
+	if (di->state == DEFERRED_INIT_PENDING)
+		run_init(di);
+	res = di->res;
+	unlock();
+
+	return res;
+}
+
+static struct deferred_init *next_pending(void)
+{
+	struct deferred_init *di = NULL;
+
+	lock();
+	SLIST_FOREACH(di, &deferred_init_list, link)
+		if (di->state == DEFERRED_INIT_PENDING)
+			break;
+	unlock();
+
+	return di;
+}
+
+void deferred_init_run_all(void)
+{
+	const struct deferred_initcall *dc = NULL;
+	struct deferred_init *di = NULL;
+
+	if (atomic_load_u32(&run_all_started) ||
+	    atomic_inc32(&run_all_started) != 1)
+		return;
+
+	for (dc = deferred_initcall_begin; dc < deferred_initcall_end; dc++)
+		deferred_init_wait(dc->di);
+
+	while ((di = next_pending()))
+		deferred_init_wait(di);
+}
+
+#ifdef CFG_DEFERRED_DRIVER_INIT
+static uint32_t bottom_half_requested;
+
+/*
+ * Yielding notifications are serialized, so other bottom halves are
+ * delayed while the deferred initializations run. That only happens once.
+ */
+static void yielding_deferred_init_notif(struct notif_driver *ndrv __unused,
+					 enum notif_event ev)
+{
+	if (ev == NOTIF_EVENT_DO_BOTTOM_HALF)
+		deferred_init_run_all();
+}
+
+static struct notif_driver deferred_init_notif = {
+	.yielding_cb = yielding_deferred_init_notif,
+};
+
+void deferred_init_schedule(void)
+{
+	if (atomic_load_u32(&bottom_half_requested) ||
+	    !notif_async_is_started())
+		return;
+
+	if (atomic_inc32(&bottom_half_requested) == 1)
+		notif_send_async(NOTIF_VALUE_DO_BOTTOM_HALF);
+}
+#endif
+
+static TEE_Result deferred_init_boot(void)
+{
+#ifdef CFG_DEFERRED_DRIVER_INIT
+	notif_register_driver(&deferred_init_notif);
+#else
+	deferred_init_run_all();
+#endif
+
+	return TEE_SUCCESS;
+}
+
+driver_init_late(deferred_init_boot);
+
+static TEE_Result deferred_init_boot_final(void)
+{
+	boot_done = true;
+
+	return TEE_SUCCESS;
+}
+
+boot_final(deferred_init_boot_final);
@@ -9,6 +9,7 @@
 #include <config.h>
 #include <initcall.h>
 #include <kernel/boot.h>
+#include <kernel/boot_profile.h>
 #include <kernel/dt.h>
 #include <kernel/dt_driver.h>
 #include <libfdt.h>
@@ -371,6 +372,7 @@ static TEE_Result probe_driver_node(const void *fdt,
 	TEE_Result res = TEE_ERROR_GENERIC;
 	const char __maybe_unused *drv_name = NULL;
 	const char __maybe_unused *node_name = NULL;
+	uint64_t __maybe_unused start = 0;
 
 	node_name = fdt_get_name(fdt, elt->nodeoffset, NULL);
 	drv_name = elt->dt_drv->name;
@@ -382,7 +384,10 @@ static TEE_Result probe_driver_node(const void *fdt,
 
 	FMSG("Probing %s on node %s", drv_name, node_name);
 
+	start = boot_profile_start();
 	res = elt->dt_drv->probe(fdt, elt->nodeoffset, elt->dm->compat_data);
+	boot_profile_add(BOOT_PROFILE_DT_PROBE, elt->deferrals + 1, drv_name,
+			 node_name, start, res);
 	switch (res) {
 	case TEE_SUCCESS:
 		TAILQ_INSERT_HEAD(&dt_driver_ready_list, elt, link);
@@ -3,22 +3,50 @@
  * Copyright (c) 2017, Linaro Limited
  * Copyright (c) 2020, Arm Limited.
  */
+#include <assert.h>
 #include <crypto/crypto.h>
 #include <initcall.h>
+#include <inttypes.h>
 #include <kernel/embedded_ts.h>
+#include <kernel/lz4.h>
+#include <kernel/mutex.h>
 #include <kernel/ts_store.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/queue.h>
 #include <trace.h>
 #include <utee_defines.h>
 #include <util.h>
 #include <zlib.h>
 
+/*
+ * Decompressed images kept for subsequent opens of the same TS, at most
+ * CFG_EMBEDDED_TS_CACHE_SIZE bytes in total. Unused images are evicted
+ * least recently used first when room is needed for another image.
+ */
+struct emb_ts_cache {
+	const struct embedded_ts *ts;
+	uint8_t *data;
+	unsigned int refc;
+	TAILQ_ENTRY(emb_ts_cache) link;
+};
+
+static TAILQ_HEAD(emb_ts_cache_head, emb_ts_cache) cache_head =
+	TAILQ_HEAD_INITIALIZER(cache_head);
+static size_t cache_size;
+static struct mutex cache_mu = MUTEX_INITIALIZER;
+
 struct ts_store_handle {
 	const struct embedded_ts *ts;
 	size_t offs;
+	struct emb_ts_cache *cache;
 	z_stream strm;
+	/* LZ4: offset of the next block in @ts->ts and current block */
+	size_t lz4_offs;
+	uint8_t *lz4_buf;
+	size_t lz4_pos;
+	size_t lz4_len;
 };
 
 static void *zalloc(void *opaque __unused, unsigned int items,
@@ -50,6 +78,135 @@ static bool decompression_init(z_stream *strm,
 	return true;
 }
 
+static TEE_Result inflate_all(const struct embedded_ts *ts, void *dst)
+{
+	z_stream strm = { };
+	int st = Z_OK;
+
+	if (!decompression_init(&strm, ts))
+		return TEE_ERROR_BAD_FORMAT;
+	strm.next_out = dst;
+	strm.avail_out = ts->uncompressed_size;
+	st = inflate(&strm, Z_FINISH);
+	inflateEnd(&strm);
+	if (st != Z_STREAM_END || strm.total_out != ts->uncompressed_size) {
+		EMSG("Decompression error (%d)", st);
+		return TEE_ERROR_BAD_FORMAT;
+	}
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result decompress_all(const struct embedded_ts *ts, void *dst)
+{
+	if (ts->compression == EMB_TS_COMP_LZ4)
+		return lz4_unpack(ts->ts, ts->size, dst, ts->uncompressed_size);
+	return inflate_all(ts, dst);
+}
+
+static bool cache_make_room(size_t size)
+{
+	struct emb_ts_cache *c = NULL;
+	struct emb_ts_cache *prev = NULL;
+
+	if (size > CFG_EMBEDDED_TS_CACHE_SIZE)
+		return false;
+
+	TAILQ_FOREACH_REVERSE_SAFE(c, &cache_head, emb_ts_cache_head, link,
+				   prev) {
+		if (cache_size + size <= CFG_EMBEDDED_TS_CACHE_SIZE)
+			break;
+		if (c->refc)
+			continue;
+		TAILQ_REMOVE(&cache_head, c, link);
+		cache_size -= c->ts->uncompressed_size;
+		free(c->data);
+		free(c);
+	}
+
+	return cache_size + size <= CFG_EMBEDDED_TS_CACHE_SIZE;
+}
+
+/*
+ * Returns the cached decompressed image of @ts, decompressing it first if
+ * needed. Returns NULL if the image doesn't fit in the cache or there's
+ * not enough memory, the caller is then expected to decompress the image
+ * as it's read instead.
+ */
+static struct emb_ts_cache *cache_get(const struct embedded_ts *ts)
+{
+	struct emb_ts_cache *c = NULL;
+
+	if (!CFG_EMBEDDED_TS_CACHE_SIZE)
+		return NULL;
+
+	/*
+	 * The mutex is held while decompressing to avoid decompressing the
+	 * same image twice on concurrent opens.
+	 */
+	mutex_lock(&cache_mu);
+
+	TAILQ_FOREACH(c, &cache_head, link) {
+		if (c->ts == ts) {
+			c->refc++;
+			TAILQ_REMOVE(&cache_head, c, link);
+			TAILQ_INSERT_HEAD(&cache_head, c, link);
+			goto out;
+		}
+	}
+
+	if (!cache_make_room(ts->uncompressed_size))
+		goto out;
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		goto out;
+	c->data = malloc(ts->uncompressed_size);
+	if (!c->data || decompress_all(ts, c->data)) {
+		free(c->data);
+		free(c);
+		c = NULL;
+		goto out;
+	}
+	c->ts = ts;
+	c->refc = 1;
+	cache_size += ts->uncompressed_size;
+	TAILQ_INSERT_HEAD(&cache_head, c, link);
+out:
+	mutex_unlock(&cache_mu);
+
+	return c;
+}
+
+static void cache_put(struct emb_ts_cache *c)
+{
+	mutex_lock(&cache_mu);
+	assert(c->refc);
+	c->refc--;
+	mutex_unlock(&cache_mu);
+}
+
+static TEE_Result stream_init(struct ts_store_handle *h)
+{
+	const struct embedded_ts *ts = h->ts;
+
+	switch (ts->compression) {
+	case EMB_TS_COMP_DEFLATE:
+		if (!decompression_init(&h->strm, ts))
+			return TEE_ERROR_BAD_FORMAT;
+		return TEE_SUCCESS;
+	case EMB_TS_COMP_LZ4:
+		h->lz4_buf = malloc(MIN(ts->uncompressed_size,
+					(uint32_t)LZ4_PACK_BLOCK_SIZE));
+		if (!h->lz4_buf)
+			return TEE_ERROR_OUT_OF_MEMORY;
+		return TEE_SUCCESS;
+	default:
+		EMSG("Unknown compression %"PRIu32, ts->compression);
+		return TEE_ERROR_BAD_FORMAT;
+	}
+}
+
 TEE_Result emb_ts_open(const TEE_UUID *uuid,
 		       struct ts_store_handle **h,
 		       const struct embedded_ts*
@@ -57,6 +214,7 @@ TEE_Result emb_ts_open(const TEE_UUID *uuid,
 {
 	struct ts_store_handle *handle = NULL;
 	const struct embedded_ts *ts = NULL;
+	TEE_Result res = TEE_SUCCESS;
 
 	ts = find_ts(uuid);
 	if (!ts)
@@ -66,13 +224,17 @@ TEE_Result emb_ts_open(const TEE_UUID *uuid,
 	if (!handle)
 		return TEE_ERROR_OUT_OF_MEMORY;
 
+	handle->ts = ts;
 	if (ts->uncompressed_size) {
-		if (!decompression_init(&handle->strm, ts)) {
-			free(handle);
-			return TEE_ERROR_BAD_FORMAT;
+		handle->cache = cache_get(ts);
+		if (!handle->cache) {
+			res = stream_init(handle);
+			if (res) {
+				free(handle);
+				return res;
+			}
 		}
 	}
-	handle->ts = ts;
 	*h = handle;
 
 	return TEE_SUCCESS;
@@ -120,14 +282,19 @@ out:
 static TEE_Result read_uncompressed(struct ts_store_handle *h, void *data,
 				    size_t len)
 {
-	uint8_t *src = (uint8_t *)h->ts->ts + h->offs;
+	const uint8_t *src = h->ts->ts;
+	size_t size = h->ts->size;
 	size_t next_offs = 0;
 
-	if (ADD_OVERFLOW(h->offs, len, &next_offs) ||
-	    next_offs > h->ts->size)
+	if (h->cache) {
+		src = h->cache->data;
+		size = h->ts->uncompressed_size;
+	}
+
+	if (ADD_OVERFLOW(h->offs, len, &next_offs) || next_offs > size)
 		return TEE_ERROR_BAD_PARAMETERS;
 	if (data)
-		memcpy(data, src, len);
+		memcpy(data, src + h->offs, len);
 	h->offs = next_offs;
 
 	return TEE_SUCCESS;
@@ -198,18 +365,72 @@ out:
 	return ret;
 }
 
+static TEE_Result read_lz4(struct ts_store_handle *h, void *data, size_t len)
+{
+	const struct embedded_ts *ts = h->ts;
+	TEE_Result res = TEE_SUCCESS;
+	uint8_t *dst = data;
+	size_t blk_size = 0;
+	size_t n = 0;
+
+	if (ADD_OVERFLOW(h->offs, len, &n) || n > ts->uncompressed_size)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	while (len) {
+		if (h->lz4_pos == h->lz4_len) {
+			blk_size = MIN(ts->uncompressed_size - h->offs,
+				       (size_t)LZ4_PACK_BLOCK_SIZE);
+			/* Whole blocks are decompressed in place */
+			if (dst && len >= blk_size) {
+				res = lz4_pack_next_block(ts->ts, ts->size,
+							  &h->lz4_offs, dst,
+							  blk_size);
+				if (res)
+					return res;
+				dst += blk_size;
+				h->offs += blk_size;
+				len -= blk_size;
+				continue;
+			}
+			res = lz4_pack_next_block(ts->ts, ts->size,
+						  &h->lz4_offs, h->lz4_buf,
+						  blk_size);
+			if (res)
+				return res;
+			h->lz4_pos = 0;
+			h->lz4_len = blk_size;
+		}
+
+		n = MIN(len, h->lz4_len - h->lz4_pos);
+		if (dst) {
+			memcpy(dst, h->lz4_buf + h->lz4_pos, n);
+			dst += n;
+		}
+		h->lz4_pos += n;
+		h->offs += n;
+		len -= n;
+	}
+
+	return TEE_SUCCESS;
+}
+
 TEE_Result emb_ts_read(struct ts_store_handle *h, void *data, size_t len)
 {
-	if (h->ts->uncompressed_size)
-		return read_compressed(h, data, len);
-	else
+	if (!h->ts->uncompressed_size || h->cache)
 		return read_uncompressed(h, data, len);
+	if (h->ts->compression == EMB_TS_COMP_LZ4)
+		return read_lz4(h, data, len);
+	return read_compressed(h, data, len);
 }
 
 void emb_ts_close(struct ts_store_handle *h)
 {
-	if (h->ts->uncompressed_size)
+	if (h->cache)
+		cache_put(h->cache);
+	else if (h->ts->uncompressed_size &&
+		 h->ts->compression == EMB_TS_COMP_DEFLATE)
 		inflateEnd(&h->strm);
+	free(h->lz4_buf);
 	free(h);
 }
 
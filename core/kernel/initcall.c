@@ -6,6 +6,7 @@
 
 #include <initcall.h>
 #include <trace.h>
+#include <kernel/boot_profile.h>
 #include <kernel/linker.h>
 
 /*
@@ -16,10 +17,14 @@ void __weak call_preinitcalls(void)
 {
 	const struct initcall *call = NULL;
 	TEE_Result ret = TEE_SUCCESS;
+	uint64_t __maybe_unused start = 0;
 
 	for (call = preinitcall_begin; call < preinitcall_end; call++) {
 		DMSG("level %d %s()", call->level, call->func_name);
+		start = boot_profile_start();
 		ret = call->func();
+		boot_profile_add(BOOT_PROFILE_PREINITCALL, INITCALL_LEVEL(call),
+				 INITCALL_NAME(call), NULL, start, ret);
 		if (ret != TEE_SUCCESS) {
 			EMSG("Preinitcall __text_start + 0x%08" PRIxVA
 			     " failed", (vaddr_t)call - VCORE_START_VA);
@@ -35,10 +40,14 @@ void __weak call_initcalls(void)
 {
 	const struct initcall *call = NULL;
 	TEE_Result ret = TEE_SUCCESS;
+	uint64_t __maybe_unused start = 0;
 
 	for (call = initcall_begin; call < initcall_end; call++) {
 		DMSG("level %d %s()", call->level, call->func_name);
+		start = boot_profile_start();
 		ret = call->func();
+		boot_profile_add(BOOT_PROFILE_INITCALL, INITCALL_LEVEL(call),
+				 INITCALL_NAME(call), NULL, start, ret);
 		if (ret != TEE_SUCCESS) {
 			EMSG("Initcall __text_start + 0x%08" PRIxVA
 			     " failed", (vaddr_t)call - VCORE_START_VA);
@@ -54,10 +63,14 @@ void __weak call_finalcalls(void)
 {
 	const struct initcall *call = NULL;
 	TEE_Result ret = TEE_SUCCESS;
+	uint64_t __maybe_unused start = 0;
 
 	for (call = finalcall_begin; call < finalcall_end; call++) {
 		DMSG("level %d %s()", call->level, call->func_name);
+		start = boot_profile_start();
 		ret = call->func();
+		boot_profile_add(BOOT_PROFILE_FINALCALL, INITCALL_LEVEL(call),
+				 INITCALL_NAME(call), NULL, start, ret);
 		if (ret != TEE_SUCCESS) {
 			EMSG("Finalcall __text_start + 0x%08" PRIxVA
 			     " failed", (vaddr_t)call - VCORE_START_VA);
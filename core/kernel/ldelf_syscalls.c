@@ -5,10 +5,13 @@
  */
 
 #include <assert.h>
+#include <config.h>
 #include <crypto/crypto.h>
 #include <kernel/ldelf_syscalls.h>
+#include <kernel/panic.h>
 #include <kernel/user_mode_ctx.h>
 #include <ldelf.h>
+#include <mm/core_memprot.h>
 #include <mm/file.h>
 #include <mm/fobj.h>
 #include <mm/mobj.h>
@@ -531,6 +534,140 @@ TEE_Result ldelf_syscall_gen_rnd_num(void *buf, size_t num_bytes)
 	return crypto_rng_read(buf, num_bytes);
 }
 
+/*
+ * Compares the pages mapped at @va in the active context with the
+ * relocated snapshot @snap.
+ */
+static bool reloc_pages_match(struct fobj *snap, vaddr_t va)
+{
+	unsigned int n = 0;
+
+	for (n = 0; n < snap->num_pages; n++) {
+		paddr_t pa = snap->ops->get_pa(snap, n);
+		void *p = phys_to_virt(pa, MEM_AREA_TA_RAM, SMALL_PAGE_SIZE);
+
+		if (!p || memcmp(p, (void *)(va + n * SMALL_PAGE_SIZE),
+				 SMALL_PAGE_SIZE))
+			return false;
+	}
+
+	return true;
+}
+
+TEE_Result ldelf_syscall_share_reloc(unsigned long va, size_t num_bytes,
+				     unsigned long ref_va)
+{
+	TEE_Result res = TEE_SUCCESS;
+	struct ts_session *sess = ts_get_current_session();
+	struct user_mode_ctx *uctx = to_user_mode_ctx(sess->ctx);
+	const uint16_t rw_prot = TEE_MATTR_URW | TEE_MATTR_PRW;
+	struct mobj *cow_mobj = NULL;
+	struct file *file = NULL;
+	struct mobj *mobj = NULL;
+	struct fobj *snap = NULL;
+	struct fobj *cow = NULL;
+	struct fobj *f = NULL;
+	vaddr_t map_va = va;
+	uint32_t vm_flags = 0;
+	uint16_t prot = 0;
+	size_t offs = 0;
+	size_t len = 0;
+	size_t sz = 0;
+
+	if (!IS_ENABLED(CFG_TA_SHARE_RELOC_PAGES))
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	if ((va & SMALL_PAGE_MASK) ||
+	    ROUNDUP_OVERFLOW(num_bytes, SMALL_PAGE_SIZE, &sz) || !sz)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/*
+	 * The handle of the ELF is closed once it's been loaded, the file
+	 * is instead found via a read-only mapping of the same ELF at
+	 * @ref_va.
+	 */
+	len = SMALL_PAGE_SIZE;
+	mobj = vm_get_mobj(uctx, ROUNDDOWN(ref_va, SMALL_PAGE_SIZE), &len,
+			   &prot, &offs);
+	if (!mobj)
+		return TEE_ERROR_BAD_PARAMETERS;
+	file = mobj_with_fobj_get_file(mobj);
+	mobj_put(mobj);
+	if (!file)
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	/*
+	 * Only a complete private read/write mapping, as created by
+	 * ldelf_syscall_map_zi(), can be shared.
+	 */
+	res = vm_get_flags(uctx, va, sz, &vm_flags);
+	if (res)
+		goto out_put_file;
+	len = sz;
+	mobj = vm_get_mobj(uctx, va, &len, &prot, &offs);
+	if (!mobj) {
+		res = TEE_ERROR_NOT_SUPPORTED;
+		goto out_put_file;
+	}
+	f = mobj_get_fobj(mobj);
+	mobj_put(mobj);
+	if (vm_flags || len != sz || offs || prot != rw_prot || !f ||
+	    f->num_pages * SMALL_PAGE_SIZE != sz || !f->ops->get_pa) {
+		res = TEE_ERROR_NOT_SUPPORTED;
+		goto out_put_fobj;
+	}
+
+	if (!file_trylock(file)) {
+		/* See comment in ldelf_syscall_map_bin() */
+		vm_set_ctx(NULL);
+		file_lock(file);
+		vm_set_ctx(uctx->ts_ctx);
+	}
+
+	snap = file_find_reloc_slice(file, va, f->num_pages);
+	if (snap && !reloc_pages_match(snap, va)) {
+		res = TEE_ERROR_NOT_SUPPORTED;
+		goto out_unlock;
+	}
+
+	/* The first instance donates its pages as the snapshot */
+	cow = fobj_cow_alloc(snap ? snap : f);
+	cow_mobj = mobj_with_fobj_alloc(cow, NULL);
+	fobj_put(cow);
+	if (!cow_mobj) {
+		res = TEE_ERROR_OUT_OF_MEMORY;
+		goto out_unlock;
+	}
+
+	/*
+	 * The snapshot must not be registered while it's still mapped
+	 * writeable, so unmap first.
+	 */
+	if (vm_unmap(uctx, va, sz))
+		panic();
+	res = vm_map(uctx, &map_va, sz, rw_prot, VM_FLAG_COW, cow_mobj, 0);
+	mobj_put(cow_mobj);
+	/*
+	 * The context currently is active set it again to update
+	 * the mapping.
+	 */
+	vm_set_ctx(uctx->ts_ctx);
+	if (res)
+		goto out_unlock;
+
+	if (!snap && file_add_reloc_slice(file, f, va))
+		DMSG("Cannot add relocated snapshot at %#"PRIxVA, va);
+
+out_unlock:
+	file_unlock(file);
+out_put_fobj:
+	fobj_put(f);
+out_put_file:
+	file_put(file);
+
+	return res;
+}
+
 /*
  * Should be called after returning from ldelf. If user_ctx is not NULL means
  * that ldelf crashed or otherwise didn't complete properly. This function will
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <io.h>
+#include <kernel/lz4.h>
+#include <string.h>
+#include <trace.h>
+#include <types_ext.h>
+#include <util.h>
+
+/*
+ * Decompressor for the LZ4 block format, see
+ * https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ *
+ * A block is a sequence of (token, literals, offset, match length)
+ * sequences where the last sequence only holds literals.
+ */
+
+static bool read_len(const uint8_t **ip, const uint8_t *ip_end, size_t *len)
+{
+	uint8_t b = 0;
+
+	do {
+		if (*ip == ip_end)
+			return false;
+		b = *(*ip)++;
+		if (ADD_OVERFLOW(*len, b, len))
+			return false;
+	} while (b == 255);
+
+	return true;
+}
+
+TEE_Result lz4_decompress_block(const void *src, size_t src_len, void *dst,
+				size_t *dst_len)
+{
+	const uint8_t *ip = src;
+	const uint8_t *ip_end = ip + src_len;
+	uint8_t *op = dst;
+	uint8_t *op_end = op + *dst_len;
+
+	while (true) {
+		const uint8_t *match = NULL;
+		unsigned int token = 0;
+		size_t offs = 0;
+		size_t len = 0;
+
+		if (ip == ip_end)
+			return TEE_ERROR_BAD_FORMAT;
+		token = *ip++;
+
+		/* Literals */
+		len = token >> 4;
+		if (len == 15 && !read_len(&ip, ip_end, &len))
+			return TEE_ERROR_BAD_FORMAT;
+		if (len > (size_t)(ip_end - ip) || len > (size_t)(op_end - op))
+			return TEE_ERROR_BAD_FORMAT;
+		memcpy(op, ip, len);
+		op += len;
+		ip += len;
+
+		/* The last sequence has no match */
+		if (ip == ip_end)
+			break;
+
+		/* Match */
+		if (ip_end - ip < 2)
+			return TEE_ERROR_BAD_FORMAT;
+		offs = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (!offs || offs > (size_t)(op - (uint8_t *)dst))
+			return TEE_ERROR_BAD_FORMAT;
+
+		len = token & 0xf;
+		if (len == 15 && !read_len(&ip, ip_end, &len))
+			return TEE_ERROR_BAD_FORMAT;
+		len += 4;
+		if (len > (size_t)(op_end - op))
+			return TEE_ERROR_BAD_FORMAT;
+
+		match = op - offs;
+		if (offs >= len) {
+			memcpy(op, match, len);
+			op += len;
+		} else {
+			/* Overlapping copy repeats the last @offs bytes */
+			while (len--)
+				*op++ = *match++;
+		}
+	}
+
+	*dst_len = op - (uint8_t *)dst;
+	return TEE_SUCCESS;
+}
+
+TEE_Result lz4_pack_next_block(const void *src, size_t src_len,
+			       size_t *src_offs, void *dst, size_t dst_len)
+{
+	const uint8_t *s = src;
+	TEE_Result res = TEE_SUCCESS;
+	size_t offs = *src_offs;
+	size_t blk_len = 0;
+	size_t end = 0;
+	uint32_t hdr = 0;
+
+	if (ADD_OVERFLOW(offs, LZ4_PACK_HDR_SIZE, &offs) || offs > src_len)
+		return TEE_ERROR_BAD_FORMAT;
+	hdr = get_le32(s + offs - LZ4_PACK_HDR_SIZE);
+	blk_len = hdr & ~LZ4_PACK_STORED;
+	if (ADD_OVERFLOW(offs, blk_len, &end) || end > src_len)
+		return TEE_ERROR_BAD_FORMAT;
+
+	if (hdr & LZ4_PACK_STORED) {
+		if (blk_len != dst_len)
+			return TEE_ERROR_BAD_FORMAT;
+		memcpy(dst, s + offs, blk_len);
+	} else {
+		size_t len = dst_len;
+
+		res = lz4_decompress_block(s + offs, blk_len, dst, &len);
+		if (res)
+			return res;
+		if (len != dst_len)
+			return TEE_ERROR_BAD_FORMAT;
+	}
+
+	*src_offs = end;
+	return TEE_SUCCESS;
+}
+
+TEE_Result lz4_unpack(const void *src, size_t src_len, void *dst,
+		      size_t dst_len)
+{
+	TEE_Result res = TEE_SUCCESS;
+	size_t src_offs = 0;
+	size_t n = 0;
+
+	for (n = 0; n < dst_len; n += LZ4_PACK_BLOCK_SIZE) {
+		res = lz4_pack_next_block(src, src_len, &src_offs,
+					  (uint8_t *)dst + n,
+					  MIN(dst_len - n,
+					      (size_t)LZ4_PACK_BLOCK_SIZE));
+		if (res) {
+			EMSG("LZ4 decompression error at offset %zu", n);
+			return res;
+		}
+	}
+
+	return TEE_SUCCESS;
+}
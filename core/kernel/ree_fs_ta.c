@@ -55,9 +55,19 @@
 #include <tee/uuid.h>
 #include <utee_defines.h>
 
+/*
+ * TAs are loaded in windows of this size when supported by tee-supplicant,
+ * else in one go.
+ */
+#define TA_LOAD_WINDOW_SIZE	(64 * 1024)
+
 struct ree_fs_ta_handle {
-	struct shdr *nw_ta; /* Non-secure (shared memory) */
-	size_t nw_ta_size;
+	TEE_UUID uuid;
+	uint8_t *nw_ta; /* Non-secure (shared memory) window of the TA */
+	size_t nw_ta_offs; /* Offset of @nw_ta in the TA */
+	size_t nw_ta_len; /* Number of valid bytes in @nw_ta */
+	size_t nw_ta_size; /* Size of the TA */
+	bool windowed;
 	struct mobj *mobj;
 	size_t offs;
 	struct shdr *shdr; /* Verified secure copy of @nw_ta's signed header */
@@ -75,6 +85,9 @@ struct ta_ver_db_hdr {
 static const char ta_ver_db_obj_id[] = "ta_ver.db";
 static struct mutex ta_ver_db_mutex = MUTEX_INITIALIZER;
 
+/* Set if tee-supplicant doesn't support loading TAs in windows */
+static bool rpc_load_window_unsupported;
+
 /*
  * Load a TA via RPC with UUID defined by input param @uuid. The virtual
  * address of the raw TA binary is received in out parameter @ta.
@@ -124,14 +137,86 @@ exit:
 	return res;
 }
 
+/*
+ * Load the window of the TA starting at @offs via RPC into the shared
+ * memory buffer of @h.
+ */
+static TEE_Result rpc_load_window(struct ree_fs_ta_handle *h, size_t offs)
+{
+	struct thread_param params[3] = { };
+	TEE_Result res = TEE_SUCCESS;
+	size_t len = 0;
+
+	params[0].attr = THREAD_PARAM_ATTR_VALUE_IN;
+	tee_uuid_to_octets((void *)&params[0].u.value, &h->uuid);
+	params[1] = THREAD_PARAM_MEMREF(OUT, h->mobj, 0, TA_LOAD_WINDOW_SIZE);
+	params[2] = THREAD_PARAM_VALUE(INOUT, offs, 0, 0);
+
+	res = thread_rpc_cmd(OPTEE_RPC_CMD_LOAD_TA, 3, params);
+	if (res)
+		return res;
+
+	len = params[1].u.memref.size;
+	if (!len || len > TA_LOAD_WINDOW_SIZE ||
+	    (h->nw_ta_size && params[2].u.value.a != h->nw_ta_size) ||
+	    offs + len > params[2].u.value.a)
+		return TEE_ERROR_SECURITY;
+
+	h->nw_ta_size = params[2].u.value.a;
+	h->nw_ta_offs = offs;
+	h->nw_ta_len = len;
+	return TEE_SUCCESS;
+}
+
+/*
+ * Request the TA from tee-supplicant, in windows of TA_LOAD_WINDOW_SIZE
+ * if supported by tee-supplicant else all of it.
+ */
+static TEE_Result load_ta(struct ree_fs_ta_handle *h)
+{
+	TEE_Result res = TEE_SUCCESS;
+	struct shdr *ta = NULL;
+
+	if (!rpc_load_window_unsupported) {
+		h->mobj = thread_rpc_alloc_payload(TA_LOAD_WINDOW_SIZE);
+		if (!h->mobj)
+			return TEE_ERROR_OUT_OF_MEMORY;
+		h->nw_ta = mobj_get_va(h->mobj, 0, TA_LOAD_WINDOW_SIZE);
+		if (!h->nw_ta)
+			return TEE_ERROR_SHORT_BUFFER;
+
+		res = rpc_load_window(h, 0);
+		if (!res)
+			h->windowed = true;
+		if (res != TEE_ERROR_BAD_PARAMETERS)
+			return res;
+
+		DMSG("tee-supplicant can't load TAs in windows");
+		rpc_load_window_unsupported = true;
+		thread_rpc_free_payload(h->mobj);
+		h->mobj = NULL;
+		h->nw_ta = NULL;
+	}
+
+	res = rpc_load(&h->uuid, &ta, &h->nw_ta_size, &h->mobj);
+	if (res) {
+		/* rpc_load() has already freed the payload */
+		h->mobj = NULL;
+		return res;
+	}
+	h->nw_ta = (uint8_t *)ta;
+	h->nw_ta_offs = 0;
+	h->nw_ta_len = h->nw_ta_size;
+	return TEE_SUCCESS;
+}
+
 static TEE_Result ree_fs_ta_open(const TEE_UUID *uuid,
 				 struct ts_store_handle **h)
 {
 	struct ree_fs_ta_handle *handle;
 	struct shdr *shdr = NULL;
-	struct mobj *mobj = NULL;
 	void *hash_ctx = NULL;
-	struct shdr *ta = NULL;
+	void *ta = NULL;
 	size_t ta_size = 0;
 	TEE_Result res = TEE_SUCCESS;
 	size_t offs = 0;
@@ -142,11 +227,19 @@ static TEE_Result ree_fs_ta_open(const TEE_UUID *uuid,
 	handle = calloc(1, sizeof(*handle));
 	if (!handle)
 		return TEE_ERROR_OUT_OF_MEMORY;
+	handle->uuid = *uuid;
 
 	/* Request TA from tee-supplicant */
-	res = rpc_load(uuid, &ta, &ta_size, &mobj);
+	res = load_ta(handle);
 	if (res != TEE_SUCCESS)
-		goto error;
+		goto error_free_payload;
+
+	/*
+	 * All the headers must be in the first window, in the checks
+	 * below @ta_size is the number of bytes available.
+	 */
+	ta = handle->nw_ta;
+	ta_size = handle->nw_ta_len;
 
 	/* Make secure copy of signed header */
 	shdr = shdr_alloc_and_copy(ta, ta_size);
@@ -267,25 +360,22 @@ static TEE_Result ree_fs_ta_open(const TEE_UUID *uuid,
 		handle->ehdr = ehdr;
 	}
 
-	if (ta_size != offs + shdr->img_size) {
+	if (handle->nw_ta_size != offs + shdr->img_size) {
 		res = TEE_ERROR_SECURITY;
 		goto error_free_hash;
 	}
 
-	handle->nw_ta = ta;
-	handle->nw_ta_size = ta_size;
 	handle->offs = offs;
 	handle->hash_ctx = hash_ctx;
 	handle->shdr = shdr;
-	handle->mobj = mobj;
 	*h = (struct ts_store_handle *)handle;
 	return TEE_SUCCESS;
 
 error_free_hash:
 	crypto_hash_free_ctx(hash_ctx);
 error_free_payload:
-	thread_rpc_free_payload(mobj);
-error:
+	if (handle->mobj)
+		thread_rpc_free_payload(handle->mobj);
 	free(ehdr);
 	free(bs_hdr);
 	shdr_free(shdr);
@@ -431,20 +521,41 @@ out:
 	return res;
 }
 
-static TEE_Result ree_fs_ta_read(struct ts_store_handle *h, void *data,
-				 size_t len)
+/*
+ * Returns in @src the address of the next @len bytes to read, or of as
+ * many of those bytes as available in the current window in which case
+ * @len is updated. Loads the next window if needed.
+ */
+static TEE_Result get_nw_src(struct ree_fs_ta_handle *h, uint8_t **src,
+			     size_t *len)
 {
-	struct ree_fs_ta_handle *handle = (struct ree_fs_ta_handle *)h;
+	TEE_Result res = TEE_SUCCESS;
+	size_t win_offs = 0;
 
-	uint8_t *src = (uint8_t *)handle->nw_ta + handle->offs;
-	size_t next_offs = 0;
+	if (h->offs < h->nw_ta_offs)
+		return TEE_ERROR_BAD_STATE;
+
+	win_offs = h->offs - h->nw_ta_offs;
+	if (win_offs >= h->nw_ta_len) {
+		if (!h->windowed)
+			return TEE_ERROR_BAD_STATE;
+		res = rpc_load_window(h, h->offs);
+		if (res)
+			return res;
+		win_offs = 0;
+	}
+
+	*src = h->nw_ta + win_offs;
+	*len = MIN(*len, h->nw_ta_len - win_offs);
+	return TEE_SUCCESS;
+}
+
+static TEE_Result read_chunk(struct ree_fs_ta_handle *handle, uint8_t *data,
+			     uint8_t *src, size_t len)
+{
 	uint8_t *dst = src;
 	TEE_Result res = TEE_SUCCESS;
 
-	if (ADD_OVERFLOW(handle->offs, len, &next_offs) ||
-	    next_offs > handle->nw_ta_size)
-		return TEE_ERROR_BAD_PARAMETERS;
-
 	if (handle->shdr->img_type == SHDR_ENCRYPTED_TA) {
 		if (data) {
 			dst = data; /* Hash secure buffer */
@@ -491,7 +602,41 @@ static TEE_Result ree_fs_ta_read(struct ts_store_handle *h, void *data,
 			return TEE_ERROR_SECURITY;
 	}
 
-	handle->offs = next_offs;
+	return TEE_SUCCESS;
+}
+
+static TEE_Result ree_fs_ta_read(struct ts_store_handle *h, void *data,
+				 size_t len)
+{
+	struct ree_fs_ta_handle *handle = (struct ree_fs_ta_handle *)h;
+	uint8_t *dst = data;
+	size_t next_offs = 0;
+	TEE_Result res = TEE_SUCCESS;
+
+	if (ADD_OVERFLOW(handle->offs, len, &next_offs) ||
+	    next_offs > handle->nw_ta_size)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/*
+	 * When the TA is loaded in windows the data is hashed and
+	 * decrypted one window at a time while the rest of the TA hasn't
+	 * been transferred yet.
+	 */
+	while (handle->offs < next_offs) {
+		size_t n = next_offs - handle->offs;
+		uint8_t *src = NULL;
+
+		res = get_nw_src(handle, &src, &n);
+		if (res)
+			return res;
+		res = read_chunk(handle, dst, src, n);
+		if (res)
+			return res;
+		handle->offs += n;
+		if (dst)
+			dst += n;
+	}
+
 	if (handle->offs == handle->nw_ta_size) {
 		if (handle->shdr->img_type == SHDR_ENCRYPTED_TA) {
 			/*
@@ -549,72 +694,299 @@ REGISTER_TA_STORE(9) = {
  * The whole TA/library is read into a temporary buffer during .open(). This
  * allows the binary to be authenticated before any data is read and processed
  * by the upper layer (ELF loader).
+ *
+ * With CFG_REE_FS_TA_CACHE=y the buffers holding verified (and when needed
+ * decrypted) binaries are kept in a cache after the last handle is closed,
+ * up to CFG_REE_FS_TA_CACHE_SIZE bytes in total. The signed header is
+ * still loaded via tee-supplicant and verified each time, but if the
+ * UUID, digest and TA version match a cached binary the rest of the TA is
+ * neither loaded, hashed nor decrypted. The TA version database is checked
+ * again to make sure that a newer version hasn't been loaded since. Least
+ * recently used binaries are evicted first, also when the "Secure DDR"
+ * pool is too fragmented or full to hold a binary or TA memory being
+ * allocated.
  */
 
-struct buf_ree_fs_ta_handle {
-	struct ts_store_handle *h; /* Note: a REE FS TA store handle */
+struct buf_ta_image {
+	TEE_UUID uuid;
 	size_t ta_size;
 	tee_mm_entry_t *mm;
 	uint8_t *buf;
-	size_t offs;
 	uint8_t *tag;
 	unsigned int tag_len;
+	struct shdr_bootstrap_ta *bs_hdr;
+	unsigned int num_refs;
+	bool in_cache;
+	TAILQ_ENTRY(buf_ta_image) link;
 };
 
-static TEE_Result buf_ta_open(const TEE_UUID *uuid,
-			      struct ts_store_handle **h)
+struct buf_ree_fs_ta_handle {
+	struct buf_ta_image *img;
+	size_t offs;
+};
+
+#ifdef CFG_REE_FS_TA_CACHE
+static TAILQ_HEAD(ta_cache_head, buf_ta_image) ta_cache =
+	TAILQ_HEAD_INITIALIZER(ta_cache);
+static size_t ta_cache_size;
+#endif
+/* Protects the cache and buf_ta_image::num_refs */
+static struct mutex ta_cache_mu = MUTEX_INITIALIZER;
+
+static void buf_ta_image_free(struct buf_ta_image *img)
 {
-	struct buf_ree_fs_ta_handle *handle = NULL;
+	if (img) {
+		tee_mm_free(img->mm);
+		free(img->tag);
+		free(img->bs_hdr);
+		free(img);
+	}
+}
+
+static void buf_ta_image_put(struct buf_ta_image *img)
+{
+	bool do_free = false;
+
+	mutex_lock(&ta_cache_mu);
+	assert(img->num_refs);
+	img->num_refs--;
+	do_free = !img->num_refs;
+	mutex_unlock(&ta_cache_mu);
+
+	if (do_free)
+		buf_ta_image_free(img);
+}
+
+#ifdef CFG_REE_FS_TA_CACHE
+/* Called with ta_cache_mu held */
+static void ta_cache_evict(struct buf_ta_image *img)
+{
+	TAILQ_REMOVE(&ta_cache, img, link);
+	img->in_cache = false;
+	ta_cache_size -= img->ta_size;
+	assert(img->num_refs);
+	img->num_refs--;
+	if (!img->num_refs)
+		buf_ta_image_free(img);
+}
+
+/*
+ * Evicts least recently used images until @size bytes can be added
+ * without exceeding CFG_REE_FS_TA_CACHE_SIZE. Returns false if @size is
+ * too large to be cached at all.
+ */
+static bool ta_cache_make_room(size_t size)
+{
+	if (size > CFG_REE_FS_TA_CACHE_SIZE)
+		return false;
+
+	while (ta_cache_size + size > CFG_REE_FS_TA_CACHE_SIZE)
+		ta_cache_evict(TAILQ_LAST(&ta_cache, ta_cache_head));
+
+	return true;
+}
+
+bool ree_fs_ta_cache_shrink(void)
+{
+	bool freed = false;
+
+	mutex_lock(&ta_cache_mu);
+	freed = !TAILQ_EMPTY(&ta_cache);
+	while (!TAILQ_EMPTY(&ta_cache))
+		ta_cache_evict(TAILQ_LAST(&ta_cache, ta_cache_head));
+	mutex_unlock(&ta_cache_mu);
+
+	return freed;
+}
+
+/*
+ * A cached image is identified by the UUID, the digest of the binary and
+ * the TA version. These are compared with the signed header just loaded
+ * from the REE filesystem, so a TA updated there is never served from a
+ * stale cached image.
+ */
+static bool buf_ta_image_match(struct buf_ta_image *img,
+			       struct ree_fs_ta_handle *h)
+{
+	if (memcmp(&img->uuid, &h->uuid, sizeof(img->uuid)))
+		return false;
+	if (img->tag_len != h->shdr->hash_size ||
+	    memcmp(img->tag, SHDR_GET_HASH(h->shdr), img->tag_len))
+		return false;
+	if (!img->bs_hdr || !h->bs_hdr)
+		return !img->bs_hdr && !h->bs_hdr;
+
+	return img->bs_hdr->ta_version == h->bs_hdr->ta_version;
+}
+
+static struct buf_ta_image *ta_cache_get(struct ree_fs_ta_handle *h)
+{
+	struct buf_ta_image *img = NULL;
+
+	mutex_lock(&ta_cache_mu);
+	TAILQ_FOREACH(img, &ta_cache, link) {
+		if (buf_ta_image_match(img, h)) {
+			/* Move to the front, it's now most recently used */
+			TAILQ_REMOVE(&ta_cache, img, link);
+			TAILQ_INSERT_HEAD(&ta_cache, img, link);
+			img->num_refs++;
+			break;
+		}
+	}
+	mutex_unlock(&ta_cache_mu);
+
+	if (img && img->bs_hdr && check_update_version(img->bs_hdr)) {
+		/* A newer version of the TA has been loaded since */
+		mutex_lock(&ta_cache_mu);
+		if (img->in_cache)
+			ta_cache_evict(img);
+		mutex_unlock(&ta_cache_mu);
+		buf_ta_image_put(img);
+		return NULL;
+	}
+
+	return img;
+}
+
+static void ta_cache_add(struct buf_ta_image *img)
+{
+	struct buf_ta_image *i = NULL;
+	struct buf_ta_image *next = NULL;
+
+	mutex_lock(&ta_cache_mu);
+	/* Other images of this TA are outdated and can't be matched again */
+	TAILQ_FOREACH_SAFE(i, &ta_cache, link, next)
+		if (!memcmp(&i->uuid, &img->uuid, sizeof(img->uuid)))
+			ta_cache_evict(i);
+
+	if (ta_cache_make_room(img->ta_size)) {
+		img->num_refs++;
+		img->in_cache = true;
+		TAILQ_INSERT_HEAD(&ta_cache, img, link);
+		ta_cache_size += img->ta_size;
+	}
+	mutex_unlock(&ta_cache_mu);
+}
+#else
+static struct buf_ta_image *ta_cache_get(struct ree_fs_ta_handle *h __unused)
+{
+	return NULL;
+}
+
+static void ta_cache_add(struct buf_ta_image *img __unused)
+{
+}
+#endif /*CFG_REE_FS_TA_CACHE*/
+
+static TEE_Result buf_ta_image_load(struct ree_fs_ta_handle *h,
+				    struct buf_ta_image **img_ret)
+{
+	struct buf_ta_image *img = NULL;
 	TEE_Result res = TEE_SUCCESS;
 
-	handle = calloc(1, sizeof(*handle));
-	if (!handle)
+	img = calloc(1, sizeof(*img));
+	if (!img)
 		return TEE_ERROR_OUT_OF_MEMORY;
-	res = ree_fs_ta_open(uuid, &handle->h);
-	if (res)
-		goto err2;
-	res = ree_fs_ta_get_size(handle->h, &handle->ta_size);
+	img->uuid = h->uuid;
+	img->num_refs = 1;
+
+	res = ree_fs_ta_get_size((struct ts_store_handle *)h, &img->ta_size);
 	if (res)
-		goto err;
+		goto out;
 
-	res = ree_fs_ta_get_tag(handle->h, NULL, &handle->tag_len);
+	res = ree_fs_ta_get_tag((struct ts_store_handle *)h, NULL,
+				&img->tag_len);
 	if (res != TEE_ERROR_SHORT_BUFFER) {
 		res = TEE_ERROR_GENERIC;
-		goto err;
+		goto out;
 	}
-	handle->tag = malloc(handle->tag_len);
-	if (!handle->tag) {
+	img->tag = malloc(img->tag_len);
+	if (!img->tag) {
 		res = TEE_ERROR_OUT_OF_MEMORY;
-		goto err;
+		goto out;
 	}
-	res = ree_fs_ta_get_tag(handle->h, handle->tag, &handle->tag_len);
+	res = ree_fs_ta_get_tag((struct ts_store_handle *)h, img->tag,
+				&img->tag_len);
 	if (res)
-		goto err;
+		goto out;
+
+	if (h->bs_hdr) {
+		img->bs_hdr = malloc(sizeof(*img->bs_hdr));
+		if (!img->bs_hdr) {
+			res = TEE_ERROR_OUT_OF_MEMORY;
+			goto out;
+		}
+		*img->bs_hdr = *h->bs_hdr;
+	}
 
-	handle->mm = tee_mm_alloc(&tee_mm_sec_ddr, handle->ta_size);
-	if (!handle->mm) {
+	img->mm = tee_mm_alloc(&tee_mm_sec_ddr, img->ta_size);
+	/* Make room by dropping cached binaries and try again */
+	if (!img->mm && ree_fs_ta_cache_shrink())
+		img->mm = tee_mm_alloc(&tee_mm_sec_ddr, img->ta_size);
+	if (!img->mm) {
 		res = TEE_ERROR_OUT_OF_MEMORY;
-		goto err;
+		goto out;
 	}
-	handle->buf = phys_to_virt(tee_mm_get_smem(handle->mm),
-				   MEM_AREA_TA_RAM, handle->ta_size);
-	if (!handle->buf) {
+	img->buf = phys_to_virt(tee_mm_get_smem(img->mm), MEM_AREA_TA_RAM,
+				img->ta_size);
+	if (!img->buf) {
 		res = TEE_ERROR_OUT_OF_MEMORY;
-		goto err;
+		goto out;
 	}
-	res = ree_fs_ta_read(handle->h, handle->buf, handle->ta_size);
-	if (res)
-		goto err;
-	*h = (struct ts_store_handle *)handle;
-err:
-	ree_fs_ta_close(handle->h);
-err2:
+	res = ree_fs_ta_read((struct ts_store_handle *)h, img->buf,
+			     img->ta_size);
+out:
+	if (res) {
+		buf_ta_image_free(img);
+		return res;
+	}
+	*img_ret = img;
+	return TEE_SUCCESS;
+}
+
+static TEE_Result buf_ta_open(const TEE_UUID *uuid,
+			      struct ts_store_handle **h)
+{
+	struct buf_ree_fs_ta_handle *handle = NULL;
+	struct ree_fs_ta_handle *ree_h = NULL;
+	uint64_t begin = barrier_read_counter_timer();
+	TEE_Result res = TEE_SUCCESS;
+	bool cached = true;
+
+	handle = calloc(1, sizeof(*handle));
+	if (!handle)
+		return TEE_ERROR_OUT_OF_MEMORY;
+
+	/*
+	 * The signed header is always loaded and verified, the rest of the
+	 * binary is only loaded if it isn't found in the cache.
+	 */
+	res = ree_fs_ta_open(uuid, (struct ts_store_handle **)&ree_h);
 	if (res) {
-		tee_mm_free(handle->mm);
-		free(handle->tag);
 		free(handle);
+		return res;
 	}
-	return res;
+
+	handle->img = ta_cache_get(ree_h);
+	if (!handle->img) {
+		cached = false;
+		res = buf_ta_image_load(ree_h, &handle->img);
+		if (!res)
+			ta_cache_add(handle->img);
+	}
+	ree_fs_ta_close((struct ts_store_handle *)ree_h);
+	if (res) {
+		free(handle);
+		return res;
+	}
+
+	DMSG("%pUl %s in %"PRIu64" us", (void *)uuid,
+	     cached ? "found in cache" : "loaded",
+	     (barrier_read_counter_timer() - begin) * 1000000 /
+	     read_cntfrq());
+
+	*h = (struct ts_store_handle *)handle;
+	return TEE_SUCCESS;
 }
 
 static TEE_Result buf_ta_get_size(const struct ts_store_handle *h,
@@ -622,7 +994,7 @@ static TEE_Result buf_ta_get_size(const struct ts_store_handle *h,
 {
 	struct buf_ree_fs_ta_handle *handle = (struct buf_ree_fs_ta_handle *)h;
 
-	*size = handle->ta_size;
+	*size = handle->img->ta_size;
 	return TEE_SUCCESS;
 }
 
@@ -630,11 +1002,11 @@ static TEE_Result buf_ta_read(struct ts_store_handle *h, void *data,
 			      size_t len)
 {
 	struct buf_ree_fs_ta_handle *handle = (struct buf_ree_fs_ta_handle *)h;
-	uint8_t *src = handle->buf + handle->offs;
+	uint8_t *src = handle->img->buf + handle->offs;
 	size_t next_offs = 0;
 
 	if (ADD_OVERFLOW(handle->offs, len, &next_offs) ||
-	    next_offs > handle->ta_size)
+	    next_offs > handle->img->ta_size)
 		return TEE_ERROR_BAD_PARAMETERS;
 
 	if (data)
@@ -647,12 +1019,13 @@ static TEE_Result buf_ta_get_tag(const struct ts_store_handle *h,
 				 uint8_t *tag, unsigned int *tag_len)
 {
 	struct buf_ree_fs_ta_handle *handle = (struct buf_ree_fs_ta_handle *)h;
+	struct buf_ta_image *img = handle->img;
 
-	*tag_len = handle->tag_len;
-	if (!tag || *tag_len < handle->tag_len)
+	*tag_len = img->tag_len;
+	if (!tag || *tag_len < img->tag_len)
 		return TEE_ERROR_SHORT_BUFFER;
 
-	memcpy(tag, handle->tag, handle->tag_len);
+	memcpy(tag, img->tag, img->tag_len);
 
 	return TEE_SUCCESS;
 }
@@ -663,8 +1036,7 @@ static void buf_ta_close(struct ts_store_handle *h)
 
 	if (!handle)
 		return;
-	tee_mm_free(handle->mm);
-	free(handle->tag);
+	buf_ta_image_put(handle->img);
 	free(handle);
 }
 
@@ -38,4 +38,7 @@ srcs-$(CFG_SECSTOR_TA) += secstor_ta.c
 endif
 
 srcs-$(CFG_EMBEDDED_TS) += embedded_ts.c
+srcs-$(CFG_LZ4) += lz4.c
+srcs-$(CFG_BOOT_PROFILE) += boot_profile.c
+srcs-y += deferred_init.c
 srcs-y += pseudo_ta.c
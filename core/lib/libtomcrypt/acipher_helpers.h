@@ -102,4 +102,47 @@ sm2_ltc_pke_encrypt(struct ecc_public_key *key __unused,
 	return TEE_ERROR_NOT_IMPLEMENTED;
 }
 #endif
+#ifdef _CFG_CORE_LTC_ECC_P256
+TEE_Result ecc_p256_generate_keypair(struct ecc_keypair *key);
+
+TEE_Result ecc_p256_sign(struct ecc_keypair *key, const uint8_t *msg,
+			 size_t msg_len, uint8_t *sig, size_t *sig_len);
+
+TEE_Result ecc_p256_verify(struct ecc_public_key *key, const uint8_t *msg,
+			   size_t msg_len, const uint8_t *sig, size_t sig_len);
+
+TEE_Result ecc_p256_shared_secret(struct ecc_keypair *private_key,
+				  struct ecc_public_key *public_key,
+				  void *secret, unsigned long *secret_len);
+#else
+static inline TEE_Result
+ecc_p256_generate_keypair(struct ecc_keypair *key __unused)
+{
+	return TEE_ERROR_NOT_IMPLEMENTED;
+}
+
+static inline TEE_Result
+ecc_p256_sign(struct ecc_keypair *key __unused, const uint8_t *msg __unused,
+	      size_t msg_len __unused, uint8_t *sig __unused,
+	      size_t *sig_len __unused)
+{
+	return TEE_ERROR_NOT_IMPLEMENTED;
+}
+
+static inline TEE_Result
+ecc_p256_verify(struct ecc_public_key *key __unused,
+		const uint8_t *msg __unused, size_t msg_len __unused,
+		const uint8_t *sig __unused, size_t sig_len __unused)
+{
+	return TEE_ERROR_NOT_IMPLEMENTED;
+}
+
+static inline TEE_Result
+ecc_p256_shared_secret(struct ecc_keypair *private_key __unused,
+		       struct ecc_public_key *public_key __unused,
+		       void *secret __unused, unsigned long *secret_len __unused)
+{
+	return TEE_ERROR_NOT_IMPLEMENTED;
+}
+#endif
 #endif /* ACIPHER_HELPERS_H */
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <assert.h>
+#include <crypto/crypto.h>
+#include <crypto/crypto_impl.h>
+#include <stdlib_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string_ext.h>
+#include <tee_api_types.h>
+#include <tomcrypt_private.h>
+#include <util.h>
+
+#define TEE_CHACHAPOLY_KEY_LENGTH	32
+#define TEE_CHACHAPOLY_NONCE_LENGTH	12
+#define TEE_CHACHAPOLY_TAG_LENGTH	16
+
+struct tee_chachapoly_state {
+	struct crypto_authenc_ctx aectx;
+	chacha20poly1305_state ctx;	/* the state as defined by LTC */
+};
+
+static const struct crypto_authenc_ops chacha20_poly1305_ops;
+
+TEE_Result crypto_chacha20_poly1305_alloc_ctx(struct crypto_authenc_ctx **ret)
+{
+	struct tee_chachapoly_state *ctx = calloc(1, sizeof(*ctx));
+
+	if (!ctx)
+		return TEE_ERROR_OUT_OF_MEMORY;
+	ctx->aectx.ops = &chacha20_poly1305_ops;
+
+	*ret = &ctx->aectx;
+	return TEE_SUCCESS;
+}
+
+static struct tee_chachapoly_state *
+to_tee_chachapoly_state(struct crypto_authenc_ctx *aectx)
+{
+	assert(aectx && aectx->ops == &chacha20_poly1305_ops);
+
+	return container_of(aectx, struct tee_chachapoly_state, aectx);
+}
+
+static void crypto_chacha20_poly1305_free_ctx(struct crypto_authenc_ctx *aectx)
+{
+	free_wipe(to_tee_chachapoly_state(aectx));
+}
+
+static void
+crypto_chacha20_poly1305_copy_state(struct crypto_authenc_ctx *dst_aectx,
+				    struct crypto_authenc_ctx *src_aectx)
+{
+	struct tee_chachapoly_state *dst_ctx =
+		to_tee_chachapoly_state(dst_aectx);
+	struct tee_chachapoly_state *src_ctx =
+		to_tee_chachapoly_state(src_aectx);
+
+	dst_ctx->ctx = src_ctx->ctx;
+}
+
+static TEE_Result
+crypto_chacha20_poly1305_init(struct crypto_authenc_ctx *aectx,
+			      TEE_OperationMode mode __unused,
+			      const uint8_t *key, size_t key_len,
+			      const uint8_t *nonce, size_t nonce_len,
+			      size_t tag_len, size_t aad_len __unused,
+			      size_t payload_len __unused)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+
+	/* reset the state */
+	memset(&cp->ctx, 0, sizeof(cp->ctx));
+
+	if (!key || key_len != TEE_CHACHAPOLY_KEY_LENGTH)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/* Only the 96-bit nonce of RFC 8439 is supported */
+	if (!nonce || nonce_len != TEE_CHACHAPOLY_NONCE_LENGTH)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	if (tag_len != TEE_CHACHAPOLY_TAG_LENGTH)
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	if (chacha20poly1305_init(&cp->ctx, key, key_len) != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+
+	if (chacha20poly1305_setiv(&cp->ctx, nonce, nonce_len) != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result
+crypto_chacha20_poly1305_update_aad(struct crypto_authenc_ctx *aectx,
+				    const uint8_t *data, size_t len)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+
+	if (chacha20poly1305_add_aad(&cp->ctx, data, len) != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result
+crypto_chacha20_poly1305_update_payload(struct crypto_authenc_ctx *aectx,
+					TEE_OperationMode mode,
+					const uint8_t *src_data, size_t len,
+					uint8_t *dst_data)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+	int ltc_res = 0;
+
+	if (mode == TEE_MODE_ENCRYPT)
+		ltc_res = chacha20poly1305_encrypt(&cp->ctx, src_data, len,
+						   dst_data);
+	else
+		ltc_res = chacha20poly1305_decrypt(&cp->ctx, src_data, len,
+						   dst_data);
+	if (ltc_res != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result
+crypto_chacha20_poly1305_enc_final(struct crypto_authenc_ctx *aectx,
+				   const uint8_t *src_data, size_t len,
+				   uint8_t *dst_data, uint8_t *dst_tag,
+				   size_t *dst_tag_len)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+	unsigned long ltc_tag_len = TEE_CHACHAPOLY_TAG_LENGTH;
+	TEE_Result res = TEE_SUCCESS;
+
+	/*
+	 * Finalize the remaining buffer. This must be done even if @len
+	 * is 0 since it pads the AAD, chacha20poly1305_done() only pads
+	 * the ciphertext.
+	 */
+	res = crypto_chacha20_poly1305_update_payload(aectx, TEE_MODE_ENCRYPT,
+						      src_data, len, dst_data);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	/* Check the tag length */
+	if (*dst_tag_len < TEE_CHACHAPOLY_TAG_LENGTH) {
+		*dst_tag_len = TEE_CHACHAPOLY_TAG_LENGTH;
+		return TEE_ERROR_SHORT_BUFFER;
+	}
+
+	/* Compute the tag */
+	if (chacha20poly1305_done(&cp->ctx, dst_tag, &ltc_tag_len) != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+	*dst_tag_len = ltc_tag_len;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result
+crypto_chacha20_poly1305_dec_final(struct crypto_authenc_ctx *aectx,
+				   const uint8_t *src_data, size_t len,
+				   uint8_t *dst_data, const uint8_t *tag,
+				   size_t tag_len)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+	uint8_t dst_tag[TEE_CHACHAPOLY_TAG_LENGTH] = { 0 };
+	unsigned long ltc_tag_len = sizeof(dst_tag);
+	TEE_Result res = TEE_ERROR_BAD_STATE;
+
+	if (tag_len == 0)
+		return TEE_ERROR_SHORT_BUFFER;
+	if (tag_len != TEE_CHACHAPOLY_TAG_LENGTH)
+		return TEE_ERROR_MAC_INVALID;
+
+	/* Process the last buffer, if any, also pads the AAD */
+	res = crypto_chacha20_poly1305_update_payload(aectx, TEE_MODE_DECRYPT,
+						      src_data, len, dst_data);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	/* Finalize the authentication */
+	if (chacha20poly1305_done(&cp->ctx, dst_tag, &ltc_tag_len) != CRYPT_OK)
+		return TEE_ERROR_BAD_STATE;
+
+	if (consttime_memcmp(dst_tag, tag, tag_len) != 0)
+		res = TEE_ERROR_MAC_INVALID;
+	else
+		res = TEE_SUCCESS;
+	return res;
+}
+
+static void crypto_chacha20_poly1305_final(struct crypto_authenc_ctx *aectx)
+{
+	struct tee_chachapoly_state *cp = to_tee_chachapoly_state(aectx);
+
+	memzero_explicit(&cp->ctx, sizeof(cp->ctx));
+}
+
+static const struct crypto_authenc_ops chacha20_poly1305_ops = {
+	.init = crypto_chacha20_poly1305_init,
+	.update_aad = crypto_chacha20_poly1305_update_aad,
+	.update_payload = crypto_chacha20_poly1305_update_payload,
+	.enc_final = crypto_chacha20_poly1305_enc_final,
+	.dec_final = crypto_chacha20_poly1305_dec_final,
+	.final = crypto_chacha20_poly1305_final,
+	.free_ctx = crypto_chacha20_poly1305_free_ctx,
+	.copy_state = crypto_chacha20_poly1305_copy_state,
+};
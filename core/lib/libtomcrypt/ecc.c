@@ -5,6 +5,7 @@
 
 #include <config.h>
 #include <crypto/crypto_impl.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <tee_api_types.h>
@@ -114,6 +115,16 @@ static TEE_Result ecc_get_curve_info(uint32_t curve, uint32_t algo,
 	return TEE_SUCCESS;
 }
 
+/*
+ * P-256 ECDSA and ECDH use the dedicated fixed size implementation in
+ * ecc_p256.c when it's enabled, other curves use LTC.
+ */
+static bool ecc_use_p256(uint32_t curve)
+{
+	return IS_ENABLED(_CFG_CORE_LTC_ECC_P256) &&
+	       curve == TEE_ECC_CURVE_NIST_P256;
+}
+
 static TEE_Result _ltc_ecc_generate_keypair(struct ecc_keypair *key,
 					    size_t key_size)
 {
@@ -131,6 +142,9 @@ static TEE_Result _ltc_ecc_generate_keypair(struct ecc_keypair *key,
 	if (key_size != key_size_bits)
 		return TEE_ERROR_BAD_PARAMETERS;
 
+	if (ecc_use_p256(key->curve))
+		return ecc_p256_generate_keypair(key);
+
 	/* Generate the ECC key */
 	ltc_res = ecc_make_key(NULL, find_prng("prng_crypto"),
 			       key_size_bytes, &ltc_tmp_key);
@@ -255,6 +269,13 @@ static TEE_Result _ltc_ecc_sign(uint32_t algo, struct ecc_keypair *key,
 	if (algo == 0)
 		return TEE_ERROR_BAD_PARAMETERS;
 
+	if (ecc_use_p256(key->curve)) {
+		res = ecc_get_curve_info(key->curve, algo, NULL, NULL, NULL);
+		if (res)
+			return res;
+		return ecc_p256_sign(key, msg, msg_len, sig, sig_len);
+	}
+
 	res = ecc_populate_ltc_private_key(&ltc_key, key, algo,
 					   &key_size_bytes);
 	if (res != TEE_SUCCESS)
@@ -294,6 +315,13 @@ static TEE_Result _ltc_ecc_verify(uint32_t algo, struct ecc_public_key *key,
 	if (algo == 0)
 		return TEE_ERROR_BAD_PARAMETERS;
 
+	if (ecc_use_p256(key->curve)) {
+		res = ecc_get_curve_info(key->curve, algo, NULL, NULL, NULL);
+		if (res)
+			return res;
+		return ecc_p256_verify(key, msg, msg_len, sig, sig_len);
+	}
+
 	res = ecc_populate_ltc_public_key(&ltc_key, key, algo, &key_size_bytes);
 	if (res != TEE_SUCCESS)
 		goto out;
@@ -327,6 +355,10 @@ static TEE_Result _ltc_ecc_shared_secret(struct ecc_keypair *private_key,
 	if (private_key->curve != public_key->curve)
 		return TEE_ERROR_BAD_PARAMETERS;
 
+	if (ecc_use_p256(private_key->curve))
+		return ecc_p256_shared_secret(private_key, public_key, secret,
+					      secret_len);
+
 	res = ecc_populate_ltc_private_key(&ltc_private_key, private_key,
 					   0, &key_size_bytes);
 	if (res != TEE_SUCCESS)
@@ -0,0 +1,795 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <crypto/crypto.h>
+#include <stdbool.h>
+#include <string.h>
+#include <string_ext.h>
+#include <tee_api_types.h>
+#include <types_ext.h>
+#include <utee_defines.h>
+#include <util.h>
+
+#include "acipher_helpers.h"
+
+/*
+ * Dedicated NIST P-256 arithmetic used for ECDSA and ECDH instead of the
+ * generic LibTomCrypt point code on top of variable size bignums.
+ *
+ * Field elements and scalars are fixed arrays of 8 32-bit limbs, least
+ * significant limb first, kept in Montgomery form modulo p or n. All
+ * values live on the stack, there's no heap allocation after the key
+ * material has been read from the bignums.
+ *
+ * Points use homogeneous projective coordinates with the complete
+ * addition and doubling formulas for a = -3 by Renes, Costello and
+ * Batina ("Complete addition formulas for prime order elliptic curves",
+ * algorithms 4 and 6). The formulas have no exceptional cases, the
+ * point at infinity (0:1:0) included, so point multiplication is a
+ * fixed sequence of field operations. Table lookups scan the whole
+ * table and conditional moves use masks, nothing branches on or
+ * indexes memory with secret data.
+ */
+
+#define P256_LIMBS	8
+#define P256_BYTES	32
+
+struct p256_mod {
+	const uint32_t *m;
+	const uint32_t *rr;	/* 2^512 mod m */
+	uint32_t m0inv;		/* -m^-1 mod 2^32 */
+};
+
+struct p256_point {
+	uint32_t x[P256_LIMBS];
+	uint32_t y[P256_LIMBS];
+	uint32_t z[P256_LIMBS];
+};
+
+static const uint32_t p256_p[P256_LIMBS] = {
+	0xffffffff, 0xffffffff, 0xffffffff, 0x00000000,
+	0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+static const uint32_t p256_rr_p[P256_LIMBS] = {
+	0x00000003, 0x00000000, 0xffffffff, 0xfffffffb,
+	0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004
+};
+
+static const uint32_t p256_n[P256_LIMBS] = {
+	0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad,
+	0xffffffff, 0xffffffff, 0x00000000, 0xffffffff
+};
+
+static const uint32_t p256_rr_n[P256_LIMBS] = {
+	0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c,
+	0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94
+};
+
+/* Curve constant b and the generator, Montgomery form modulo p */
+static const uint32_t p256_b_mont[P256_LIMBS] = {
+	0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd,
+	0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d
+};
+
+static const uint32_t p256_gx_mont[P256_LIMBS] = {
+	0x18a9143c, 0x79e730d4, 0x5fedb601, 0x75ba95fc,
+	0x77622510, 0x79fb732b, 0xa53755c6, 0x18905f76
+};
+
+static const uint32_t p256_gy_mont[P256_LIMBS] = {
+	0xce95560a, 0xddf25357, 0xba19e45c, 0x8b4ab8e4,
+	0xdd21f325, 0xd2e88688, 0x25885d85, 0x8571ff18
+};
+
+static const uint32_t p256_one_mont[P256_LIMBS] = {
+	0x00000001, 0x00000000, 0x00000000, 0xffffffff,
+	0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000
+};
+
+static const struct p256_mod p256_fp = {
+	.m = p256_p, .rr = p256_rr_p, .m0inv = 0x00000001,
+};
+
+static const struct p256_mod p256_fn = {
+	.m = p256_n, .rr = p256_rr_n, .m0inv = 0xee00bc4f,
+};
+
+/* r = a + b, returns the carry */
+static uint32_t p256_add_raw(uint32_t *r, const uint32_t *a,
+			     const uint32_t *b)
+{
+	uint64_t t = 0;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++) {
+		t += (uint64_t)a[i] + b[i];
+		r[i] = t;
+		t >>= 32;
+	}
+
+	return t;
+}
+
+/* r = a - b, returns the borrow */
+static uint32_t p256_sub_raw(uint32_t *r, const uint32_t *a,
+			     const uint32_t *b)
+{
+	uint32_t borrow = 0;
+	uint64_t t = 0;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++) {
+		t = (uint64_t)a[i] - b[i] - borrow;
+		r[i] = t;
+		borrow = (t >> 32) & 1;
+	}
+
+	return borrow;
+}
+
+/* r = a if @cond is 1, r unchanged if @cond is 0 */
+static void p256_cmov(uint32_t *r, const uint32_t *a, uint32_t cond)
+{
+	uint32_t mask = 0 - cond;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++)
+		r[i] = (r[i] & ~mask) | (a[i] & mask);
+}
+
+/* Returns 1 if a == 0, 0 otherwise */
+static uint32_t p256_is_zero(const uint32_t *a)
+{
+	uint32_t v = 0;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++)
+		v |= a[i];
+
+	return ((v | (0 - v)) >> 31) ^ 1;
+}
+
+/* Returns 1 if a < m, 0 otherwise */
+static uint32_t p256_lt(const uint32_t *a, const uint32_t *m)
+{
+	uint32_t t[P256_LIMBS] = { };
+
+	return p256_sub_raw(t, a, m);
+}
+
+/* r = a mod m for a < 2m */
+static void p256_reduce_once(uint32_t *r, const uint32_t *a,
+			     const struct p256_mod *m)
+{
+	uint32_t t[P256_LIMBS] = { };
+	uint32_t borrow = p256_sub_raw(t, a, m->m);
+
+	memcpy(r, a, sizeof(t));
+	p256_cmov(r, t, borrow ^ 1);
+}
+
+/* r = a + b mod m, a and b < m */
+static void p256_mod_add(uint32_t *r, const uint32_t *a, const uint32_t *b,
+			 const struct p256_mod *m)
+{
+	uint32_t t[P256_LIMBS] = { };
+	uint32_t carry = p256_add_raw(r, a, b);
+	uint32_t borrow = p256_sub_raw(t, r, m->m);
+
+	p256_cmov(r, t, carry | (borrow ^ 1));
+}
+
+/* r = a - b mod m, a and b < m */
+static void p256_mod_sub(uint32_t *r, const uint32_t *a, const uint32_t *b,
+			 const struct p256_mod *m)
+{
+	uint32_t t[P256_LIMBS] = { };
+	uint32_t borrow = p256_sub_raw(r, a, b);
+
+	p256_add_raw(t, r, m->m);
+	p256_cmov(r, t, borrow);
+}
+
+/* r = a * b / 2^256 mod m, word by word Montgomery multiplication (CIOS) */
+static void p256_mont_mul(uint32_t *r, const uint32_t *a, const uint32_t *b,
+			  const struct p256_mod *m)
+{
+	uint32_t t[P256_LIMBS + 2] = { };
+	uint32_t u = 0;
+	uint64_t c = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	for (i = 0; i < P256_LIMBS; i++) {
+		c = 0;
+		for (j = 0; j < P256_LIMBS; j++) {
+			c += (uint64_t)a[j] * b[i] + t[j];
+			t[j] = c;
+			c >>= 32;
+		}
+		c += t[P256_LIMBS];
+		t[P256_LIMBS] = c;
+		t[P256_LIMBS + 1] = c >> 32;
+
+		u = t[0] * m->m0inv;
+		c = ((uint64_t)u * m->m[0] + t[0]) >> 32;
+		for (j = 1; j < P256_LIMBS; j++) {
+			c += (uint64_t)u * m->m[j] + t[j];
+			t[j - 1] = c;
+			c >>= 32;
+		}
+		c += t[P256_LIMBS];
+		t[P256_LIMBS - 1] = c;
+		t[P256_LIMBS] = t[P256_LIMBS + 1] + (c >> 32);
+	}
+
+	/* t < 2m, subtract m once if t >= m */
+	p256_sub_raw(r, t, m->m);
+	p256_cmov(t, r, t[P256_LIMBS] | (p256_lt(t, m->m) ^ 1));
+	memcpy(r, t, P256_LIMBS * sizeof(uint32_t));
+}
+
+static void p256_to_mont(uint32_t *r, const uint32_t *a,
+			 const struct p256_mod *m)
+{
+	p256_mont_mul(r, a, m->rr, m);
+}
+
+static void p256_from_mont(uint32_t *r, const uint32_t *a,
+			   const struct p256_mod *m)
+{
+	static const uint32_t one[P256_LIMBS] = { 1 };
+
+	p256_mont_mul(r, a, one, m);
+}
+
+/*
+ * r = a^(m - 2) = a^-1 mod m, Montgomery form in and out. The exponent
+ * is public, so is the sequence of squarings and multiplications.
+ */
+static void p256_mont_inv(uint32_t *r, const uint32_t *a,
+			  const struct p256_mod *m)
+{
+	static const uint32_t two[P256_LIMBS] = { 2 };
+	uint32_t e[P256_LIMBS] = { };
+	uint32_t t[P256_LIMBS] = { };
+	int i = 0;
+
+	p256_sub_raw(e, m->m, two);
+
+	/* Bit 255 of both p - 2 and n - 2 is set */
+	memcpy(t, a, sizeof(t));
+	for (i = 254; i >= 0; i--) {
+		p256_mont_mul(t, t, t, m);
+		if ((e[i / 32] >> (i % 32)) & 1)
+			p256_mont_mul(t, t, a, m);
+	}
+
+	memcpy(r, t, sizeof(t));
+}
+
+static void p256_fe_add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	p256_mod_add(r, a, b, &p256_fp);
+}
+
+static void p256_fe_sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	p256_mod_sub(r, a, b, &p256_fp);
+}
+
+static void p256_fe_mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	p256_mont_mul(r, a, b, &p256_fp);
+}
+
+static void p256_point_set_infinity(struct p256_point *p)
+{
+	memset(p, 0, sizeof(*p));
+	memcpy(p->y, p256_one_mont, sizeof(p->y));
+}
+
+static void p256_point_set_generator(struct p256_point *p)
+{
+	memcpy(p->x, p256_gx_mont, sizeof(p->x));
+	memcpy(p->y, p256_gy_mont, sizeof(p->y));
+	memcpy(p->z, p256_one_mont, sizeof(p->z));
+}
+
+/* r = p + q, complete formula (algorithm 4), r may alias p or q */
+static void p256_point_add(struct p256_point *r, const struct p256_point *p,
+			   const struct p256_point *q)
+{
+	uint32_t t0[P256_LIMBS] = { };
+	uint32_t t1[P256_LIMBS] = { };
+	uint32_t t2[P256_LIMBS] = { };
+	uint32_t t3[P256_LIMBS] = { };
+	uint32_t t4[P256_LIMBS] = { };
+	uint32_t x3[P256_LIMBS] = { };
+	uint32_t y3[P256_LIMBS] = { };
+	uint32_t z3[P256_LIMBS] = { };
+
+	p256_fe_mul(t0, p->x, q->x);
+	p256_fe_mul(t1, p->y, q->y);
+	p256_fe_mul(t2, p->z, q->z);
+	p256_fe_add(t3, p->x, p->y);
+	p256_fe_add(t4, q->x, q->y);
+	p256_fe_mul(t3, t3, t4);
+	p256_fe_add(t4, t0, t1);
+	p256_fe_sub(t3, t3, t4);
+	p256_fe_add(t4, p->y, p->z);
+	p256_fe_add(x3, q->y, q->z);
+	p256_fe_mul(t4, t4, x3);
+	p256_fe_add(x3, t1, t2);
+	p256_fe_sub(t4, t4, x3);
+	p256_fe_add(x3, p->x, p->z);
+	p256_fe_add(y3, q->x, q->z);
+	p256_fe_mul(x3, x3, y3);
+	p256_fe_add(y3, t0, t2);
+	p256_fe_sub(y3, x3, y3);
+	p256_fe_mul(z3, p256_b_mont, t2);
+	p256_fe_sub(x3, y3, z3);
+	p256_fe_add(z3, x3, x3);
+	p256_fe_add(x3, x3, z3);
+	p256_fe_sub(z3, t1, x3);
+	p256_fe_add(x3, t1, x3);
+	p256_fe_mul(y3, p256_b_mont, y3);
+	p256_fe_add(t1, t2, t2);
+	p256_fe_add(t2, t1, t2);
+	p256_fe_sub(y3, y3, t2);
+	p256_fe_sub(y3, y3, t0);
+	p256_fe_add(t1, y3, y3);
+	p256_fe_add(y3, t1, y3);
+	p256_fe_add(t1, t0, t0);
+	p256_fe_add(t0, t1, t0);
+	p256_fe_sub(t0, t0, t2);
+	p256_fe_mul(t1, t4, y3);
+	p256_fe_mul(t2, t0, y3);
+	p256_fe_mul(y3, x3, z3);
+	p256_fe_add(y3, y3, t2);
+	p256_fe_mul(x3, t3, x3);
+	p256_fe_sub(x3, x3, t1);
+	p256_fe_mul(z3, t4, z3);
+	p256_fe_mul(t1, t3, t0);
+	p256_fe_add(z3, z3, t1);
+
+	memcpy(r->x, x3, sizeof(x3));
+	memcpy(r->y, y3, sizeof(y3));
+	memcpy(r->z, z3, sizeof(z3));
+}
+
+/* r = 2p, complete formula (algorithm 6), r may alias p */
+static void p256_point_dbl(struct p256_point *r, const struct p256_point *p)
+{
+	uint32_t t0[P256_LIMBS] = { };
+	uint32_t t1[P256_LIMBS] = { };
+	uint32_t t2[P256_LIMBS] = { };
+	uint32_t t3[P256_LIMBS] = { };
+	uint32_t x3[P256_LIMBS] = { };
+	uint32_t y3[P256_LIMBS] = { };
+	uint32_t z3[P256_LIMBS] = { };
+
+	p256_fe_mul(t0, p->x, p->x);
+	p256_fe_mul(t1, p->y, p->y);
+	p256_fe_mul(t2, p->z, p->z);
+	p256_fe_mul(t3, p->x, p->y);
+	p256_fe_add(t3, t3, t3);
+	p256_fe_mul(z3, p->x, p->z);
+	p256_fe_add(z3, z3, z3);
+	p256_fe_mul(y3, p256_b_mont, t2);
+	p256_fe_sub(y3, y3, z3);
+	p256_fe_add(x3, y3, y3);
+	p256_fe_add(y3, x3, y3);
+	p256_fe_sub(x3, t1, y3);
+	p256_fe_add(y3, t1, y3);
+	p256_fe_mul(y3, x3, y3);
+	p256_fe_mul(x3, x3, t3);
+	p256_fe_add(t3, t2, t2);
+	p256_fe_add(t2, t2, t3);
+	p256_fe_mul(z3, p256_b_mont, z3);
+	p256_fe_sub(z3, z3, t2);
+	p256_fe_sub(z3, z3, t0);
+	p256_fe_add(t3, z3, z3);
+	p256_fe_add(z3, z3, t3);
+	p256_fe_add(t3, t0, t0);
+	p256_fe_add(t0, t3, t0);
+	p256_fe_sub(t0, t0, t2);
+	p256_fe_mul(t0, t0, z3);
+	p256_fe_add(y3, y3, t0);
+	p256_fe_mul(t0, p->y, p->z);
+	p256_fe_add(t0, t0, t0);
+	p256_fe_mul(z3, t0, z3);
+	p256_fe_sub(x3, x3, z3);
+	p256_fe_mul(z3, t0, t1);
+	p256_fe_add(z3, z3, z3);
+	p256_fe_add(z3, z3, z3);
+
+	memcpy(r->x, x3, sizeof(x3));
+	memcpy(r->y, y3, sizeof(y3));
+	memcpy(r->z, z3, sizeof(z3));
+}
+
+/* r = table[idx], reading every entry of the table */
+static void p256_point_select(struct p256_point *r,
+			      const struct p256_point *table, size_t count,
+			      uint32_t idx)
+{
+	uint32_t v = 0;
+	size_t i = 0;
+
+	memset(r, 0, sizeof(*r));
+	for (i = 0; i < count; i++) {
+		v = i ^ idx;
+		v = ((v | (0 - v)) >> 31) ^ 1;
+		p256_cmov(r->x, table[i].x, v);
+		p256_cmov(r->y, table[i].y, v);
+		p256_cmov(r->z, table[i].z, v);
+	}
+}
+
+/*
+ * r = k * p with k a 32-byte big endian scalar, fixed 4-bit window: 64
+ * iterations of 4 doublings, a full table scan and an addition.
+ */
+static void p256_point_mul(struct p256_point *r, const uint8_t *k,
+			   const struct p256_point *p)
+{
+	struct p256_point table[16] = { };
+	struct p256_point acc = { };
+	struct p256_point t = { };
+	uint32_t nibble = 0;
+	size_t i = 0;
+
+	p256_point_set_infinity(table);
+	table[1] = *p;
+	for (i = 2; i < ARRAY_SIZE(table); i++) {
+		if (i & 1)
+			p256_point_add(table + i, table + i - 1, p);
+		else
+			p256_point_dbl(table + i, table + i / 2);
+	}
+
+	p256_point_set_infinity(&acc);
+	for (i = 0; i < 2 * P256_BYTES; i++) {
+		nibble = (k[i / 2] >> (i & 1 ? 0 : 4)) & 0xf;
+		p256_point_dbl(&acc, &acc);
+		p256_point_dbl(&acc, &acc);
+		p256_point_dbl(&acc, &acc);
+		p256_point_dbl(&acc, &acc);
+		p256_point_select(&t, table, ARRAY_SIZE(table), nibble);
+		p256_point_add(&acc, &acc, &t);
+	}
+
+	*r = acc;
+	memzero_explicit(&acc, sizeof(acc));
+	memzero_explicit(&t, sizeof(t));
+	memzero_explicit(table, sizeof(table));
+}
+
+static void p256_from_bytes(uint32_t *r, const uint8_t *b)
+{
+	const uint8_t *w = NULL;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++) {
+		w = b + P256_BYTES - 4 * (i + 1);
+		r[i] = ((uint32_t)w[0] << 24) | ((uint32_t)w[1] << 16) |
+		       ((uint32_t)w[2] << 8) | w[3];
+	}
+}
+
+static void p256_to_bytes(uint8_t *b, const uint32_t *a)
+{
+	uint8_t *w = NULL;
+	size_t i = 0;
+
+	for (i = 0; i < P256_LIMBS; i++) {
+		w = b + P256_BYTES - 4 * (i + 1);
+		w[0] = a[i] >> 24;
+		w[1] = a[i] >> 16;
+		w[2] = a[i] >> 8;
+		w[3] = a[i];
+	}
+}
+
+/*
+ * Affine x and y in normal form, modulo p. Returns false for the point at
+ * infinity.
+ */
+static bool p256_point_to_affine(uint32_t *x, uint32_t *y,
+				 const struct p256_point *p)
+{
+	uint32_t zinv[P256_LIMBS] = { };
+
+	if (p256_is_zero(p->z))
+		return false;
+
+	p256_mont_inv(zinv, p->z, &p256_fp);
+	p256_fe_mul(x, p->x, zinv);
+	p256_from_mont(x, x, &p256_fp);
+	if (y) {
+		p256_fe_mul(y, p->y, zinv);
+		p256_from_mont(y, y, &p256_fp);
+	}
+
+	return true;
+}
+
+/* Loads and validates a public point, y^2 = x^3 - 3x + b */
+static TEE_Result p256_point_from_bn(struct p256_point *p,
+				     struct bignum *bx, struct bignum *by)
+{
+	uint32_t lhs[P256_LIMBS] = { };
+	uint32_t rhs[P256_LIMBS] = { };
+	uint8_t buf[P256_BYTES] = { };
+
+	if (crypto_bignum_num_bytes(bx) > P256_BYTES ||
+	    crypto_bignum_num_bytes(by) > P256_BYTES)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	crypto_bignum_bn2bin(bx, buf + P256_BYTES -
+				 crypto_bignum_num_bytes(bx));
+	p256_from_bytes(p->x, buf);
+	memset(buf, 0, sizeof(buf));
+	crypto_bignum_bn2bin(by, buf + P256_BYTES -
+				 crypto_bignum_num_bytes(by));
+	p256_from_bytes(p->y, buf);
+	if (!p256_lt(p->x, p256_p) || !p256_lt(p->y, p256_p))
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	p256_to_mont(p->x, p->x, &p256_fp);
+	p256_to_mont(p->y, p->y, &p256_fp);
+	memcpy(p->z, p256_one_mont, sizeof(p->z));
+
+	p256_fe_mul(lhs, p->y, p->y);
+	p256_fe_mul(rhs, p->x, p->x);
+	p256_fe_mul(rhs, rhs, p->x);
+	p256_fe_sub(rhs, rhs, p->x);
+	p256_fe_sub(rhs, rhs, p->x);
+	p256_fe_sub(rhs, rhs, p->x);
+	p256_fe_add(rhs, rhs, p256_b_mont);
+	p256_fe_sub(lhs, lhs, rhs);
+	if (!p256_is_zero(lhs))
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	return TEE_SUCCESS;
+}
+
+/* Loads a private scalar, which must be in [1, n - 1] */
+static TEE_Result p256_scalar_from_bn(uint8_t *k, struct bignum *bn)
+{
+	uint32_t t[P256_LIMBS] = { };
+	size_t len = crypto_bignum_num_bytes(bn);
+	TEE_Result res = TEE_SUCCESS;
+
+	if (len > P256_BYTES)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	memset(k, 0, P256_BYTES);
+	crypto_bignum_bn2bin(bn, k + P256_BYTES - len);
+	p256_from_bytes(t, k);
+	if (p256_is_zero(t) || !p256_lt(t, p256_n))
+		res = TEE_ERROR_BAD_PARAMETERS;
+
+	memzero_explicit(t, sizeof(t));
+	return res;
+}
+
+/* Random scalar in [1, n - 1] by rejection sampling */
+static TEE_Result p256_scalar_random(uint8_t *k)
+{
+	uint32_t t[P256_LIMBS] = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	do {
+		res = crypto_rng_read(k, P256_BYTES);
+		if (res)
+			break;
+		p256_from_bytes(t, k);
+	} while (p256_is_zero(t) || !p256_lt(t, p256_n));
+
+	memzero_explicit(t, sizeof(t));
+	return res;
+}
+
+/*
+ * The digest as an integer modulo n. Longer digests are truncated to
+ * their leftmost 256 bits, like ecc_sign_hash() does.
+ */
+static void p256_digest_to_scalar(uint32_t *e, const uint8_t *msg,
+				  size_t msg_len)
+{
+	uint8_t buf[P256_BYTES] = { };
+
+	if (msg_len >= P256_BYTES)
+		memcpy(buf, msg, P256_BYTES);
+	else
+		memcpy(buf + P256_BYTES - msg_len, msg, msg_len);
+	p256_from_bytes(e, buf);
+	p256_reduce_once(e, e, &p256_fn);
+}
+
+static TEE_Result p256_to_bn(struct bignum *bn, const uint32_t *a)
+{
+	uint8_t buf[P256_BYTES] = { };
+
+	p256_to_bytes(buf, a);
+	return crypto_bignum_bin2bn(buf, sizeof(buf), bn);
+}
+
+TEE_Result ecc_p256_generate_keypair(struct ecc_keypair *key)
+{
+	uint32_t x[P256_LIMBS] = { };
+	uint32_t y[P256_LIMBS] = { };
+	struct p256_point g = { };
+	struct p256_point q = { };
+	uint8_t d[P256_BYTES] = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	res = p256_scalar_random(d);
+	if (res)
+		goto out;
+
+	p256_point_set_generator(&g);
+	p256_point_mul(&q, d, &g);
+	p256_point_to_affine(x, y, &q);
+
+	res = crypto_bignum_bin2bn(d, sizeof(d), key->d);
+	if (!res)
+		res = p256_to_bn(key->x, x);
+	if (!res)
+		res = p256_to_bn(key->y, y);
+out:
+	memzero_explicit(d, sizeof(d));
+	return res;
+}
+
+TEE_Result ecc_p256_sign(struct ecc_keypair *key, const uint8_t *msg,
+			 size_t msg_len, uint8_t *sig, size_t *sig_len)
+{
+	uint32_t kinv[P256_LIMBS] = { };
+	uint32_t e[P256_LIMBS] = { };
+	uint32_t d[P256_LIMBS] = { };
+	uint32_t r[P256_LIMBS] = { };
+	uint32_t s[P256_LIMBS] = { };
+	uint32_t t[P256_LIMBS] = { };
+	uint8_t k[P256_BYTES] = { };
+	struct p256_point g = { };
+	struct p256_point p = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	if (*sig_len < 2 * P256_BYTES) {
+		*sig_len = 2 * P256_BYTES;
+		return TEE_ERROR_SHORT_BUFFER;
+	}
+
+	res = p256_scalar_from_bn(k, key->d);
+	if (res)
+		goto out;
+	p256_from_bytes(d, k);
+	p256_to_mont(d, d, &p256_fn);
+
+	p256_digest_to_scalar(e, msg, msg_len);
+	p256_to_mont(e, e, &p256_fn);
+
+	p256_point_set_generator(&g);
+	do {
+		res = p256_scalar_random(k);
+		if (res)
+			goto out;
+
+		/* r = x(kG) mod n, x < p < 2n */
+		p256_point_mul(&p, k, &g);
+		p256_point_to_affine(r, NULL, &p);
+		p256_reduce_once(r, r, &p256_fn);
+		if (p256_is_zero(r))
+			continue;
+
+		/* s = k^-1 (e + r * d) mod n */
+		p256_from_bytes(kinv, k);
+		p256_to_mont(kinv, kinv, &p256_fn);
+		p256_mont_inv(kinv, kinv, &p256_fn);
+		p256_to_mont(t, r, &p256_fn);
+		p256_mont_mul(t, t, d, &p256_fn);
+		p256_mod_add(t, t, e, &p256_fn);
+		p256_mont_mul(s, kinv, t, &p256_fn);
+		p256_from_mont(s, s, &p256_fn);
+	} while (p256_is_zero(r) || p256_is_zero(s));
+
+	p256_to_bytes(sig, r);
+	p256_to_bytes(sig + P256_BYTES, s);
+	*sig_len = 2 * P256_BYTES;
+out:
+	memzero_explicit(k, sizeof(k));
+	memzero_explicit(d, sizeof(d));
+	memzero_explicit(kinv, sizeof(kinv));
+	memzero_explicit(t, sizeof(t));
+	memzero_explicit(&p, sizeof(p));
+	return res;
+}
+
+TEE_Result ecc_p256_verify(struct ecc_public_key *key, const uint8_t *msg,
+			   size_t msg_len, const uint8_t *sig, size_t sig_len)
+{
+	uint32_t w[P256_LIMBS] = { };
+	uint32_t e[P256_LIMBS] = { };
+	uint32_t r[P256_LIMBS] = { };
+	uint32_t s[P256_LIMBS] = { };
+	uint32_t x[P256_LIMBS] = { };
+	uint8_t u1[P256_BYTES] = { };
+	uint8_t u2[P256_BYTES] = { };
+	struct p256_point q = { };
+	struct p256_point g = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	if (sig_len != 2 * P256_BYTES)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	res = p256_point_from_bn(&q, key->x, key->y);
+	if (res)
+		return res;
+
+	p256_from_bytes(r, sig);
+	p256_from_bytes(s, sig + P256_BYTES);
+	if (p256_is_zero(r) || !p256_lt(r, p256_n) ||
+	    p256_is_zero(s) || !p256_lt(s, p256_n))
+		return TEE_ERROR_SIGNATURE_INVALID;
+
+	/* u1 = e / s mod n, u2 = r / s mod n */
+	p256_to_mont(w, s, &p256_fn);
+	p256_mont_inv(w, w, &p256_fn);
+	p256_digest_to_scalar(e, msg, msg_len);
+	p256_mont_mul(x, e, w, &p256_fn);
+	p256_to_bytes(u1, x);
+	p256_mont_mul(x, r, w, &p256_fn);
+	p256_to_bytes(u2, x);
+
+	/* R = u1 G + u2 Q, valid if x(R) mod n == r */
+	p256_point_set_generator(&g);
+	p256_point_mul(&g, u1, &g);
+	p256_point_mul(&q, u2, &q);
+	p256_point_add(&g, &g, &q);
+	if (!p256_point_to_affine(x, NULL, &g))
+		return TEE_ERROR_SIGNATURE_INVALID;
+	p256_reduce_once(x, x, &p256_fn);
+
+	if (memcmp(x, r, sizeof(x)))
+		return TEE_ERROR_SIGNATURE_INVALID;
+
+	return TEE_SUCCESS;
+}
+
+TEE_Result ecc_p256_shared_secret(struct ecc_keypair *private_key,
+				  struct ecc_public_key *public_key,
+				  void *secret, unsigned long *secret_len)
+{
+	uint32_t x[P256_LIMBS] = { };
+	uint8_t d[P256_BYTES] = { };
+	struct p256_point q = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	if (*secret_len < P256_BYTES)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	res = p256_point_from_bn(&q, public_key->x, public_key->y);
+	if (res)
+		return res;
+
+	res = p256_scalar_from_bn(d, private_key->d);
+	if (res)
+		goto out;
+
+	/* Q has prime order n and d is in [1, n - 1], dQ isn't infinity */
+	p256_point_mul(&q, d, &q);
+	p256_point_to_affine(x, NULL, &q);
+	p256_to_bytes(secret, x);
+	*secret_len = P256_BYTES;
+out:
+	memzero_explicit(d, sizeof(d));
+	memzero_explicit(x, sizeof(x));
+	memzero_explicit(&q, sizeof(q));
+	return res;
+}
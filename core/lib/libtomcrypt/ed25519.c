@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <crypto/crypto.h>
+#include <stdbool.h>
+#include <string_ext.h>
+#include <tee_api_types.h>
+#include <tomcrypt_private.h>
+
+#define ED25519_KEY_SIZE_BITS	256
+#define ED25519_SIG_SIZE	64
+
+/* Order of the base point, little endian */
+static const uint8_t ed25519_l[32] = {
+	0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+	0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+/*
+ * RFC 8032 requires S < L. LibTomCrypt doesn't check it, which would
+ * leave signatures malleable. The signature is public so the comparison
+ * doesn't need to be constant time.
+ */
+static bool ed25519_s_is_canonical(const uint8_t *s)
+{
+	int i = 0;
+
+	for (i = sizeof(ed25519_l) - 1; i >= 0; i--) {
+		if (s[i] < ed25519_l[i])
+			return true;
+		if (s[i] > ed25519_l[i])
+			return false;
+	}
+
+	return false;
+}
+
+TEE_Result crypto_acipher_gen_ed25519_key(struct ed25519_keypair *key,
+					  size_t key_size)
+{
+	curve25519_key ltc_key = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	if (key_size != ED25519_KEY_SIZE_BITS)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/* The private key is a random 32-byte seed (RFC 8032 5.1.5) */
+	res = crypto_rng_read(key->priv, sizeof(key->priv));
+	if (res)
+		return res;
+
+	if (ed25519_set_key(key->priv, sizeof(key->priv), NULL, 0,
+			    &ltc_key) != CRYPT_OK) {
+		res = TEE_ERROR_BAD_PARAMETERS;
+		goto out;
+	}
+	memcpy(key->pub, ltc_key.pub, sizeof(key->pub));
+out:
+	memzero_explicit(&ltc_key, sizeof(ltc_key));
+	return res;
+}
+
+TEE_Result crypto_acipher_ed25519_sign(struct ed25519_keypair *key,
+				       const uint8_t *msg, size_t msg_len,
+				       uint8_t *sig, size_t *sig_len)
+{
+	curve25519_key ltc_key = {
+		.type = PK_PRIVATE,
+		.algo = PKA_ED25519,
+	};
+	unsigned long ltc_sig_len = 0;
+	TEE_Result res = TEE_SUCCESS;
+	int ltc_res = 0;
+
+	if (*sig_len < ED25519_SIG_SIZE) {
+		*sig_len = ED25519_SIG_SIZE;
+		return TEE_ERROR_SHORT_BUFFER;
+	}
+
+	memcpy(ltc_key.priv, key->priv, sizeof(ltc_key.priv));
+	memcpy(ltc_key.pub, key->pub, sizeof(ltc_key.pub));
+
+	/* LTC rejects a NULL message even when it is empty */
+	ltc_sig_len = *sig_len;
+	ltc_res = ed25519_sign(msg_len ? msg : sig, msg_len, sig, &ltc_sig_len,
+			       &ltc_key);
+	if (ltc_res == CRYPT_OK) {
+		*sig_len = ltc_sig_len;
+	} else if (ltc_res == CRYPT_MEM) {
+		res = TEE_ERROR_OUT_OF_MEMORY;
+	} else {
+		res = TEE_ERROR_BAD_PARAMETERS;
+	}
+
+	memzero_explicit(&ltc_key, sizeof(ltc_key));
+	return res;
+}
+
+TEE_Result crypto_acipher_ed25519_verify(const uint8_t *public_key,
+					 const uint8_t *msg, size_t msg_len,
+					 const uint8_t *sig, size_t sig_len)
+{
+	curve25519_key ltc_key = {
+		.type = PK_PUBLIC,
+		.algo = PKA_ED25519,
+	};
+	int ltc_stat = 0;
+	int ltc_res = 0;
+
+	if (sig_len != ED25519_SIG_SIZE ||
+	    !ed25519_s_is_canonical(sig + ED25519_SIG_SIZE / 2))
+		return TEE_ERROR_SIGNATURE_INVALID;
+
+	memcpy(ltc_key.pub, public_key, sizeof(ltc_key.pub));
+
+	ltc_res = ed25519_verify(msg_len ? msg : sig, msg_len, sig, sig_len,
+				 &ltc_stat, &ltc_key);
+	switch (ltc_res) {
+	case CRYPT_OK:
+		if (ltc_stat == 1)
+			return TEE_SUCCESS;
+		return TEE_ERROR_SIGNATURE_INVALID;
+	case CRYPT_MEM:
+		return TEE_ERROR_OUT_OF_MEMORY;
+	default:
+		/* Includes a public value that doesn't decode to a point */
+		return TEE_ERROR_SIGNATURE_INVALID;
+	}
+}
@@ -298,6 +298,11 @@ void ltc_ecc_fp_tablelock(int lock);
 /* R = kG */
 int ltc_ecc_mulmod(void *k, const ecc_point *G, ecc_point *R, void *a, void *modulus, int map);
 
+#ifdef LTC_ECC_COMB
+/* R = kG for the generator G of P-256/P-384 using precomputed comb tables */
+int ltc_ecc_mulmod_comb(void *k, const ltc_ecc_dp *dp, ecc_point *R, int map);
+#endif
+
 #ifdef LTC_ECC_SHAMIR
 /* kA*A + kB*B = C */
 int ltc_ecc_mul2add(const ecc_point *A, void *kA,
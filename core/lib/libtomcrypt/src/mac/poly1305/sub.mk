@@ -0,0 +1,3 @@
+ifneq ($(_CFG_CORE_LTC_CHACHA20_POLY1305_ACCEL),y)
+srcs-y += poly1305.c
+endif
@@ -0,0 +1,2 @@
+srcs-y += tweetnacl.c
+incdirs-tweetnacl.c-y += ../../..
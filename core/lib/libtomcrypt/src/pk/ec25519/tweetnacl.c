@@ -18,6 +18,14 @@ typedef unsigned char u8;
 typedef ulong32 u32;
 typedef ulong64 u64;
 typedef long64 i64;
+
+/*
+ * OP-TEE local change: with a 128-bit integer type the field arithmetic
+ * and X25519 come from tweetnacl_radix51.h in core/lib/libtomcrypt.
+ */
+#if defined(__SIZEOF_INT128__)
+#include "tweetnacl_radix51.h"
+#else
 typedef i64 gf[16];
 
 static const u8
@@ -222,6 +230,7 @@ int tweetnacl_crypto_scalarmult(u8 *q,const u8 *n,const u8 *p)
   pack25519(q,x+16);
   return 0;
 }
+#endif /* __SIZEOF_INT128__ */
 
 int tweetnacl_crypto_scalarmult_base(u8 *q,const u8 *n)
 {
@@ -62,7 +62,12 @@ int ecc_generate_key(prng_state *prng, int wprng, ecc_key *key)
    }
 
    /* make the public key */
-   if ((err = ltc_mp.ecc_ptmul(key->k, &key->dp.base, &key->pubkey, key->dp.A, key->dp.prime, 1)) != CRYPT_OK) {
+#ifdef LTC_ECC_COMB
+   err = ltc_ecc_mulmod_comb(key->k, &key->dp, &key->pubkey, 1);
+   if (err == CRYPT_NOP)
+#endif
+   err = ltc_mp.ecc_ptmul(key->k, &key->dp.base, &key->pubkey, key->dp.A, key->dp.prime, 1);
+   if (err != CRYPT_OK) {
       goto error;
    }
    key->type = PK_PRIVATE;
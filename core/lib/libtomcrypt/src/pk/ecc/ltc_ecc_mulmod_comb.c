@@ -0,0 +1,387 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include "tomcrypt_private.h"
+
+/**
+  @file ltc_ecc_mulmod_comb.c
+  Fixed-base comb multiplication of the P-256 and P-384 generators
+*/
+
+#if defined(LTC_MECC) && defined(LTC_ECC_COMB)
+
+/*
+ * Comb of width COMB_W with signed odd digits, the same recoding as the
+ * fixed point multiplication of mbedtls (ecp_mul_comb()). The scalar is
+ * split in COMB_W rows of d = ceil(nbits / COMB_W) bits and each column
+ * selects one of the 2^(COMB_W-1) precomputed points
+ *
+ *    T[i] = G + sum(bit j-1 of i) * 2^(j*d) * G, j = 1 .. COMB_W-1
+ *
+ * After recoding every column digit is odd, so a point is added for
+ * every column and the result never passes through the point at
+ * infinity. A multiplication is d doublings and d + 1 additions,
+ * compared to one doubling and one addition per scalar bit with the
+ * ladder in ltc_ecc_mulmod_timing.c. The table entry of each column is
+ * read with a full scan of the table and the sign is applied with a
+ * masked select, so neither the memory access pattern nor the sequence
+ * of point operations depends on the scalar.
+ *
+ * The tables are built on first use and kept for the lifetime of the
+ * library, COMB_POINTS affine points stored as fixed size big endian
+ * byte strings in Montgomery form.
+ */
+#define COMB_W         6
+#define COMB_POINTS    (1 << (COMB_W - 1))
+#define COMB_MAX_SIZE  48
+#define COMB_MAX_D     ((COMB_MAX_SIZE * 8 + COMB_W - 1) / COMB_W)
+
+struct comb_table {
+   unsigned long size;
+   unsigned char prime[COMB_MAX_SIZE];
+   unsigned char x[COMB_POINTS][COMB_MAX_SIZE];
+   unsigned char y[COMB_POINTS][COMB_MAX_SIZE];
+};
+
+struct comb_curve {
+   const unsigned long *oid;
+   unsigned long oidlen;
+   struct comb_table *table;
+};
+
+static const unsigned long _oid_p256[] = { 1, 2, 840, 10045, 3, 1, 7 };
+static const unsigned long _oid_p384[] = { 1, 3, 132, 0, 34 };
+
+static struct comb_curve _comb_curves[] = {
+   { _oid_p256, sizeof(_oid_p256) / sizeof(_oid_p256[0]), NULL },
+   { _oid_p384, sizeof(_oid_p384) / sizeof(_oid_p384[0]), NULL },
+};
+
+LTC_MUTEX_GLOBAL(ltc_ecc_comb_lock)
+
+/* Montgomery context of a curve, ma is NULL for curves with a == -3 */
+struct comb_ctx {
+   void *mp;
+   void *mu;
+   void *ma;
+};
+
+static void _comb_ctx_free(struct comb_ctx *ctx)
+{
+   if (ctx->ma != NULL) mp_clear(ctx->ma);
+   if (ctx->mu != NULL) mp_clear(ctx->mu);
+   if (ctx->mp != NULL) mp_montgomery_free(ctx->mp);
+}
+
+static int _comb_ctx_init(struct comb_ctx *ctx, const ltc_ecc_dp *dp)
+{
+   void *a_plus3 = NULL;
+   int err;
+
+   XMEMSET(ctx, 0, sizeof(*ctx));
+
+   if ((err = mp_montgomery_setup(dp->prime, &ctx->mp)) != CRYPT_OK)        { goto error; }
+   if ((err = mp_init(&ctx->mu)) != CRYPT_OK)                               { goto error; }
+   if ((err = mp_montgomery_normalization(ctx->mu, dp->prime)) != CRYPT_OK) { goto error; }
+
+   if ((err = mp_init(&a_plus3)) != CRYPT_OK)                               { goto error; }
+   if ((err = mp_add_d(dp->A, 3, a_plus3)) != CRYPT_OK)                     { goto error; }
+   if (mp_cmp(a_plus3, dp->prime) != LTC_MP_EQ) {
+      if ((err = mp_init(&ctx->ma)) != CRYPT_OK)                            { goto error; }
+      if ((err = mp_mulmod(dp->A, ctx->mu, dp->prime, ctx->ma)) != CRYPT_OK) { goto error; }
+   }
+   mp_clear(a_plus3);
+   return CRYPT_OK;
+
+error:
+   if (a_plus3 != NULL) mp_clear(a_plus3);
+   _comb_ctx_free(ctx);
+   return err;
+}
+
+/* Big endian export of a into exactly len bytes, a < 2^(8 * len) */
+static int _mp_to_fixed(void *a, unsigned char *buf, unsigned long len)
+{
+   unsigned long sz = mp_unsigned_bin_size(a);
+
+   if (sz > len) return CRYPT_BUFFER_OVERFLOW;
+   XMEMSET(buf, 0, len - sz);
+   return mp_to_unsigned_bin(a, buf + len - sz);
+}
+
+static unsigned char _ct_mask_eq(unsigned int a, unsigned int b)
+{
+   unsigned int v = a ^ b;
+
+   /* 0xff if a == b, 0 otherwise */
+   return (unsigned char)(((v | (0U - v)) >> (sizeof(v) * 8 - 1)) - 1);
+}
+
+/* dst = mask ? src : dst */
+static void _ct_copy(unsigned char *dst, const unsigned char *src,
+                     unsigned long len, unsigned char mask)
+{
+   unsigned long i;
+
+   for (i = 0; i < len; i++) {
+      dst[i] = (unsigned char)((dst[i] & ~mask) | (src[i] & mask));
+   }
+}
+
+/* neg = p - v, v in [1, p - 1] */
+static void _ct_neg(unsigned char *neg, const unsigned char *v,
+                    const unsigned char *p, unsigned long len)
+{
+   unsigned int borrow = 0, t;
+   unsigned long i;
+
+   for (i = len; i-- > 0; ) {
+      t = (unsigned int)p[i] - v[i] - borrow;
+      neg[i] = (unsigned char)t;
+      borrow = (t >> 8) & 1;
+   }
+}
+
+/* Returns (x, y) of the column digit v, bit 7 of v is the sign */
+static void _comb_select(const struct comb_table *t, unsigned char v,
+                         unsigned char *x, unsigned char *y)
+{
+   unsigned char neg_y[COMB_MAX_SIZE];
+   unsigned int idx = (v & 0x7f) >> 1;
+   unsigned int i;
+
+   XMEMSET(x, 0, t->size);
+   XMEMSET(y, 0, t->size);
+   for (i = 0; i < COMB_POINTS; i++) {
+      unsigned char mask = _ct_mask_eq(i, idx);
+
+      _ct_copy(x, t->x[i], t->size, mask);
+      _ct_copy(y, t->y[i], t->size, mask);
+   }
+
+   _ct_neg(neg_y, y, t->prime, t->size);
+   _ct_copy(y, neg_y, t->size, (unsigned char)(0U - (v >> 7)));
+}
+
+static int _comb_load(ecc_point *P, const unsigned char *x,
+                      const unsigned char *y, unsigned long len,
+                      const struct comb_ctx *ctx)
+{
+   int err;
+
+   if ((err = mp_read_unsigned_bin(P->x, (unsigned char *)x, len)) != CRYPT_OK) return err;
+   if ((err = mp_read_unsigned_bin(P->y, (unsigned char *)y, len)) != CRYPT_OK) return err;
+   return mp_copy(ctx->mu, P->z);
+}
+
+/* Recode the odd scalar in the big endian buffer k into d + 1 digits */
+static void _comb_recode(unsigned char *x, unsigned long d,
+                         const unsigned char *k, unsigned long len)
+{
+   unsigned char c, cc, adjust;
+   unsigned long i, j, bit;
+
+   XMEMSET(x, 0, d + 1);
+   for (i = 0; i < d; i++) {
+      for (j = 0; j < COMB_W; j++) {
+         bit = i + d * j;
+         if (bit < len * 8) {
+            x[i] |= ((k[len - 1 - bit / 8] >> (bit % 8)) & 1) << j;
+         }
+      }
+   }
+
+   /* Make x[1] .. x[d] odd, moving the adjustment into the sign of x[i-1] */
+   c = 0;
+   for (i = 1; i <= d; i++) {
+      cc = x[i] & c;
+      x[i] = x[i] ^ c;
+      c = cc;
+
+      adjust = 1 - (x[i] & 0x01);
+      c |= x[i] & (x[i - 1] * adjust);
+      x[i] = x[i] ^ (x[i - 1] * adjust);
+      x[i - 1] |= adjust << 7;
+   }
+}
+
+static int _comb_build(const ltc_ecc_dp *dp, struct comb_table **table)
+{
+   ecc_point *T[COMB_POINTS] = { NULL };
+   ecc_point *pw[COMB_W] = { NULL };
+   struct comb_table *t = NULL;
+   struct comb_ctx ctx;
+   unsigned long d, i, j;
+   int err;
+
+   if ((unsigned long)dp->size > COMB_MAX_SIZE) return CRYPT_NOP;
+
+   if ((err = _comb_ctx_init(&ctx, dp)) != CRYPT_OK) return err;
+
+   t = XCALLOC(1, sizeof(*t));
+   if (t == NULL) { err = CRYPT_MEM; goto done; }
+   t->size = dp->size;
+   d = (t->size * 8 + COMB_W - 1) / COMB_W;
+   if ((err = _mp_to_fixed(dp->prime, t->prime, t->size)) != CRYPT_OK)      { goto done; }
+
+   for (i = 0; i < COMB_POINTS; i++) {
+      if ((T[i] = ltc_ecc_new_point()) == NULL) { err = CRYPT_MEM; goto done; }
+   }
+   for (i = 0; i < COMB_W; i++) {
+      if ((pw[i] = ltc_ecc_new_point()) == NULL) { err = CRYPT_MEM; goto done; }
+   }
+
+   /* pw[j] = 2^(j*d) * G in Montgomery form */
+   if ((err = mp_mulmod(dp->base.x, ctx.mu, dp->prime, pw[0]->x)) != CRYPT_OK) { goto done; }
+   if ((err = mp_mulmod(dp->base.y, ctx.mu, dp->prime, pw[0]->y)) != CRYPT_OK) { goto done; }
+   if ((err = mp_copy(ctx.mu, pw[0]->z)) != CRYPT_OK)                         { goto done; }
+   for (j = 1; j < COMB_W; j++) {
+      if ((err = ltc_ecc_copy_point(pw[j - 1], pw[j])) != CRYPT_OK)          { goto done; }
+      for (i = 0; i < d; i++) {
+         if ((err = ltc_mp.ecc_ptdbl(pw[j], pw[j], ctx.ma, dp->prime, ctx.mp)) != CRYPT_OK) { goto done; }
+      }
+   }
+
+   /* T[i] = T[i without its lowest set bit] + pw[index of that bit + 1] */
+   if ((err = ltc_ecc_copy_point(pw[0], T[0])) != CRYPT_OK)                  { goto done; }
+   for (i = 1; i < COMB_POINTS; i++) {
+      for (j = 0; !(i & (1UL << j)); j++);
+      if ((err = ltc_mp.ecc_ptadd(T[i & (i - 1)], pw[j + 1], T[i], ctx.ma,
+                                  dp->prime, ctx.mp)) != CRYPT_OK)           { goto done; }
+   }
+
+   /* Store as affine coordinates, still in Montgomery form */
+   for (i = 0; i < COMB_POINTS; i++) {
+      if ((err = ltc_ecc_map(T[i], dp->prime, ctx.mp)) != CRYPT_OK)          { goto done; }
+      if ((err = mp_mulmod(T[i]->x, ctx.mu, dp->prime, T[i]->x)) != CRYPT_OK) { goto done; }
+      if ((err = mp_mulmod(T[i]->y, ctx.mu, dp->prime, T[i]->y)) != CRYPT_OK) { goto done; }
+      if ((err = _mp_to_fixed(T[i]->x, t->x[i], t->size)) != CRYPT_OK)       { goto done; }
+      if ((err = _mp_to_fixed(T[i]->y, t->y[i], t->size)) != CRYPT_OK)       { goto done; }
+   }
+
+   *table = t;
+   t = NULL;
+   err = CRYPT_OK;
+done:
+   for (i = 0; i < COMB_POINTS; i++) {
+      if (T[i] != NULL) ltc_ecc_del_point(T[i]);
+   }
+   for (i = 0; i < COMB_W; i++) {
+      if (pw[i] != NULL) ltc_ecc_del_point(pw[i]);
+   }
+   XFREE(t);
+   _comb_ctx_free(&ctx);
+   return err;
+}
+
+/* Returns the table for the curve of dp, building it if needed */
+static int _comb_get_table(const ltc_ecc_dp *dp, const struct comb_table **table)
+{
+   struct comb_curve *cc = NULL;
+   unsigned long i;
+   int err = CRYPT_OK;
+
+   for (i = 0; i < sizeof(_comb_curves) / sizeof(_comb_curves[0]); i++) {
+      if (dp->oidlen == _comb_curves[i].oidlen &&
+          XMEMCMP(dp->oid, _comb_curves[i].oid,
+                  dp->oidlen * sizeof(dp->oid[0])) == 0) {
+         cc = _comb_curves + i;
+         break;
+      }
+   }
+   if (cc == NULL) return CRYPT_NOP;
+
+   LTC_MUTEX_LOCK(&ltc_ecc_comb_lock);
+   if (cc->table == NULL) {
+      err = _comb_build(dp, &cc->table);
+   }
+   *table = cc->table;
+   LTC_MUTEX_UNLOCK(&ltc_ecc_comb_lock);
+
+   return err;
+}
+
+/**
+   Multiply the generator of a P-256 or P-384 domain by a private scalar
+   @param k    The scalar to multiply by, in the range [1, order-1]
+   @param dp   The domain parameters, the base point is the generator
+   @param R    [out] Destination for kG
+   @param map  Boolean whether to map back to affine or not (1==map, 0 == leave in projective)
+   @return CRYPT_OK on success, CRYPT_NOP if the curve or k isn't handled
+*/
+int ltc_ecc_mulmod_comb(void *k, const ltc_ecc_dp *dp, ecc_point *R, int map)
+{
+   unsigned char kbuf[COMB_MAX_SIZE], nkbuf[COMB_MAX_SIZE];
+   unsigned char xbuf[COMB_MAX_SIZE], ybuf[COMB_MAX_SIZE];
+   unsigned char digits[COMB_MAX_D + 1];
+   const struct comb_table *t = NULL;
+   ecc_point *Q = NULL, *acc = NULL;
+   struct comb_ctx ctx;
+   void *nk = NULL;
+   unsigned char even;
+   unsigned long d, i;
+   int err;
+
+   LTC_ARGCHK(k  != NULL);
+   LTC_ARGCHK(dp != NULL);
+   LTC_ARGCHK(R  != NULL);
+
+   if ((err = _comb_get_table(dp, &t)) != CRYPT_OK) return err;
+
+   /* The recoding needs 0 < k < order, leave anything else to the ladder */
+   if (mp_iszero(k) || mp_cmp(k, dp->order) != LTC_MP_LT) return CRYPT_NOP;
+
+   if ((err = _comb_ctx_init(&ctx, dp)) != CRYPT_OK) return err;
+
+   Q = ltc_ecc_new_point();
+   acc = ltc_ecc_new_point();
+   if (Q == NULL || acc == NULL)                                             { err = CRYPT_MEM; goto done; }
+   if ((err = mp_init(&nk)) != CRYPT_OK)                                     { goto done; }
+
+   /*
+    * The recoding needs an odd scalar, for an even k use order - k,
+    * which is odd, and negate the result.
+    */
+   if ((err = mp_sub(dp->order, k, nk)) != CRYPT_OK)                         { goto done; }
+   if ((err = _mp_to_fixed(k, kbuf, t->size)) != CRYPT_OK)                   { goto done; }
+   if ((err = _mp_to_fixed(nk, nkbuf, t->size)) != CRYPT_OK)                 { goto done; }
+   even = (unsigned char)(0U - (1U ^ (kbuf[t->size - 1] & 1)));
+   _ct_copy(kbuf, nkbuf, t->size, even);
+
+   d = (t->size * 8 + COMB_W - 1) / COMB_W;
+   _comb_recode(digits, d, kbuf, t->size);
+
+   _comb_select(t, digits[d], xbuf, ybuf);
+   if ((err = _comb_load(acc, xbuf, ybuf, t->size, &ctx)) != CRYPT_OK)      { goto done; }
+   for (i = d; i-- > 0; ) {
+      if ((err = ltc_mp.ecc_ptdbl(acc, acc, ctx.ma, dp->prime, ctx.mp)) != CRYPT_OK)    { goto done; }
+      _comb_select(t, digits[i], xbuf, ybuf);
+      if ((err = _comb_load(Q, xbuf, ybuf, t->size, &ctx)) != CRYPT_OK)     { goto done; }
+      if ((err = ltc_mp.ecc_ptadd(acc, Q, acc, ctx.ma, dp->prime, ctx.mp)) != CRYPT_OK) { goto done; }
+   }
+
+   /* Undo the negation of an even k, y = p - y */
+   if ((err = _mp_to_fixed(acc->y, ybuf, t->size)) != CRYPT_OK)             { goto done; }
+   _ct_neg(xbuf, ybuf, t->prime, t->size);
+   _ct_copy(ybuf, xbuf, t->size, even);
+   if ((err = mp_read_unsigned_bin(acc->y, ybuf, t->size)) != CRYPT_OK)     { goto done; }
+
+   if ((err = ltc_ecc_copy_point(acc, R)) != CRYPT_OK)                       { goto done; }
+   if (map) {
+      err = ltc_ecc_map(R, dp->prime, ctx.mp);
+   }
+
+done:
+   zeromem(kbuf, sizeof(kbuf));
+   zeromem(nkbuf, sizeof(nkbuf));
+   zeromem(digits, sizeof(digits));
+   if (nk != NULL) mp_clear(nk);
+   if (Q != NULL) ltc_ecc_del_point(Q);
+   if (acc != NULL) ltc_ecc_del_point(acc);
+   _comb_ctx_free(&ctx);
+   return err;
+}
+
+#endif
@@ -13,6 +13,7 @@ srcs-y += ltc_ecc_is_point.c
 srcs-y += ltc_ecc_is_point_at_infinity.c
 srcs-y += ltc_ecc_map.c
 srcs-y += ltc_ecc_mulmod.c
+srcs-$(_CFG_CORE_LTC_ECC_COMB) += ltc_ecc_mulmod_comb.c
 srcs-y += ltc_ecc_mulmod_timing.c
 srcs-y += ltc_ecc_mul2add.c
 srcs-y += ltc_ecc_points.c
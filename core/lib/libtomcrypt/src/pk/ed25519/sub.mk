@@ -0,0 +1,3 @@
+srcs-y += ed25519_set_key.c
+srcs-y += ed25519_sign.c
+srcs-y += ed25519_verify.c
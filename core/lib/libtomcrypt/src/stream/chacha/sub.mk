@@ -0,0 +1,8 @@
+ifneq ($(_CFG_CORE_LTC_CHACHA20_POLY1305_ACCEL),y)
+srcs-y += chacha_crypt.c
+endif
+srcs-y += chacha_done.c
+srcs-y += chacha_ivctr32.c
+srcs-y += chacha_ivctr64.c
+srcs-y += chacha_keystream.c
+srcs-y += chacha_setup.c
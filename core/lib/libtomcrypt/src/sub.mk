@@ -5,4 +5,5 @@ subdirs-$(_CFG_CORE_LTC_MAC) += mac
 subdirs-$(_CFG_CORE_LTC_ACIPHER) += math
 subdirs-y += misc
 subdirs-y += modes
-subdirs-$(_CFG_CORE_LTC_ACIPHER) += pk
+subdirs-$(_CFG_CORE_LTC_PK) += pk
+subdirs-$(_CFG_CORE_LTC_CHACHA20_POLY1305) += stream
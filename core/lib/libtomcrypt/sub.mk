@@ -70,6 +70,10 @@ endif
 ifeq ($(_CFG_CORE_LTC_GCM),y)
 	cppflags-lib-y += -DLTC_GCM_MODE
 endif
+ifeq ($(_CFG_CORE_LTC_CHACHA20_POLY1305),y)
+	cppflags-lib-y += -DLTC_CHACHA -DLTC_POLY1305
+	cppflags-lib-y += -DLTC_CHACHA20POLY1305_MODE
+endif
 
 cppflags-lib-y += -DLTC_NO_PK
 
@@ -96,10 +100,16 @@ ifeq ($(_CFG_CORE_LTC_ECC),y)
 
    # ECC 521 bits is the max supported key size
    cppflags-lib-y += -DLTC_MAX_ECC=521
+
+   # fixed-base comb for the P-256/P-384 generators (keygen, signing)
+   cppflags-lib-$(_CFG_CORE_LTC_ECC_COMB) += -DLTC_ECC_COMB
 endif
 ifneq (,$(filter y,$(_CFG_CORE_LTC_SM2_DSA) $(_CFG_CORE_LTC_SM2_PKE)))
    cppflags-lib-y += -DLTC_ECC_SM2
 endif
+ifeq ($(_CFG_CORE_LTC_CURVE25519),y)
+   cppflags-lib-y += -DLTC_CURVE25519
+endif
 
 cppflags-lib-y += -DLTC_NO_PKCS
 
@@ -120,8 +130,10 @@ srcs-$(_CFG_CORE_LTC_CTR) += ctr.c
 srcs-$(_CFG_CORE_LTC_XTS) += xts.c
 srcs-$(_CFG_CORE_LTC_CCM) += ccm.c
 srcs-$(_CFG_CORE_LTC_GCM) += gcm.c
+srcs-$(_CFG_CORE_LTC_CHACHA20_POLY1305) += chachapoly.c
 srcs-$(_CFG_CORE_LTC_DSA) += dsa.c
 srcs-$(_CFG_CORE_LTC_ECC) += ecc.c
+srcs-$(_CFG_CORE_LTC_ECC_P256) += ecc_p256.c
 srcs-$(_CFG_CORE_LTC_RSA) += rsa.c
 srcs-$(_CFG_CORE_LTC_DH) += dh.c
 srcs-$(_CFG_CORE_LTC_AES) += aes.c
@@ -130,9 +142,18 @@ srcs-$(_CFG_CORE_LTC_SHA1_ACCEL) += sha1_accel.c
 ifeq ($(_CFG_CORE_LTC_SHA256_DESC),y)
 srcs-$(_CFG_CORE_LTC_SHA256_ACCEL) += sha256_accel.c
 endif
+ifeq ($(_CFG_CORE_LTC_SHA512_DESC),y)
+srcs-$(_CFG_CORE_LTC_SHA512_ACCEL) += sha512_accel.c
+endif
+ifeq ($(_CFG_CORE_LTC_CHACHA20_POLY1305),y)
+srcs-$(_CFG_CORE_LTC_CHACHA20_POLY1305_ACCEL) += chacha_accel.c
+srcs-$(_CFG_CORE_LTC_CHACHA20_POLY1305_ACCEL) += poly1305_accel.c
+endif
 srcs-$(_CFG_CORE_LTC_SM2_DSA) += sm2-dsa.c
 srcs-$(_CFG_CORE_LTC_SM2_PKE) += sm2-pke.c
 srcs-$(_CFG_CORE_LTC_SM2_KEP) += sm2-kep.c
+srcs-$(_CFG_CORE_LTC_X25519) += x25519.c
+srcs-$(_CFG_CORE_LTC_ED25519) += ed25519.c
 
 ifeq ($(_CFG_CORE_LTC_ACIPHER),y)
 srcs-y += mpi_desc.c
@@ -0,0 +1,292 @@
+/* SPDX-License-Identifier: BSD-2-Clause */
+/*
+ * Copyright (c) 2026, agent
+ *
+ * Parts are taken from TweetNaCl, which is in the public domain.
+ */
+
+/*
+ * Field arithmetic modulo p = 2^255 - 19 and X25519 for
+ * src/pk/ec25519/tweetnacl.c, included by it in place of its own when the
+ * compiler has a 128-bit integer type. This is an OP-TEE addition, not
+ * part of LibTomCrypt, kept here so tweetnacl.c only needs the include.
+ *
+ * Elements are held in five 51-bit limbs instead of sixteen 16-bit ones,
+ * which turns a multiplication into 25 64x64->128 products instead of 256
+ * 64x64->64 ones. Inversion and square roots use the usual addition
+ * chains. The functions have the same names and semantics as the ones
+ * they replace and are constant time, with no secret dependent branches
+ * or indexes.
+ */
+
+typedef unsigned __int128 u128;
+typedef u64 gf[5];
+
+#define MASK51 ((((u64)1) << 51) - 1)
+
+static const u8
+  _9[32] = {9};
+static const gf
+  gf0,
+  gf1 = {1},
+  _121665 = {121665},
+  D = {0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff},
+  D2 = {0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff},
+  X = {0x62d608f25d51a, 0x412a4b4f6592a, 0x75b7171a4b31d, 0x1ff60527118fe, 0x216936d3cd6e5},
+  Y = {0x6666666666658, 0x4cccccccccccc, 0x1999999999999, 0x3333333333333, 0x6666666666666},
+  I = {0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d};
+
+static int vn(const u8 *x,const u8 *y,int n)
+{
+  int i;
+  u32 d = 0;
+  FOR(i,n) d |= x[i]^y[i];
+  return (1 & ((d - 1) >> 8)) - 1;
+}
+
+static int tweetnacl_crypto_verify_32(const u8 *x,const u8 *y)
+{
+  return vn(x,y,32);
+}
+
+sv set25519(gf r, const gf a)
+{
+  int i;
+  FOR(i,5) r[i]=a[i];
+}
+
+sv sel25519(gf p,gf q,int b)
+{
+  int i;
+  u64 t,c=~((u64)b-1);
+  FOR(i,5) {
+    t= c&(p[i]^q[i]);
+    p[i]^=t;
+    q[i]^=t;
+  }
+}
+
+
+/*
+ * Elements are kept loosely reduced: the output of M() and S() has limbs
+ * just above 2^51, A() and Z() add at most three bits to that, which M()
+ * and S() accept as inputs without overflowing their 128-bit column sums.
+ * Only pack25519() reduces fully modulo p.
+ */
+
+sv car25519(gf o)
+{
+  u64 c;
+  c=o[0]>>51; o[0]&=MASK51; o[1]+=c;
+  c=o[1]>>51; o[1]&=MASK51; o[2]+=c;
+  c=o[2]>>51; o[2]&=MASK51; o[3]+=c;
+  c=o[3]>>51; o[3]&=MASK51; o[4]+=c;
+  c=o[4]>>51; o[4]&=MASK51; o[0]+=19*c;
+}
+
+sv pack25519(u8 *o,const gf n)
+{
+  gf t;
+  u64 q;
+  set25519(t,n);
+  car25519(t);
+  car25519(t);
+  /* t < 2p here, q = 1 iff t >= p */
+  q=(t[0]+19)>>51;
+  q=(t[1]+q)>>51;
+  q=(t[2]+q)>>51;
+  q=(t[3]+q)>>51;
+  q=(t[4]+q)>>51;
+  t[0]+=19*q;
+  t[1]+=t[0]>>51; t[0]&=MASK51;
+  t[2]+=t[1]>>51; t[1]&=MASK51;
+  t[3]+=t[2]>>51; t[2]&=MASK51;
+  t[4]+=t[3]>>51; t[3]&=MASK51;
+  t[4]&=MASK51;
+  STORE64L(t[0]|(t[1]<<51),o);
+  STORE64L((t[1]>>13)|(t[2]<<38),o+8);
+  STORE64L((t[2]>>26)|(t[3]<<25),o+16);
+  STORE64L((t[3]>>39)|(t[4]<<12),o+24);
+}
+
+sv unpack25519(gf o, const u8 *n)
+{
+  u64 w0,w1,w2,w3;
+  LOAD64L(w0,n);
+  LOAD64L(w1,n+8);
+  LOAD64L(w2,n+16);
+  LOAD64L(w3,n+24);
+  o[0]=w0&MASK51;
+  o[1]=((w0>>51)|(w1<<13))&MASK51;
+  o[2]=((w1>>38)|(w2<<26))&MASK51;
+  o[3]=((w2>>25)|(w3<<39))&MASK51;
+  o[4]=(w3>>12)&MASK51;
+}
+
+sv A(gf o,const gf a,const gf b)
+{
+  int i;
+  FOR(i,5) o[i]=a[i]+b[i];
+}
+
+sv Z(gf o,const gf a,const gf b)
+{
+  /* a - b + 4p keeps the limbs positive */
+  o[0]=a[0]+0x1fffffffffffb4ULL-b[0];
+  o[1]=a[1]+0x1ffffffffffffcULL-b[1];
+  o[2]=a[2]+0x1ffffffffffffcULL-b[2];
+  o[3]=a[3]+0x1ffffffffffffcULL-b[3];
+  o[4]=a[4]+0x1ffffffffffffcULL-b[4];
+}
+
+sv carw25519(gf o,u128 t[5])
+{
+  u128 c;
+  t[1]+=(u64)(t[0]>>51);
+  t[2]+=(u64)(t[1]>>51);
+  t[3]+=(u64)(t[2]>>51);
+  t[4]+=(u64)(t[3]>>51);
+  c=(t[4]>>51)*19+((u64)t[0]&MASK51);
+  o[0]=(u64)c&MASK51;
+  o[1]=((u64)t[1]&MASK51)+(u64)(c>>51);
+  o[2]=(u64)t[2]&MASK51;
+  o[3]=(u64)t[3]&MASK51;
+  o[4]=(u64)t[4]&MASK51;
+}
+
+sv M(gf o,const gf a,const gf b)
+{
+  u128 t[5];
+  u64 b1=19*b[1],b2=19*b[2],b3=19*b[3],b4=19*b[4];
+  t[0]=(u128)a[0]*b[0]+(u128)a[1]*b4+(u128)a[2]*b3+(u128)a[3]*b2+(u128)a[4]*b1;
+  t[1]=(u128)a[0]*b[1]+(u128)a[1]*b[0]+(u128)a[2]*b4+(u128)a[3]*b3+(u128)a[4]*b2;
+  t[2]=(u128)a[0]*b[2]+(u128)a[1]*b[1]+(u128)a[2]*b[0]+(u128)a[3]*b4+(u128)a[4]*b3;
+  t[3]=(u128)a[0]*b[3]+(u128)a[1]*b[2]+(u128)a[2]*b[1]+(u128)a[3]*b[0]+(u128)a[4]*b4;
+  t[4]=(u128)a[0]*b[4]+(u128)a[1]*b[3]+(u128)a[2]*b[2]+(u128)a[3]*b[1]+(u128)a[4]*b[0];
+  carw25519(o,t);
+}
+
+sv S(gf o,const gf a)
+{
+  u128 t[5];
+  u64 a0_2=2*a[0],a1_2=2*a[1];
+  u64 a1_38=38*a[1],a2_38=38*a[2],a3_38=38*a[3];
+  u64 a3_19=19*a[3],a4_19=19*a[4];
+  t[0]=(u128)a[0]*a[0]+(u128)a1_38*a[4]+(u128)a2_38*a[3];
+  t[1]=(u128)a0_2*a[1]+(u128)a2_38*a[4]+(u128)a3_19*a[3];
+  t[2]=(u128)a0_2*a[2]+(u128)a[1]*a[1]+(u128)a3_38*a[4];
+  t[3]=(u128)a0_2*a[3]+(u128)a1_2*a[2]+(u128)a4_19*a[4];
+  t[4]=(u128)a0_2*a[4]+(u128)a1_2*a[3]+(u128)a[2]*a[2];
+  carw25519(o,t);
+}
+
+static int neq25519(const gf a, const gf b)
+{
+  u8 c[32],d[32];
+  pack25519(c,a);
+  pack25519(d,b);
+  return tweetnacl_crypto_verify_32(c,d);
+}
+
+static u8 par25519(const gf a)
+{
+  u8 d[32];
+  pack25519(d,a);
+  return d[0]&1;
+}
+
+/* o = a^(2^n) */
+sv sqn25519(gf o,const gf a,int n)
+{
+  int i;
+  S(o,a);
+  for(i=1;i<n;i++) S(o,o);
+}
+
+/* o = i^(2^250 - 1), i11 = i^11 */
+sv pow22501(gf o,gf i11,const gf i)
+{
+  gf i2,i9,t0,t1,t2;
+  S(i2,i);
+  sqn25519(t0,i2,2);
+  M(i9,t0,i);
+  M(i11,i9,i2);
+  S(t0,i11);
+  M(t0,t0,i9);          /* 2^5 - 1 */
+  sqn25519(t1,t0,5);
+  M(t0,t1,t0);          /* 2^10 - 1 */
+  sqn25519(t1,t0,10);
+  M(t1,t1,t0);          /* 2^20 - 1 */
+  sqn25519(t2,t1,20);
+  M(t1,t2,t1);          /* 2^40 - 1 */
+  sqn25519(t1,t1,10);
+  M(t0,t1,t0);          /* 2^50 - 1 */
+  sqn25519(t1,t0,50);
+  M(t1,t1,t0);          /* 2^100 - 1 */
+  sqn25519(t2,t1,100);
+  M(t1,t2,t1);          /* 2^200 - 1 */
+  sqn25519(t1,t1,50);
+  M(o,t1,t0);           /* 2^250 - 1 */
+}
+
+/* o = i^(p - 2) = i^(2^255 - 21) */
+sv inv25519(gf o,const gf i)
+{
+  gf t,i11;
+  pow22501(t,i11,i);
+  sqn25519(t,t,5);
+  M(o,t,i11);
+}
+
+/* o = i^((p - 5) / 8) = i^(2^252 - 3) */
+sv pow2523(gf o,const gf i)
+{
+  gf t,i11;
+  pow22501(t,i11,i);
+  sqn25519(t,t,2);
+  M(o,t,i);
+}
+
+int tweetnacl_crypto_scalarmult(u8 *q,const u8 *n,const u8 *p)
+{
+  u8 z[32];
+  int r,i;
+  gf x,a,b,c,d,e,f;
+  FOR(i,31) z[i]=n[i];
+  z[31]=(n[31]&127)|64;
+  z[0]&=248;
+  unpack25519(x,p);
+  set25519(b,x);
+  set25519(a,gf1);
+  set25519(c,gf0);
+  set25519(d,gf1);
+  for(i=254;i>=0;--i) {
+    r=(z[i>>3]>>(i&7))&1;
+    sel25519(a,b,r);
+    sel25519(c,d,r);
+    A(e,a,c);
+    Z(a,a,c);
+    A(c,b,d);
+    Z(b,b,d);
+    S(d,e);
+    S(f,a);
+    M(a,c,a);
+    M(c,b,e);
+    A(e,a,c);
+    Z(a,a,c);
+    S(b,a);
+    Z(c,d,f);
+    M(a,c,_121665);
+    A(a,a,d);
+    M(c,c,a);
+    M(a,d,f);
+    M(d,b,x);
+    S(b,e);
+    sel25519(a,b,r);
+    sel25519(c,d,r);
+  }
+  inv25519(c,c);
+  M(a,a,c);
+  pack25519(q,a);
+  return 0;
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <crypto/crypto.h>
+#include <string_ext.h>
+#include <tee_api_types.h>
+#include <tomcrypt_private.h>
+
+#define X25519_KEY_SIZE_BITS	256
+
+TEE_Result crypto_acipher_gen_x25519_key(struct x25519_keypair *key,
+					 size_t key_size)
+{
+	curve25519_key ltc_key = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	if (key_size != X25519_KEY_SIZE_BITS)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/*
+	 * x25519_make_key() insists on an LTC PRNG, the scalar is simply
+	 * 32 random bytes and is clamped when used.
+	 */
+	res = crypto_rng_read(key->priv, sizeof(key->priv));
+	if (res)
+		return res;
+
+	if (x25519_set_key(key->priv, sizeof(key->priv), NULL, 0,
+			   &ltc_key) != CRYPT_OK) {
+		res = TEE_ERROR_BAD_PARAMETERS;
+		goto out;
+	}
+	memcpy(key->pub, ltc_key.pub, sizeof(key->pub));
+out:
+	memzero_explicit(&ltc_key, sizeof(ltc_key));
+	return res;
+}
+
+TEE_Result crypto_acipher_x25519_shared_secret(struct x25519_keypair *priv_key,
+					       const uint8_t *public_key,
+					       uint8_t *secret,
+					       size_t *secret_len)
+{
+	curve25519_key ltc_private_key = {
+		.type = PK_PRIVATE,
+		.algo = PKA_X25519,
+	};
+	curve25519_key ltc_public_key = {
+		.type = PK_PUBLIC,
+		.algo = PKA_X25519,
+	};
+	unsigned long ltc_secret_len = *secret_len;
+	TEE_Result res = TEE_SUCCESS;
+
+	memcpy(ltc_private_key.priv, priv_key->priv,
+	       sizeof(ltc_private_key.priv));
+	memcpy(ltc_public_key.pub, public_key, sizeof(ltc_public_key.pub));
+
+	/*
+	 * No check for an all-zero result from a small order public value,
+	 * RFC 7748 leaves that to the protocol using the shared secret.
+	 */
+	switch (x25519_shared_secret(&ltc_private_key, &ltc_public_key, secret,
+				     &ltc_secret_len)) {
+	case CRYPT_OK:
+		break;
+	case CRYPT_BUFFER_OVERFLOW:
+		res = TEE_ERROR_SHORT_BUFFER;
+		break;
+	default:
+		res = TEE_ERROR_BAD_PARAMETERS;
+		break;
+	}
+	*secret_len = ltc_secret_len;
+
+	memzero_explicit(&ltc_private_key, sizeof(ltc_private_key));
+	return res;
+}
@@ -18,6 +18,12 @@ struct file_slice_elem {
 	SLIST_ENTRY(file_slice_elem) link;
 };
 
+struct file_reloc_elem {
+	struct fobj *fobj;
+	vaddr_t va;
+	SLIST_ENTRY(file_reloc_elem) link;
+};
+
 /*
  * struct file - file resources
  * @tag:	Tag or hash uniquely identifying a file
@@ -26,6 +32,7 @@ struct file_slice_elem {
  * @link:	Linked list element
  * @num_slices:	Number of elements in the @slices array below
  * @slices:	Array of file slices holding the fobjs of this file
+ * @reloc_head:	List of relocated snapshots of writeable segments
  *
  * A file is constructed of slices which may be shared in different
  * mappings/contexts. There may be holes in the file for ranges of the file
@@ -38,10 +45,13 @@ struct file {
 	TAILQ_ENTRY(file) link;
 	struct mutex mu;
 	SLIST_HEAD(, file_slice_elem) slice_head;
+	SLIST_HEAD(, file_reloc_elem) reloc_head;
 };
 
 static struct mutex file_mu = MUTEX_INITIALIZER;
 static TAILQ_HEAD(, file) file_head = TAILQ_HEAD_INITIALIZER(file_head);
+/* Number of pages held by all relocated snapshots, protected by file_mu */
+static size_t reloc_num_pages;
 
 static int file_tag_cmp(const struct file *f, const uint8_t *tag,
 			unsigned int taglen)
@@ -75,6 +85,17 @@ static void file_free(struct file *f)
 		free(fse);
 	}
 
+	while (!SLIST_EMPTY(&f->reloc_head)) {
+		struct file_reloc_elem *fre = SLIST_FIRST(&f->reloc_head);
+
+		SLIST_REMOVE_HEAD(&f->reloc_head, link);
+		mutex_lock(&file_mu);
+		reloc_num_pages -= fre->fobj->num_pages;
+		mutex_unlock(&file_mu);
+		fobj_put(fre->fobj);
+		free(fre);
+	}
+
 	free(f);
 }
 
@@ -156,6 +177,7 @@ struct file *file_get_by_tag(const uint8_t *tag, unsigned int taglen)
 	refcount_set(&f->refc, 1);
 	mutex_init(&f->mu);
 	SLIST_INIT(&f->slice_head);
+	SLIST_INIT(&f->reloc_head);
 	TAILQ_INSERT_HEAD(&file_head, f, link);
 
 out:
@@ -193,6 +215,56 @@ struct file_slice *file_find_slice(struct file *f, unsigned int page_offset)
 	return NULL;
 }
 
+TEE_Result file_add_reloc_slice(struct file *f, struct fobj *fobj,
+				vaddr_t va)
+{
+	struct file_reloc_elem *fre = NULL;
+
+	assert(f->mu.state);
+
+	if (file_find_reloc_slice(f, va, fobj->num_pages))
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	fre = calloc(1, sizeof(*fre));
+	if (!fre)
+		return TEE_ERROR_OUT_OF_MEMORY;
+
+	fre->fobj = fobj_get(fobj);
+	fre->va = va;
+	SLIST_INSERT_HEAD(&f->reloc_head, fre, link);
+
+	mutex_lock(&file_mu);
+	reloc_num_pages += fobj->num_pages;
+	mutex_unlock(&file_mu);
+
+	return TEE_SUCCESS;
+}
+
+struct fobj *file_find_reloc_slice(struct file *f, vaddr_t va,
+				   unsigned int num_pages)
+{
+	struct file_reloc_elem *fre = NULL;
+
+	assert(f->mu.state);
+
+	SLIST_FOREACH(fre, &f->reloc_head, link)
+		if (fre->va == va && fre->fobj->num_pages == num_pages)
+			return fre->fobj;
+
+	return NULL;
+}
+
+size_t file_get_reloc_num_pages(void)
+{
+	size_t n = 0;
+
+	mutex_lock(&file_mu);
+	n = reloc_num_pages;
+	mutex_unlock(&file_mu);
+
+	return n;
+}
+
 void file_lock(struct file *f)
 {
 	mutex_lock(&f->mu);
@@ -9,6 +9,8 @@
 #include <initcall.h>
 #include <kernel/boot.h>
 #include <kernel/panic.h>
+#include <kernel/spinlock.h>
+#include <kernel/ts_store.h>
 #include <mm/core_memprot.h>
 #include <mm/core_mmu.h>
 #include <mm/fobj.h>
@@ -813,4 +815,232 @@ const struct fobj_ops ops_sec_mem __weak __rodata_unpaged("ops_sec_mem") = {
 	.get_pa = sec_mem_get_pa,
 };
 
+#ifdef CFG_TA_SHARE_RELOC_PAGES
+
+/*
+ * struct fobj_cow - copy-on-write fobj
+ * @parent:	Fobj holding the shared pages
+ * @pages:	Array of private pages, NULL for pages still shared
+ * @lock:	Protects @pages
+ * @fobj:	Fobj of this object
+ *
+ * A page of @pages goes from NULL to a private page only once, by
+ * fobj_cow_break() with @lock held. The breaks are normally serialized
+ * already since a TA instance is only run by one thread at a time and TEE
+ * core only accesses the memory of the active instance, @lock makes the
+ * fobj safe to use without relying on that. It's a spinlock since
+ * fobj_cow_break() is called from the abort handler.
+ */
+struct fobj_cow {
+	struct fobj *parent;
+	tee_mm_entry_t **pages;
+	unsigned int lock;
+	struct fobj fobj;
+};
+
+const struct fobj_ops ops_cow;
+
+static unsigned int cow_stats_lock = SPINLOCK_UNLOCK;
+static struct fobj_cow_stats cow_stats;
+
+static void cow_stats_update(size_t shared_pages_add, size_t shared_pages_sub,
+			     size_t num_breaks_add)
+{
+	uint32_t exceptions = cpu_spin_lock_xsave(&cow_stats_lock);
+
+	cow_stats.shared_pages += shared_pages_add;
+	cow_stats.shared_pages -= shared_pages_sub;
+	cow_stats.num_breaks += num_breaks_add;
+	cpu_spin_unlock_xrestore(&cow_stats_lock, exceptions);
+}
+
+struct fobj *fobj_cow_alloc(struct fobj *parent)
+{
+	struct fobj_cow *f = NULL;
+
+	if (!parent || !parent->ops->get_pa)
+		return NULL;
+
+	f = calloc(1, sizeof(*f));
+	if (!f)
+		return NULL;
+
+	f->pages = calloc(parent->num_pages, sizeof(*f->pages));
+	if (!f->pages) {
+		free(f);
+		return NULL;
+	}
+
+	f->parent = fobj_get(parent);
+	f->lock = SPINLOCK_UNLOCK;
+	f->fobj.ops = &ops_cow;
+	f->fobj.num_pages = parent->num_pages;
+	refcount_set(&f->fobj.refc, 1);
+	cow_stats_update(parent->num_pages, 0, 0);
+
+	return &f->fobj;
+}
+
+static struct fobj_cow *to_cow(struct fobj *fobj)
+{
+	assert(fobj->ops == &ops_cow);
+
+	return container_of(fobj, struct fobj_cow, fobj);
+}
+
+static void cow_free(struct fobj *fobj)
+{
+	struct fobj_cow *f = to_cow(fobj);
+	size_t num_shared = 0;
+	unsigned int n = 0;
+
+	assert(!refcount_val(&fobj->refc));
+
+	for (n = 0; n < fobj->num_pages; n++) {
+		if (f->pages[n])
+			tee_mm_free(f->pages[n]);
+		else
+			num_shared++;
+	}
+	cow_stats_update(0, num_shared, 0);
+
+	fobj_put(f->parent);
+	free(f->pages);
+	free(f);
+}
+
+static paddr_t cow_get_pa(struct fobj *fobj, unsigned int page_idx)
+{
+	struct fobj_cow *f = to_cow(fobj);
+
+	tee_mm_entry_t *mm = NULL;
+	uint32_t exceptions = 0;
+
+	assert(refcount_val(&fobj->refc));
+	assert(page_idx < fobj->num_pages);
+
+	exceptions = cpu_spin_lock_xsave(&f->lock);
+	mm = f->pages[page_idx];
+	cpu_spin_unlock_xrestore(&f->lock, exceptions);
+
+	if (mm)
+		return tee_mm_get_smem(mm);
+
+	return f->parent->ops->get_pa(f->parent, page_idx);
+}
+
+static bool cow_page_is_private(struct fobj_cow *f, unsigned int page_idx)
+{
+	uint32_t exceptions = cpu_spin_lock_xsave(&f->lock);
+	bool ret = f->pages[page_idx];
+
+	cpu_spin_unlock_xrestore(&f->lock, exceptions);
+
+	return ret;
+}
+
+TEE_Result fobj_cow_break(struct fobj *fobj, unsigned int page_idx)
+{
+	struct fobj_cow *f = to_cow(fobj);
+	tee_mm_entry_t *mm = NULL;
+	uint32_t exceptions = 0;
+	paddr_t src_pa = 0;
+	void *src = NULL;
+	void *dst = NULL;
+
+	if (page_idx >= fobj->num_pages)
+		return TEE_ERROR_BAD_PARAMETERS;
+	if (cow_page_is_private(f, page_idx))
+		return TEE_SUCCESS;
+
+	/*
+	 * This is normally called from the abort handler with foreign
+	 * interrupts masked. tee_mm_alloc() takes the malloc lock (via
+	 * pmalloc()) and the tee_mm_sec_ddr pool lock, both are spinlocks
+	 * which are only held for short sections that never touch user
+	 * memory. The aborting context is user mode or core code
+	 * accessing user memory, so it can't be holding either of them
+	 * and we can't deadlock on ourselves, see handle_cow_fault().
+	 *
+	 * The parent isn't modified while referenced so the copy can be
+	 * made without holding the lock.
+	 */
+	mm = tee_mm_alloc(&tee_mm_sec_ddr, SMALL_PAGE_SIZE);
+	if (!mm)
+		return TEE_ERROR_OUT_OF_MEMORY;
+
+	src_pa = f->parent->ops->get_pa(f->parent, page_idx);
+	src = phys_to_virt(src_pa, MEM_AREA_TA_RAM, SMALL_PAGE_SIZE);
+	dst = phys_to_virt(tee_mm_get_smem(mm), MEM_AREA_TA_RAM,
+			   SMALL_PAGE_SIZE);
+	if (!src || !dst) {
+		tee_mm_free(mm);
+		return TEE_ERROR_GENERIC;
+	}
+	memcpy(dst, src, SMALL_PAGE_SIZE);
+
+	exceptions = cpu_spin_lock_xsave(&f->lock);
+	if (f->pages[page_idx]) {
+		/* Another thread got here first, use its copy */
+		cpu_spin_unlock_xrestore(&f->lock, exceptions);
+		tee_mm_free(mm);
+		return TEE_SUCCESS;
+	}
+	f->pages[page_idx] = mm;
+	cpu_spin_unlock_xrestore(&f->lock, exceptions);
+
+	cow_stats_update(0, 1, 1);
+
+	return TEE_SUCCESS;
+}
+
+bool fobj_cow_page_is_shared(struct fobj *fobj, unsigned int page_idx)
+{
+	if (fobj->ops != &ops_cow)
+		return false;
+
+	assert(page_idx < fobj->num_pages);
+
+	return !cow_page_is_private(to_cow(fobj), page_idx);
+}
+
+void fobj_cow_get_stats(struct fobj_cow_stats *stats)
+{
+	uint32_t exceptions = cpu_spin_lock_xsave(&cow_stats_lock);
+
+	*stats = cow_stats;
+	cpu_spin_unlock_xrestore(&cow_stats_lock, exceptions);
+}
+
+/*
+ * Note: this variable is weak just to ease breaking its dependency chain
+ * when added to the unpaged area.
+ */
+const struct fobj_ops ops_cow __weak __rodata_unpaged("ops_cow") = {
+	.free = cow_free,
+	.get_pa = cow_get_pa,
+};
+
+#endif /*CFG_TA_SHARE_RELOC_PAGES*/
+
 #endif /*PAGED_USER_TA*/
+
+static struct fobj *ta_mem_alloc(unsigned int num_pages)
+{
+#ifdef CFG_PAGED_USER_TA
+	return fobj_rw_paged_alloc(num_pages);
+#else
+	return fobj_sec_mem_alloc(num_pages);
+#endif
+}
+
+struct fobj *fobj_ta_mem_alloc(unsigned int num_pages)
+{
+	struct fobj *f = ta_mem_alloc(num_pages);
+
+	/* Cached TA binaries use the same pool, drop them and try again */
+	if (!f && ree_fs_ta_cache_shrink())
+		f = ta_mem_alloc(num_pages);
+
+	return f;
+}
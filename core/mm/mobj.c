@@ -625,6 +625,14 @@ static struct fobj *mobj_with_fobj_get_fobj(struct mobj *mobj)
 	return fobj_get(to_mobj_with_fobj(mobj)->fobj);
 }
 
+struct file *mobj_with_fobj_get_file(struct mobj *mobj)
+{
+	if (mobj->ops != &mobj_with_fobj_ops)
+		return NULL;
+
+	return file_get(to_mobj_with_fobj(mobj)->file);
+}
+
 static TEE_Result mobj_with_fobj_get_cattr(struct mobj *mobj __unused,
 					   uint32_t *cattr)
 {
@@ -17,6 +17,7 @@
 #include <kernel/virtualization.h>
 #include <mm/core_memprot.h>
 #include <mm/core_mmu.h>
+#include <mm/fobj.h>
 #include <mm/mobj.h>
 #include <mm/pgt_cache.h>
 #include <mm/tee_mm.h>
@@ -875,6 +876,8 @@ static TEE_Result param_mem_to_user_va(struct user_mode_ctx *uctx,
 			continue;
 		if (mem->mobj != region->mobj)
 			continue;
+		if (mem->readonly != !(region->attr & TEE_MATTR_UW))
+			continue;
 
 		phys_offs = mobj_get_phys_offs(mem->mobj,
 					       CORE_MMU_USER_PARAM_SIZE);
@@ -912,6 +915,10 @@ static int cmp_param_mem(const void *a0, const void *a1)
 	if (ret)
 		return ret;
 
+	ret = CMP_TRILEAN(m0->readonly, m1->readonly);
+	if (ret)
+		return ret;
+
 	ret = CMP_TRILEAN(m0->offs, m1->offs);
 	if (ret)
 		return ret;
@@ -939,6 +946,7 @@ TEE_Result vm_map_param(struct user_mode_ctx *uctx, struct tee_ta_param *param,
 		phys_offs = mobj_get_phys_offs(param->u[n].mem.mobj,
 					       CORE_MMU_USER_PARAM_SIZE);
 		mem[n].mobj = param->u[n].mem.mobj;
+		mem[n].readonly = param->u[n].mem.readonly;
 		mem[n].offs = ROUNDDOWN(phys_offs + param->u[n].mem.offs,
 					CORE_MMU_USER_PARAM_SIZE);
 		mem[n].size = ROUNDUP(phys_offs + param->u[n].mem.offs -
@@ -954,8 +962,8 @@ TEE_Result vm_map_param(struct user_mode_ctx *uctx, struct tee_ta_param *param,
 
 	/*
 	 * Sort arguments so NULL mobj is last, secure mobjs first, then by
-	 * mobj pointer value since those entries can't be merged either,
-	 * finally by offset.
+	 * mobj pointer value and access rights since those entries can't be
+	 * merged either, finally by offset.
 	 *
 	 * This should result in a list where all mergeable entries are
 	 * next to each other and unused/invalid entries are at the end.
@@ -964,6 +972,7 @@ TEE_Result vm_map_param(struct user_mode_ctx *uctx, struct tee_ta_param *param,
 
 	for (n = 1, m = 0; n < TEE_NUM_PARAMS && mem[n].mobj; n++) {
 		if (mem[n].mobj == mem[m].mobj &&
+		    mem[n].readonly == mem[m].readonly &&
 		    (mem[n].offs == (mem[m].offs + mem[m].size) ||
 		     core_is_buffer_intersect(mem[m].offs, mem[m].size,
 					      mem[n].offs, mem[n].size))) {
@@ -985,10 +994,13 @@ TEE_Result vm_map_param(struct user_mode_ctx *uctx, struct tee_ta_param *param,
 	check_param_map_empty(uctx);
 
 	for (n = 0; n < m; n++) {
+		uint32_t prot = TEE_MATTR_PRW | TEE_MATTR_URW;
 		vaddr_t va = 0;
 
-		res = vm_map(uctx, &va, mem[n].size,
-			     TEE_MATTR_PRW | TEE_MATTR_URW,
+		if (mem[n].readonly)
+			prot = TEE_MATTR_PR | TEE_MATTR_UR;
+
+		res = vm_map(uctx, &va, mem[n].size, prot,
 			     VM_FLAG_EPHEMERAL | VM_FLAG_SHAREABLE,
 			     mem[n].mobj, mem[n].offs);
 		if (res)
@@ -1119,7 +1131,8 @@ TEE_Result vm_buf_to_mboj_offs(const struct user_mode_ctx *uctx,
 	struct vm_region *r = NULL;
 
 	TAILQ_FOREACH(r, &uctx->vm_info.regions, link) {
-		if (!r->mobj)
+		/* Pages shared copy-on-write must not be mapped elsewhere */
+		if (!r->mobj || (r->flags & VM_FLAG_COW))
 			continue;
 		if (core_is_buffer_inside((vaddr_t)va, size, r->va, r->size)) {
 			size_t poffs;
@@ -1281,6 +1294,55 @@ TEE_Result vm_check_access_rights(const struct user_mode_ctx *uctx,
 	return TEE_SUCCESS;
 }
 
+#ifdef CFG_TA_SHARE_RELOC_PAGES
+bool vm_region_page_is_cow(struct vm_region *r, size_t offs)
+{
+	struct fobj *fobj = NULL;
+	bool is_cow = false;
+
+	if (!(r->flags & VM_FLAG_COW))
+		return false;
+
+	fobj = mobj_get_fobj(r->mobj);
+	if (fobj)
+		is_cow = fobj_cow_page_is_shared(fobj, offs / SMALL_PAGE_SIZE);
+	fobj_put(fobj);
+
+	return is_cow;
+}
+
+bool vm_handle_cow_fault(struct user_mode_ctx *uctx, vaddr_t va)
+{
+	vaddr_t page_va = ROUNDDOWN(va, SMALL_PAGE_SIZE);
+	struct vm_region *r = find_vm_region(&uctx->vm_info, va);
+	struct fobj *fobj = NULL;
+	TEE_Result res = TEE_SUCCESS;
+	size_t offs = 0;
+	paddr_t pa = 0;
+
+	if (!r || !(r->flags & VM_FLAG_COW) || !(r->attr & TEE_MATTR_UW))
+		return false;
+
+	offs = r->offset + page_va - r->va;
+	fobj = mobj_get_fobj(r->mobj);
+	if (!fobj)
+		return false;
+	res = fobj_cow_break(fobj, offs / SMALL_PAGE_SIZE);
+	fobj_put(fobj);
+	if (res) {
+		EMSG("Copy-on-write of va %#"PRIxVA" failed: %#"PRIx32,
+		     page_va, res);
+		return false;
+	}
+
+	if (mobj_get_pa(r->mobj, offs, SMALL_PAGE_SIZE, &pa))
+		panic();
+	core_mmu_set_user_page(page_va, pa, r->attr);
+
+	return true;
+}
+#endif /*CFG_TA_SHARE_RELOC_PAGES*/
+
 void vm_set_ctx(struct ts_ctx *ctx)
 {
 	struct thread_specific_data *tsd = thread_get_tsd();
@@ -1317,7 +1379,7 @@ struct mobj *vm_get_mobj(struct user_mode_ctx *uctx, vaddr_t va, size_t *len,
 		return NULL;
 
 	r = find_vm_region(&uctx->vm_info, va);
-	if (!r)
+	if (!r || (r->flags & VM_FLAG_COW))
 		return NULL;
 
 	r_offs = va - r->va;
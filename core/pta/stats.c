@@ -3,9 +3,14 @@
  * Copyright (c) 2015, Linaro Limited
  */
 #include <compiler.h>
+#include <config.h>
 #include <stdio.h>
 #include <trace.h>
+#include <kernel/boot_profile.h>
 #include <kernel/pseudo_ta.h>
+#include <kernel/thread.h>
+#include <mm/file.h>
+#include <mm/fobj.h>
 #include <mm/tee_pager.h>
 #include <mm/tee_mm.h>
 #include <string.h>
@@ -21,6 +26,10 @@
 #define STATS_CMD_PAGER_STATS		0
 #define STATS_CMD_ALLOC_STATS		1
 #define STATS_CMD_MEMLEAK_STATS		2
+#define STATS_CMD_THREAD_ADMISSION_STATS	3
+#define STATS_CMD_THREAD_CORE_STATS		4
+#define STATS_CMD_BOOT_PROFILE			5
+#define STATS_CMD_TA_SHARED_RELOC_PAGES		6
 
 #define STATS_NB_POOLS			4
 
@@ -137,6 +146,142 @@ static TEE_Result get_memleak_stats(uint32_t type,
 	return TEE_SUCCESS;
 }
 
+static TEE_Result get_thread_admission_stats(uint32_t type,
+					     TEE_Param p[TEE_NUM_PARAMS])
+{
+	struct thread_admission_stats stats = { };
+
+	/*
+	 * p[0].value.a = current queue depth
+	 * p[0].value.b = max queue depth
+	 * p[1].value.a = number of calls admitted after waiting
+	 * p[1].value.b = number of calls dropped or refused by the queue
+	 * p[2].value.a = average wait time in microseconds
+	 * p[2].value.b = max wait time in microseconds
+	 */
+	if (TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_NONE) != type)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	if (!IS_ENABLED(CFG_CORE_THREAD_ADMISSION))
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	thread_get_admission_stats(&stats);
+	p[0].value.a = stats.depth;
+	p[0].value.b = stats.max_depth;
+	p[1].value.a = stats.admitted;
+	p[1].value.b = stats.expired + stats.overflows;
+	p[2].value.a = stats.avg_wait_us;
+	p[2].value.b = stats.max_wait_us;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result get_thread_core_stats(uint32_t type,
+					TEE_Param p[TEE_NUM_PARAMS])
+{
+	struct thread_core_stats stats = { };
+
+	/*
+	 * p[0].value.a = core position
+	 * p[0].value.b = number of cores
+	 * p[1].value.a = number of threads allocated on the core
+	 * p[1].value.b = number of those last run on another core
+	 * p[2].value.a = number of threads resumed on the core
+	 * p[2].value.b = number of those last run on another core
+	 */
+	if (TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_INOUT,
+			    TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_NONE) != type)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	if (p[0].value.a >= CFG_TEE_CORE_NB_CORE)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	thread_get_core_stats(p[0].value.a, &stats);
+	p[0].value.b = CFG_TEE_CORE_NB_CORE;
+	p[1].value.a = stats.allocs;
+	p[1].value.b = stats.alloc_migrations;
+	p[2].value.a = stats.resumes;
+	p[2].value.b = stats.resume_migrations;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result get_boot_profile(uint32_t type, TEE_Param p[TEE_NUM_PARAMS])
+{
+	const size_t rec_size = sizeof(struct boot_profile_record);
+	size_t num_recs = 0;
+	size_t dropped = 0;
+	size_t total = 0;
+
+	/*
+	 * p[0].value.a = [in] index of the first record to retrieve
+	 *                [out] total number of records
+	 * p[0].value.b = [out] number of calls not recorded
+	 * p[1].memref.buffer = output array of struct boot_profile_record
+	 */
+	if (TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_INOUT,
+			    TEE_PARAM_TYPE_MEMREF_OUTPUT,
+			    TEE_PARAM_TYPE_NONE,
+			    TEE_PARAM_TYPE_NONE) != type)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	if (!IS_ENABLED(CFG_BOOT_PROFILE))
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	num_recs = p[1].memref.size / rec_size;
+	boot_profile_get_records(p[0].value.a, p[1].memref.buffer, &num_recs,
+				 &total, &dropped);
+	if (!num_recs && p[0].value.a < total) {
+		p[1].memref.size = (total - p[0].value.a) * rec_size;
+		return TEE_ERROR_SHORT_BUFFER;
+	}
+
+	p[0].value.a = total;
+	p[0].value.b = dropped;
+	p[1].memref.size = num_recs * rec_size;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result get_ta_shared_reloc_pages(uint32_t type,
+					    TEE_Param p[TEE_NUM_PARAMS])
+{
+	struct fobj_cow_stats stats = { };
+	size_t snapshot_pages = 0;
+
+	/*
+	 * p[0].value.a = number of pages held by relocated snapshots
+	 * p[0].value.b = number of pages mapped from snapshots by instances
+	 * p[1].value.a = number of pages saved, the difference of the above
+	 * p[1].value.b = number of private copies made on first write
+	 */
+	if (TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_VALUE_OUTPUT,
+			    TEE_PARAM_TYPE_NONE,
+			    TEE_PARAM_TYPE_NONE) != type)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	if (!IS_ENABLED(CFG_TA_SHARE_RELOC_PAGES))
+		return TEE_ERROR_NOT_SUPPORTED;
+
+	snapshot_pages = file_get_reloc_num_pages();
+	fobj_cow_get_stats(&stats);
+	p[0].value.a = snapshot_pages;
+	p[0].value.b = stats.shared_pages;
+	if (stats.shared_pages > snapshot_pages)
+		p[1].value.a = stats.shared_pages - snapshot_pages;
+	else
+		p[1].value.a = 0;
+	p[1].value.b = stats.num_breaks;
+
+	return TEE_SUCCESS;
+}
+
 /*
  * Trusted Application Entry Points
  */
@@ -152,6 +297,14 @@ static TEE_Result invoke_command(void *psess __unused,
 		return get_alloc_stats(ptypes, params);
 	case STATS_CMD_MEMLEAK_STATS:
 		return get_memleak_stats(ptypes, params);
+	case STATS_CMD_THREAD_ADMISSION_STATS:
+		return get_thread_admission_stats(ptypes, params);
+	case STATS_CMD_THREAD_CORE_STATS:
+		return get_thread_core_stats(ptypes, params);
+	case STATS_CMD_BOOT_PROFILE:
+		return get_boot_profile(ptypes, params);
+	case STATS_CMD_TA_SHARED_RELOC_PAGES:
+		return get_ta_shared_reloc_pages(ptypes, params);
 	default:
 		break;
 	}
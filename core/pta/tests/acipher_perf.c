@@ -0,0 +1,337 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <crypto/crypto.h>
+#include <malloc.h>
+#include <pta_invoke_tests.h>
+#include <string_ext.h>
+#include <tee_api_defines.h>
+#include <tee_api_types.h>
+#include <trace.h>
+#include <types_ext.h>
+#include <utee_defines.h>
+#include <util.h>
+
+#include "misc.h"
+
+/*
+ * Times one asymmetric operation repeatedly with freshly generated keys.
+ * Key generation is done once up front and isn't part of the measurement,
+ * so the numbers only reflect the operation itself. The message signed is
+ * a fixed 32-byte value, the size of a SHA-256 digest. ECDSA P-384 signs
+ * it as is, it doesn't need to match the curve size.
+ */
+
+struct acipher_perf_keys {
+	struct ecc_keypair ecc;
+	struct ecc_keypair ecc_peer;
+	struct ecc_public_key ecc_pub;
+	struct x25519_keypair x25519;
+	struct x25519_keypair x25519_peer;
+	struct ed25519_keypair ed25519;
+	struct rsa_keypair rsa;
+	struct rsa_public_key rsa_pub;
+};
+
+static const uint8_t perf_msg[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+/* The ECDH P-256 private keys 1 and n - 1, see PTA_INVOKE_TESTS_BENCH_KEY_* */
+static const uint8_t ecdh_p256_d[2][32] = {
+	{
+		[31] = 0x01
+	},
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84,
+		0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x50
+	}
+};
+
+static void free_ecc_keypair(struct ecc_keypair *key)
+{
+	crypto_bignum_free(key->d);
+	crypto_bignum_free(key->x);
+	crypto_bignum_free(key->y);
+}
+
+static bool is_ecdh(uint32_t algo)
+{
+	return algo == TEE_ALG_ECDH_P256 || algo == TEE_ALG_ECDH_P384;
+}
+
+static bool is_ecc(uint32_t algo)
+{
+	return is_ecdh(algo) || algo == TEE_ALG_ECDSA_P256 ||
+	       algo == TEE_ALG_ECDSA_P384;
+}
+
+static TEE_Result gen_ecc_keypair(struct ecc_keypair *key, uint32_t key_type,
+				  uint32_t curve, size_t key_size)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	res = crypto_acipher_alloc_ecc_keypair(key, key_type, key_size);
+	if (res)
+		return res;
+
+	key->curve = curve;
+	res = crypto_acipher_gen_ecc_key(key, key_size);
+	if (res)
+		free_ecc_keypair(key);
+
+	return res;
+}
+
+/*
+ * ECDH uses the public part of a second key pair as peer key, ECDSA
+ * verifies with the public part of the signing key.
+ */
+static TEE_Result init_ecc_keys(struct acipher_perf_keys *k, uint32_t algo)
+{
+	TEE_Result res = TEE_SUCCESS;
+	struct ecc_keypair *pub_src = &k->ecc;
+	uint32_t key_type = TEE_TYPE_ECDSA_KEYPAIR;
+	uint32_t pub_type = TEE_TYPE_ECDSA_PUBLIC_KEY;
+	uint32_t curve = TEE_ECC_CURVE_NIST_P256;
+	size_t key_size = 256;
+
+	if (is_ecdh(algo)) {
+		key_type = TEE_TYPE_ECDH_KEYPAIR;
+		pub_type = TEE_TYPE_ECDH_PUBLIC_KEY;
+	}
+	if (algo == TEE_ALG_ECDH_P384 || algo == TEE_ALG_ECDSA_P384) {
+		curve = TEE_ECC_CURVE_NIST_P384;
+		key_size = 384;
+	}
+
+	res = gen_ecc_keypair(&k->ecc, key_type, curve, key_size);
+	if (res)
+		return res;
+
+	if (is_ecdh(algo)) {
+		res = gen_ecc_keypair(&k->ecc_peer, key_type, curve, key_size);
+		if (res)
+			goto err_free_key;
+		pub_src = &k->ecc_peer;
+	}
+
+	res = crypto_acipher_alloc_ecc_public_key(&k->ecc_pub, pub_type,
+						  key_size);
+	if (res)
+		goto err_free_peer;
+	k->ecc_pub.curve = pub_src->curve;
+	crypto_bignum_copy(k->ecc_pub.x, pub_src->x);
+	crypto_bignum_copy(k->ecc_pub.y, pub_src->y);
+
+	return TEE_SUCCESS;
+
+err_free_peer:
+	if (is_ecdh(algo))
+		free_ecc_keypair(&k->ecc_peer);
+err_free_key:
+	free_ecc_keypair(&k->ecc);
+	return res;
+}
+
+static void free_ecc_keys(struct acipher_perf_keys *k, uint32_t algo)
+{
+	crypto_acipher_free_ecc_public_key(&k->ecc_pub);
+	if (is_ecdh(algo))
+		free_ecc_keypair(&k->ecc_peer);
+	free_ecc_keypair(&k->ecc);
+}
+
+/*
+ * RSA signatures with RSASSA-PKCS1-v1_5 and SHA-256, signing measures the
+ * private key operation and verification the public one with exponent
+ * 65537.
+ */
+static const uint8_t rsa_perf_e[] = { 0x01, 0x00, 0x01 };
+
+static TEE_Result gen_rsa_keys(struct rsa_keypair *key,
+			       struct rsa_public_key *pub, size_t key_size)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	res = crypto_acipher_alloc_rsa_keypair(key, key_size);
+	if (res)
+		return res;
+
+	res = crypto_bignum_bin2bn(rsa_perf_e, sizeof(rsa_perf_e), key->e);
+	if (res)
+		goto err_free_key;
+	res = crypto_acipher_gen_rsa_key(key, key_size);
+	if (res)
+		goto err_free_key;
+
+	res = crypto_acipher_alloc_rsa_public_key(pub, key_size);
+	if (res)
+		goto err_free_key;
+	crypto_bignum_copy(pub->e, key->e);
+	crypto_bignum_copy(pub->n, key->n);
+
+	return TEE_SUCCESS;
+
+err_free_key:
+	crypto_acipher_free_rsa_keypair(key);
+	return res;
+}
+
+static TEE_Result init_keys(struct acipher_perf_keys *k, uint32_t algo,
+			    size_t key_size)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	switch (algo) {
+	case TEE_ALG_ECDH_P256:
+	case TEE_ALG_ECDH_P384:
+	case TEE_ALG_ECDSA_P256:
+	case TEE_ALG_ECDSA_P384:
+		return init_ecc_keys(k, algo);
+	case TEE_ALG_X25519:
+		res = crypto_acipher_gen_x25519_key(&k->x25519, 256);
+		if (res)
+			return res;
+		return crypto_acipher_gen_x25519_key(&k->x25519_peer, 256);
+	case TEE_ALG_ED25519:
+		return crypto_acipher_gen_ed25519_key(&k->ed25519, 256);
+	case TEE_ALG_RSASSA_PKCS1_V1_5_SHA256:
+		return gen_rsa_keys(&k->rsa, &k->rsa_pub, key_size);
+	default:
+		return TEE_ERROR_BAD_PARAMETERS;
+	}
+}
+
+static void free_keys(struct acipher_perf_keys *k, uint32_t algo)
+{
+	if (is_ecc(algo))
+		free_ecc_keys(k, algo);
+	if (algo == TEE_ALG_RSASSA_PKCS1_V1_5_SHA256) {
+		crypto_acipher_free_rsa_public_key(&k->rsa_pub);
+		crypto_acipher_free_rsa_keypair(&k->rsa);
+	}
+	memzero_explicit(&k->x25519, sizeof(k->x25519));
+	memzero_explicit(&k->x25519_peer, sizeof(k->x25519_peer));
+	memzero_explicit(&k->ed25519, sizeof(k->ed25519));
+}
+
+static TEE_Result do_op(struct acipher_perf_keys *k, uint32_t algo,
+			TEE_OperationMode mode, uint8_t *out, size_t out_size,
+			size_t *sig_len)
+{
+	unsigned long ecdh_len = out_size;
+	size_t len = out_size;
+
+	switch (algo) {
+	case TEE_ALG_ECDH_P256:
+	case TEE_ALG_ECDH_P384:
+		return crypto_acipher_ecc_shared_secret(&k->ecc, &k->ecc_pub,
+							out, &ecdh_len);
+	case TEE_ALG_X25519:
+		return crypto_acipher_x25519_shared_secret(&k->x25519,
+							   k->x25519_peer.pub,
+							   out, &len);
+	case TEE_ALG_ECDSA_P256:
+	case TEE_ALG_ECDSA_P384:
+		if (mode == TEE_MODE_VERIFY)
+			return crypto_acipher_ecc_verify(algo, &k->ecc_pub,
+							 perf_msg,
+							 sizeof(perf_msg), out,
+							 *sig_len);
+		*sig_len = out_size;
+		return crypto_acipher_ecc_sign(algo, &k->ecc, perf_msg,
+					       sizeof(perf_msg), out, sig_len);
+	case TEE_ALG_ED25519:
+		if (mode == TEE_MODE_VERIFY)
+			return crypto_acipher_ed25519_verify(k->ed25519.pub,
+							     perf_msg,
+							     sizeof(perf_msg),
+							     out, *sig_len);
+		*sig_len = out_size;
+		return crypto_acipher_ed25519_sign(&k->ed25519, perf_msg,
+						   sizeof(perf_msg), out,
+						   sig_len);
+	case TEE_ALG_RSASSA_PKCS1_V1_5_SHA256:
+		if (mode == TEE_MODE_VERIFY)
+			return crypto_acipher_rsassa_verify(algo, &k->rsa_pub,
+							    -1, perf_msg,
+							    sizeof(perf_msg),
+							    out, *sig_len);
+		*sig_len = out_size;
+		return crypto_acipher_rsassa_sign(algo, &k->rsa, -1, perf_msg,
+						  sizeof(perf_msg), out,
+						  sig_len);
+	default:
+		return TEE_ERROR_BAD_PARAMETERS;
+	}
+}
+
+TEE_Result acipher_bench(struct crypto_bench *b)
+{
+	struct acipher_perf_keys keys = { };
+	TEE_Result res = TEE_SUCCESS;
+	TEE_OperationMode mode = TEE_MODE_DERIVE;
+	size_t out_size = 2 * 66;
+	uint8_t *out = NULL;
+	unsigned int n = 0;
+	size_t sig_len = 0;
+
+	if (TEE_ALG_GET_CLASS(b->algo) == TEE_OPERATION_ASYMMETRIC_SIGNATURE) {
+		mode = b->mode;
+		if (mode != TEE_MODE_SIGN && mode != TEE_MODE_VERIFY)
+			return TEE_ERROR_BAD_PARAMETERS;
+	}
+	if (b->algo == TEE_ALG_ECDH_P256 &&
+	    b->mode > PTA_INVOKE_TESTS_BENCH_KEY_N_MINUS_1)
+		return TEE_ERROR_BAD_PARAMETERS;
+	if (b->algo == TEE_ALG_RSASSA_PKCS1_V1_5_SHA256) {
+		if (b->key_size < 512 || b->key_size % 64 ||
+		    b->key_size > CFG_CORE_BIGNUM_MAX_BITS)
+			return TEE_ERROR_BAD_PARAMETERS;
+		out_size = b->key_size / 8;
+	}
+
+	out = malloc(out_size);
+	if (!out)
+		return TEE_ERROR_OUT_OF_MEMORY;
+
+	res = init_keys(&keys, b->algo, b->key_size);
+	if (res)
+		goto out_free;
+
+	/* The generated public part is unused, ECDH only needs d */
+	if (b->algo == TEE_ALG_ECDH_P256 &&
+	    b->mode != PTA_INVOKE_TESTS_BENCH_KEY_RANDOM) {
+		res = crypto_bignum_bin2bn(ecdh_p256_d[b->mode - 1],
+					   sizeof(ecdh_p256_d[0]), keys.ecc.d);
+		if (res)
+			goto out;
+	}
+
+	/* Verification needs a signature to check, make one untimed */
+	if (mode == TEE_MODE_VERIFY) {
+		res = do_op(&keys, b->algo, TEE_MODE_SIGN, out, out_size,
+			    &sig_len);
+		if (res)
+			goto out;
+	}
+
+	res = crypto_bench_start(b);
+	for (n = 0; !res && n < b->rep_count; n++)
+		res = do_op(&keys, b->algo, mode, out, out_size, &sig_len);
+	if (!res)
+		res = crypto_bench_stop(b);
+out:
+	free_keys(&keys, b->algo);
+out_free:
+	free(out);
+	return res;
+}
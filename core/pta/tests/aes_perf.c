@@ -42,7 +42,7 @@ static uint8_t aes_iv[] = {
 
 static void free_ctx(void **ctx, uint32_t algo)
 {
-	if (algo == TEE_ALG_AES_GCM)
+	if (TEE_ALG_GET_CLASS(algo) == TEE_OPERATION_AE)
 		crypto_authenc_free_ctx(*ctx);
 	else
 		crypto_cipher_free_ctx(*ctx);
@@ -77,6 +77,11 @@ static TEE_Result init_ctx(void **ctx, uint32_t algo, TEE_OperationMode mode,
 	case TEE_ALG_AES_CTR:
 		res = crypto_cipher_alloc_ctx(ctx, algo);
 		break;
+	case TEE_ALG_CHACHA20_POLY1305:
+		/* Only the 256-bit key variant exists */
+		if (key_len != sizeof(aes_key))
+			return TEE_ERROR_BAD_PARAMETERS;
+		fallthrough;
 	case TEE_ALG_AES_GCM:
 		res = crypto_authenc_alloc_ctx(ctx, algo);
 		break;
@@ -103,6 +108,11 @@ static TEE_Result init_ctx(void **ctx, uint32_t algo, TEE_OperationMode mode,
 					  sizeof(aes_iv), TEE_AES_BLOCK_SIZE,
 					  0, payload_len);
 		break;
+	case TEE_ALG_CHACHA20_POLY1305:
+		/* 96-bit nonce taken from the start of the AES IV */
+		res = crypto_authenc_init(*ctx, mode, aes_key, key_len, aes_iv,
+					  12, 16, 0, payload_len);
+		break;
 	default:
 		return TEE_ERROR_BAD_PARAMETERS;
 	}
@@ -138,7 +148,7 @@ static TEE_Result do_update(void *ctx, uint32_t algo, TEE_OperationMode mode,
 	unsigned int n = 0;
 	unsigned int m = 0;
 
-	if (algo == TEE_ALG_AES_GCM)
+	if (TEE_ALG_GET_CLASS(algo) == TEE_OPERATION_AE)
 		update_func = update_ae;
 	else
 		update_func = update_cipher;
@@ -220,3 +230,27 @@ TEE_Result core_aes_perf_tests(uint32_t param_types,
 	free_ctx(&ctx, algo);
 	return res;
 }
+
+/* Processes the buffer of @b in place, one update per repetition */
+TEE_Result cipher_bench(struct crypto_bench *b)
+{
+	TEE_Result res = TEE_SUCCESS;
+	void *ctx = NULL;
+
+	if (b->mode != TEE_MODE_ENCRYPT && b->mode != TEE_MODE_DECRYPT)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	res = init_ctx(&ctx, b->algo, b->mode, b->key_size, b->size);
+	if (res)
+		return res;
+
+	res = crypto_bench_start(b);
+	if (!res)
+		res = do_update(ctx, b->algo, b->mode, b->rep_count, b->size,
+				b->buf, b->size, b->buf);
+	if (!res)
+		res = crypto_bench_stop(b);
+
+	free_ctx(&ctx, b->algo);
+	return res;
+}
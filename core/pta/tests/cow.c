@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+/*
+ * Test of the copy-on-write fobj and the relocated snapshots kept by
+ * struct file. Two relocated segments are shared through the same
+ * snapshot and a page of one of them is broken with fobj_cow_break().
+ *
+ * This doesn't cover ldelf_syscall_share_reloc(), vm_handle_cow_fault()
+ * or the abort handler since that requires a user mode context, those
+ * are only exercised by loading the same TA twice.
+ */
+
+#include <mm/core_memprot.h>
+#include <mm/file.h>
+#include <mm/fobj.h>
+#include <string.h>
+#include <trace.h>
+
+#include "misc.h"
+
+#define TEST_NUM_PAGES	2
+#define TEST_VA		0x100000
+
+static const uint8_t test_tag[] = "core_cow_tests";
+
+static uint8_t *page_va(struct fobj *fobj, unsigned int page_idx)
+{
+	paddr_t pa = fobj->ops->get_pa(fobj, page_idx);
+
+	return phys_to_virt(pa, MEM_AREA_TA_RAM, SMALL_PAGE_SIZE);
+}
+
+/* Returns a segment as it could have been relocated by ldelf */
+static struct fobj *alloc_segment(void)
+{
+	struct fobj *fobj = fobj_ta_mem_alloc(TEST_NUM_PAGES);
+	unsigned int n = 0;
+
+	if (!fobj)
+		return NULL;
+
+	for (n = 0; n < TEST_NUM_PAGES; n++)
+		memset(page_va(fobj, n), n + 1, SMALL_PAGE_SIZE);
+
+	return fobj;
+}
+
+static bool segment_matches(struct fobj *a, struct fobj *b)
+{
+	unsigned int n = 0;
+
+	for (n = 0; n < TEST_NUM_PAGES; n++)
+		if (memcmp(page_va(a, n), page_va(b, n), SMALL_PAGE_SIZE))
+			return false;
+
+	return true;
+}
+
+/* Shares @seg via the snapshot in @file, donating @seg if none is found */
+static struct fobj *share_segment(struct file *file, struct fobj *seg)
+{
+	struct fobj *snap = file_find_reloc_slice(file, TEST_VA,
+						  TEST_NUM_PAGES);
+
+	if (snap) {
+		if (!segment_matches(snap, seg))
+			return NULL;
+		return fobj_cow_alloc(snap);
+	}
+
+	/* The first instance donates its pages as the snapshot */
+	if (file_add_reloc_slice(file, seg, TEST_VA))
+		return NULL;
+	return fobj_cow_alloc(seg);
+}
+
+static TEE_Result check_cow(struct fobj *snap, struct fobj *cow1,
+			    struct fobj *cow2)
+{
+	struct fobj_cow_stats stats_before = { };
+	struct fobj_cow_stats stats_after = { };
+	paddr_t snap_pa = 0;
+	paddr_t pa = 0;
+	unsigned int n = 0;
+
+	/* Both instances map the same physical pages */
+	for (n = 0; n < TEST_NUM_PAGES; n++) {
+		snap_pa = snap->ops->get_pa(snap, n);
+		if (!fobj_cow_page_is_shared(cow1, n) ||
+		    !fobj_cow_page_is_shared(cow2, n) ||
+		    cow1->ops->get_pa(cow1, n) != snap_pa ||
+		    cow2->ops->get_pa(cow2, n) != snap_pa) {
+			EMSG("Page %u not shared", n);
+			return TEE_ERROR_GENERIC;
+		}
+	}
+
+	/* Give the second instance a private copy of a page */
+	fobj_cow_get_stats(&stats_before);
+	if (fobj_cow_break(cow2, 1)) {
+		EMSG("fobj_cow_break() failed");
+		return TEE_ERROR_GENERIC;
+	}
+	fobj_cow_get_stats(&stats_after);
+
+	snap_pa = snap->ops->get_pa(snap, 1);
+	pa = cow2->ops->get_pa(cow2, 1);
+	if (fobj_cow_page_is_shared(cow2, 1) || pa == snap_pa ||
+	    memcmp(page_va(cow2, 1), page_va(snap, 1), SMALL_PAGE_SIZE)) {
+		EMSG("Page not split");
+		return TEE_ERROR_GENERIC;
+	}
+	if (stats_after.num_breaks == stats_before.num_breaks) {
+		EMSG("Split not counted");
+		return TEE_ERROR_GENERIC;
+	}
+
+	/* The private copy is kept on a second break */
+	if (fobj_cow_break(cow2, 1) || cow2->ops->get_pa(cow2, 1) != pa) {
+		EMSG("Private page replaced");
+		return TEE_ERROR_GENERIC;
+	}
+
+	/* The other pages and instance still use the snapshot */
+	if (!fobj_cow_page_is_shared(cow2, 0) ||
+	    !fobj_cow_page_is_shared(cow1, 1) ||
+	    cow1->ops->get_pa(cow1, 1) != snap_pa) {
+		EMSG("Unrelated page split");
+		return TEE_ERROR_GENERIC;
+	}
+
+	/* Writing to the private copy leaves the snapshot untouched */
+	memset(page_va(cow2, 1), 0xff, SMALL_PAGE_SIZE);
+	if (page_va(cow1, 1)[0] != 2 || page_va(snap, 1)[0] != 2) {
+		EMSG("Snapshot modified");
+		return TEE_ERROR_GENERIC;
+	}
+
+	return TEE_SUCCESS;
+}
+
+TEE_Result core_cow_tests(void)
+{
+	TEE_Result res = TEE_ERROR_OUT_OF_MEMORY;
+	struct file *file = NULL;
+	struct fobj *seg1 = NULL;
+	struct fobj *seg2 = NULL;
+	struct fobj *cow1 = NULL;
+	struct fobj *cow2 = NULL;
+	struct fobj *snap = NULL;
+
+	file = file_get_by_tag(test_tag, sizeof(test_tag));
+	seg1 = alloc_segment();
+	seg2 = alloc_segment();
+	if (!file || !seg1 || !seg2)
+		goto out;
+
+	/*
+	 * The file stays locked during the test, so a concurrent run of
+	 * the test may only find the snapshot of the first one.
+	 */
+	file_lock(file);
+	cow1 = share_segment(file, seg1);
+	cow2 = share_segment(file, seg2);
+	snap = file_find_reloc_slice(file, TEST_VA, TEST_NUM_PAGES);
+	if (cow1 && cow2 && snap) {
+		res = check_cow(snap, cow1, cow2);
+	} else {
+		EMSG("Segments not shared");
+		res = TEE_ERROR_GENERIC;
+	}
+	file_unlock(file);
+
+out:
+	fobj_put(cow1);
+	fobj_put(cow2);
+	fobj_put(seg1);
+	fobj_put(seg2);
+	file_put(file);
+
+	return res;
+}
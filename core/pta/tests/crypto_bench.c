@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <kernel/tee_time.h>
+#include <tee_api_defines.h>
+#include <tee_api_types.h>
+#include <utee_defines.h>
+#include <util.h>
+
+#include "misc.h"
+
+/*
+ * Dispatches PTA_INVOKE_TESTS_CMD_CRYPTO_BENCH on the class of the
+ * algorithm. The per-algorithm functions do their setup, then run the
+ * repetitions between crypto_bench_start() and crypto_bench_stop() so
+ * that all algorithms are timed the same way.
+ */
+
+TEE_Result crypto_bench_start(struct crypto_bench *b)
+{
+	return tee_time_get_sys_time(&b->begin);
+}
+
+TEE_Result crypto_bench_stop(struct crypto_bench *b)
+{
+	return tee_time_get_sys_time(&b->end);
+}
+
+TEE_Result core_crypto_bench_tests(uint32_t param_types,
+				   TEE_Param params[TEE_NUM_PARAMS])
+{
+	uint32_t exp_param_types = TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_INPUT,
+						   TEE_PARAM_TYPE_VALUE_INPUT,
+						   TEE_PARAM_TYPE_VALUE_OUTPUT,
+						   TEE_PARAM_TYPE_NONE);
+	uint32_t cipher_param_types =
+		TEE_PARAM_TYPES(TEE_PARAM_TYPE_VALUE_INPUT,
+				TEE_PARAM_TYPE_VALUE_INPUT,
+				TEE_PARAM_TYPE_VALUE_OUTPUT,
+				TEE_PARAM_TYPE_MEMREF_INOUT);
+	struct crypto_bench b = { };
+	TEE_Result res = TEE_SUCCESS;
+	TEE_Time elapsed = { };
+	uint64_t bytes = 0;
+	uint64_t us = 0;
+
+	b.algo = params[0].value.a;
+	b.mode = params[0].value.b;
+	b.rep_count = params[1].value.a;
+	b.key_size = params[1].value.b;
+	if (!b.rep_count)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	switch (TEE_ALG_GET_CLASS(b.algo)) {
+	case TEE_OPERATION_CIPHER:
+	case TEE_OPERATION_AE:
+		if (param_types != cipher_param_types ||
+		    !params[3].memref.size)
+			return TEE_ERROR_BAD_PARAMETERS;
+		b.buf = params[3].memref.buffer;
+		b.size = params[3].memref.size;
+		res = cipher_bench(&b);
+		break;
+	case TEE_OPERATION_ASYMMETRIC_SIGNATURE:
+	case TEE_OPERATION_KEY_DERIVATION:
+		if (param_types != exp_param_types)
+			return TEE_ERROR_BAD_PARAMETERS;
+		res = acipher_bench(&b);
+		break;
+	default:
+		return TEE_ERROR_BAD_PARAMETERS;
+	}
+	if (res)
+		return res;
+
+	TEE_TIME_SUB(b.end, b.begin, elapsed);
+	us = ((uint64_t)elapsed.seconds * 1000 + elapsed.millis) * 1000;
+
+	params[2].value.a = MIN(us, (uint64_t)UINT32_MAX);
+	params[2].value.b = 0;
+	if (b.size) {
+		bytes = (uint64_t)b.rep_count * b.size;
+		if (us > UINT64_MAX / 1000000)
+			params[2].value.b = UINT32_MAX;
+		else
+			params[2].value.b = MIN(us * 1000000 / bytes,
+						(uint64_t)UINT32_MAX);
+	} else if (us) {
+		params[2].value.b = MIN((uint64_t)b.rep_count * 1000000 / us,
+					(uint64_t)UINT32_MAX);
+	}
+
+	return TEE_SUCCESS;
+}
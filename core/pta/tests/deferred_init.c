@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+/*
+ * Test of deferred initializations, the entries are added the first time
+ * the test runs and must then be run exactly once regardless of how many
+ * times they're waited for.
+ */
+
+#include <kernel/deferred_init.h>
+#include <kernel/mutex.h>
+#include <trace.h>
+
+#include "misc.h"
+
+static unsigned int num_a_runs;
+static unsigned int num_b_runs;
+static unsigned int num_c_runs;
+
+static struct deferred_init test_b;
+
+static TEE_Result test_a_init(struct deferred_init *di __unused)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	/* @test_b must be done before @test_a */
+	res = deferred_init_wait(&test_b);
+	num_a_runs++;
+
+	return res;
+}
+
+static TEE_Result test_b_init(struct deferred_init *di __unused)
+{
+	num_b_runs++;
+
+	return TEE_SUCCESS;
+}
+
+static TEE_Result test_c_init(struct deferred_init *di __unused)
+{
+	num_c_runs++;
+
+	return TEE_ERROR_NOT_SUPPORTED;
+}
+
+static struct deferred_init test_a =
+	DEFERRED_INIT_INITIALIZER("test_a", test_a_init);
+static struct deferred_init test_b =
+	DEFERRED_INIT_INITIALIZER("test_b", test_b_init);
+static struct deferred_init test_c =
+	DEFERRED_INIT_INITIALIZER("test_c", test_c_init);
+
+static bool test_added;
+static struct mutex test_added_mu = MUTEX_INITIALIZER;
+
+TEE_Result core_deferred_init_tests(void)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	mutex_lock(&test_added_mu);
+	if (!test_added) {
+		deferred_init_add(&test_c);
+		deferred_init_add(&test_b);
+		deferred_init_add(&test_a);
+		test_added = true;
+	}
+	mutex_unlock(&test_added_mu);
+
+	res = deferred_init_wait(&test_a);
+	if (res) {
+		EMSG("test_a: unexpected result %#"PRIx32, res);
+		return TEE_ERROR_GENERIC;
+	}
+	if (test_b.state != DEFERRED_INIT_DONE) {
+		EMSG("test_b not done after test_a");
+		return TEE_ERROR_GENERIC;
+	}
+
+	res = deferred_init_wait(&test_c);
+	if (res != TEE_ERROR_NOT_SUPPORTED) {
+		EMSG("test_c: unexpected result %#"PRIx32, res);
+		return TEE_ERROR_GENERIC;
+	}
+
+	/* Once done, the result is returned without running it again */
+	if (deferred_init_wait(&test_b) || deferred_init_wait(&test_a) ||
+	    deferred_init_wait(&test_c) != TEE_ERROR_NOT_SUPPORTED ||
+	    num_a_runs != 1 || num_b_runs != 1 || num_c_runs != 1) {
+		EMSG("Runs: a %u b %u c %u", num_a_runs, num_b_runs,
+		     num_c_runs);
+		return TEE_ERROR_GENERIC;
+	}
+
+	return TEE_SUCCESS;
+}
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+#include <crypto/crypto.h>
+#include <inttypes.h>
+#include <string.h>
+#include <tee_api_defines.h>
+#include <tee_api_types.h>
+#include <trace.h>
+#include <types_ext.h>
+
+#include "misc.h"
+
+/*
+ * Known answer tests of the P-256 ECDSA and ECDH operations,
+ * through the same crypto_acipher_*() interface the syscalls use.
+ */
+
+/* RFC 6979 A.2.5, private key and public key */
+static const uint8_t kat_d[] = {
+	0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16,
+	0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+	0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12,
+	0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21
+};
+
+static const uint8_t kat_ux[] = {
+	0x60, 0xFE, 0xD4, 0xBA, 0x25, 0x5A, 0x9D, 0x31,
+	0xC9, 0x61, 0xEB, 0x74, 0xC6, 0x35, 0x6D, 0x68,
+	0xC0, 0x49, 0xB8, 0x92, 0x3B, 0x61, 0xFA, 0x6C,
+	0xE6, 0x69, 0x62, 0x2E, 0x60, 0xF2, 0x9F, 0xB6
+};
+
+static const uint8_t kat_uy[] = {
+	0x79, 0x03, 0xFE, 0x10, 0x08, 0xB8, 0xBC, 0x99,
+	0xA4, 0x1A, 0xE9, 0xE9, 0x56, 0x28, 0xBC, 0x64,
+	0xF2, 0xF1, 0xB2, 0x0C, 0x2D, 0x7E, 0x9F, 0x51,
+	0x77, 0xA3, 0xC2, 0x94, 0xD4, 0x46, 0x22, 0x99
+};
+
+/* SHA-256("sample") and its signature with k from RFC 6979 */
+static const uint8_t kat_digest[] = {
+	0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1,
+	0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+	0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15,
+	0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+};
+
+static const uint8_t kat_sig[] = {
+	0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD,
+	0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6,
+	0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA, 0xF9, 0x91,
+	0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16,
+	0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41,
+	0xD4, 0x36, 0xC7, 0xA1, 0xB6, 0xE2, 0x9F, 0x65,
+	0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06,
+	0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8
+};
+
+/*
+ * RFC 5903 8.1, 256-bit Random ECP Group: the private key i, the
+ * responder's public key g^r and the shared secret x coordinate g^ir
+ */
+static const uint8_t ecdh_d[] = {
+	0xC8, 0x8F, 0x01, 0xF5, 0x10, 0xD9, 0xAC, 0x3F,
+	0x70, 0xA2, 0x92, 0xDA, 0xA2, 0x31, 0x6D, 0xE5,
+	0x44, 0xE9, 0xAA, 0xB8, 0xAF, 0xE8, 0x40, 0x49,
+	0xC6, 0x2A, 0x9C, 0x57, 0x86, 0x2D, 0x14, 0x33
+};
+
+static const uint8_t ecdh_peer_x[] = {
+	0xD1, 0x2D, 0xFB, 0x52, 0x89, 0xC8, 0xD4, 0xF8,
+	0x12, 0x08, 0xB7, 0x02, 0x70, 0x39, 0x8C, 0x34,
+	0x22, 0x96, 0x97, 0x0A, 0x0B, 0xCC, 0xB7, 0x4C,
+	0x73, 0x6F, 0xC7, 0x55, 0x44, 0x94, 0xBF, 0x63
+};
+
+static const uint8_t ecdh_peer_y[] = {
+	0x56, 0xFB, 0xF3, 0xCA, 0x36, 0x6C, 0xC2, 0x3E,
+	0x81, 0x57, 0x85, 0x4C, 0x13, 0xC5, 0x8D, 0x6A,
+	0xAC, 0x23, 0xF0, 0x46, 0xAD, 0xA3, 0x0F, 0x83,
+	0x53, 0xE7, 0x4F, 0x33, 0x03, 0x98, 0x72, 0xAB
+};
+
+static const uint8_t ecdh_secret[] = {
+	0xD6, 0x84, 0x0F, 0x6B, 0x42, 0xF6, 0xED, 0xAF,
+	0xD1, 0x31, 0x16, 0xE0, 0xE1, 0x25, 0x65, 0x20,
+	0x2F, 0xEF, 0x8E, 0x9E, 0xCE, 0x7D, 0xCE, 0x03,
+	0x81, 0x24, 0x64, 0xD0, 0x4B, 0x94, 0x42, 0xDE
+};
+
+static TEE_Result alloc_keypair(struct ecc_keypair *key, uint32_t key_type,
+				const uint8_t *d)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	res = crypto_acipher_alloc_ecc_keypair(key, key_type, 256);
+	if (res)
+		return res;
+
+	key->curve = TEE_ECC_CURVE_NIST_P256;
+	res = crypto_bignum_bin2bn(d, 32, key->d);
+	if (res) {
+		crypto_bignum_free(key->d);
+		crypto_bignum_free(key->x);
+		crypto_bignum_free(key->y);
+	}
+
+	return res;
+}
+
+static void free_keypair(struct ecc_keypair *key)
+{
+	crypto_bignum_free(key->d);
+	crypto_bignum_free(key->x);
+	crypto_bignum_free(key->y);
+}
+
+static TEE_Result alloc_public_key(struct ecc_public_key *key,
+				   uint32_t key_type, const uint8_t *x,
+				   const uint8_t *y)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	res = crypto_acipher_alloc_ecc_public_key(key, key_type, 256);
+	if (res)
+		return res;
+
+	key->curve = TEE_ECC_CURVE_NIST_P256;
+	res = crypto_bignum_bin2bn(x, 32, key->x);
+	if (!res)
+		res = crypto_bignum_bin2bn(y, 32, key->y);
+	if (res)
+		crypto_acipher_free_ecc_public_key(key);
+
+	return res;
+}
+
+static TEE_Result test_ecdsa_verify(void)
+{
+	struct ecc_public_key pub = { };
+	uint8_t sig[sizeof(kat_sig)] = { };
+	TEE_Result res = TEE_SUCCESS;
+
+	res = alloc_public_key(&pub, TEE_TYPE_ECDSA_PUBLIC_KEY, kat_ux,
+			       kat_uy);
+	if (res)
+		return res;
+
+	res = crypto_acipher_ecc_verify(TEE_ALG_ECDSA_P256, &pub, kat_digest,
+					sizeof(kat_digest), kat_sig,
+					sizeof(kat_sig));
+	if (res) {
+		EMSG("ECDSA P-256 verify: %#"PRIx32, res);
+		goto out;
+	}
+
+	/* A modified signature must not verify */
+	memcpy(sig, kat_sig, sizeof(sig));
+	sig[sizeof(sig) - 1] ^= 1;
+	if (crypto_acipher_ecc_verify(TEE_ALG_ECDSA_P256, &pub, kat_digest,
+				      sizeof(kat_digest), sig,
+				      sizeof(sig)) != TEE_ERROR_SIGNATURE_INVALID) {
+		EMSG("ECDSA P-256 verify: modified signature accepted");
+		res = TEE_ERROR_GENERIC;
+	}
+out:
+	crypto_acipher_free_ecc_public_key(&pub);
+	return res;
+}
+
+/* Sign with the KAT key and check the result against its public key */
+static TEE_Result test_ecdsa_sign(void)
+{
+	struct ecc_public_key pub = { };
+	struct ecc_keypair key = { };
+	uint8_t sig[64] = { };
+	size_t sig_len = sizeof(sig);
+	TEE_Result res = TEE_SUCCESS;
+
+	res = alloc_keypair(&key, TEE_TYPE_ECDSA_KEYPAIR, kat_d);
+	if (res)
+		return res;
+	res = alloc_public_key(&pub, TEE_TYPE_ECDSA_PUBLIC_KEY, kat_ux,
+			       kat_uy);
+	if (res)
+		goto out_free_key;
+
+	res = crypto_acipher_ecc_sign(TEE_ALG_ECDSA_P256, &key, kat_digest,
+				      sizeof(kat_digest), sig, &sig_len);
+	if (!res)
+		res = crypto_acipher_ecc_verify(TEE_ALG_ECDSA_P256, &pub,
+						kat_digest, sizeof(kat_digest),
+						sig, sig_len);
+	if (res)
+		EMSG("ECDSA P-256 sign: %#"PRIx32, res);
+
+	crypto_acipher_free_ecc_public_key(&pub);
+out_free_key:
+	free_keypair(&key);
+	return res;
+}
+
+static TEE_Result test_ecdh(void)
+{
+	struct ecc_public_key peer = { };
+	struct ecc_keypair key = { };
+	uint8_t secret[32] = { };
+	unsigned long secret_len = sizeof(secret);
+	TEE_Result res = TEE_SUCCESS;
+
+	res = alloc_keypair(&key, TEE_TYPE_ECDH_KEYPAIR, ecdh_d);
+	if (res)
+		return res;
+	res = alloc_public_key(&peer, TEE_TYPE_ECDH_PUBLIC_KEY, ecdh_peer_x,
+			       ecdh_peer_y);
+	if (res)
+		goto out_free_key;
+
+	res = crypto_acipher_ecc_shared_secret(&key, &peer, secret,
+					       &secret_len);
+	if (res) {
+		EMSG("ECDH P-256: %#"PRIx32, res);
+	} else if (secret_len != sizeof(ecdh_secret) ||
+		   memcmp(secret, ecdh_secret, sizeof(ecdh_secret))) {
+		EMSG("ECDH P-256: wrong shared secret");
+		res = TEE_ERROR_GENERIC;
+	}
+
+	crypto_acipher_free_ecc_public_key(&peer);
+out_free_key:
+	free_keypair(&key);
+	return res;
+}
+
+TEE_Result core_ecc_p256_kat_tests(void)
+{
+	TEE_Result res = TEE_SUCCESS;
+
+	res = test_ecdsa_verify();
+	if (!res)
+		res = test_ecdsa_sign();
+	if (!res)
+		res = test_ecdh();
+
+	return res;
+}
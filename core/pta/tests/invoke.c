@@ -432,6 +432,8 @@ static TEE_Result invoke_command(void *pSessionContext __unused,
 		return core_lockdep_tests(nParamTypes, pParams);
 	case PTA_INVOKE_TEST_CMD_AES_PERF:
 		return core_aes_perf_tests(nParamTypes, pParams);
+	case PTA_INVOKE_TESTS_CMD_CRYPTO_BENCH:
+		return core_crypto_bench_tests(nParamTypes, pParams);
 	default:
 		break;
 	}
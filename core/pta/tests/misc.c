@@ -552,6 +552,8 @@ static int self_test_nex_malloc(void)
 TEE_Result core_self_tests(uint32_t nParamTypes __unused,
 		TEE_Param pParams[TEE_NUM_PARAMS] __unused)
 {
+	TEE_Result res = TEE_SUCCESS;
+
 	if (self_test_mul_signed_overflow() || self_test_add_overflow() ||
 	    self_test_sub_overflow() || self_test_mul_unsigned_overflow() ||
 	    self_test_division() || self_test_malloc() ||
@@ -559,5 +561,12 @@ TEE_Result core_self_tests(uint32_t nParamTypes __unused,
 		EMSG("some self_test_xxx failed! you should enable local LOG");
 		return TEE_ERROR_GENERIC;
 	}
-	return TEE_SUCCESS;
+
+	res = core_deferred_init_tests();
+	if (!res)
+		res = core_cow_tests();
+	if (!res)
+		res = core_ecc_p256_kat_tests();
+
+	return res;
 }
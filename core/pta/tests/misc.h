@@ -34,4 +34,51 @@ static inline TEE_Result core_lockdep_tests(
 TEE_Result core_aes_perf_tests(uint32_t param_types,
 			       TEE_Param params[TEE_NUM_PARAMS]);
 
+TEE_Result core_crypto_bench_tests(uint32_t param_types,
+				   TEE_Param params[TEE_NUM_PARAMS]);
+
+/*
+ * State of one PTA_INVOKE_TESTS_CMD_CRYPTO_BENCH run. The functions below
+ * run @rep_count operations between crypto_bench_start() and
+ * crypto_bench_stop(), @buf and @size are only used by ciphers.
+ */
+struct crypto_bench {
+	uint32_t algo;
+	uint32_t mode;
+	unsigned int rep_count;
+	size_t key_size;
+	void *buf;
+	size_t size;
+	TEE_Time begin;
+	TEE_Time end;
+};
+
+TEE_Result crypto_bench_start(struct crypto_bench *b);
+TEE_Result crypto_bench_stop(struct crypto_bench *b);
+TEE_Result cipher_bench(struct crypto_bench *b);
+TEE_Result acipher_bench(struct crypto_bench *b);
+
+/* Run by core_self_tests() */
+TEE_Result core_deferred_init_tests(void);
+
+/* Run by core_self_tests(), skipped without CFG_TA_SHARE_RELOC_PAGES */
+#ifdef CFG_TA_SHARE_RELOC_PAGES
+TEE_Result core_cow_tests(void);
+#else
+static inline TEE_Result core_cow_tests(void)
+{
+	return TEE_SUCCESS;
+}
+#endif
+
+/* Run by core_self_tests(), skipped without CFG_CRYPTO_ECC */
+#ifdef CFG_CRYPTO_ECC
+TEE_Result core_ecc_p256_kat_tests(void);
+#else
+static inline TEE_Result core_ecc_p256_kat_tests(void)
+{
+	return TEE_SUCCESS;
+}
+#endif
+
 #endif /*CORE_PTA_TESTS_MISC_H*/
@@ -1,7 +1,12 @@
 srcs-$(call cfg-all-enabled,CFG_REE_FS CFG_WITH_USER_TA) += fs_htree.c
 srcs-y += invoke.c
 srcs-$(CFG_LOCKDEP) += lockdep.c
+srcs-y += deferred_init.c
+srcs-$(CFG_TA_SHARE_RELOC_PAGES) += cow.c
 srcs-y += misc.c
 cflags-misc.c-y += -fno-builtin
 srcs-y += mutex.c
 srcs-y += aes_perf.c
+srcs-y += acipher_perf.c
+srcs-y += crypto_bench.c
+srcs-$(CFG_CRYPTO_ECC) += ecc_p256.c
@@ -19,16 +19,24 @@ recipe-ldelf = $(PYTHON3) scripts/gen_ldelf_hex.py --input $(out-dir)/ldelf/ldel
 			--output $(sub-dir-out)/ldelf_hex.c
 endif
 
+# Compression algorithm of an embedded TS, CFG_EMBEDDED_TS_COMPRESS_ALGO
+# unless overridden for a specific UUID with
+# EMBEDDED_TS_COMPRESS_ALGO_<uuid>
+emb-ts-compress-algo = $(or $(EMBEDDED_TS_COMPRESS_ALGO_$1), \
+			    $(CFG_EMBEDDED_TS_COMPRESS_ALGO))
+
 ifeq ($(CFG_WITH_USER_TA)-$(CFG_EARLY_TA),y-y)
-ifeq ($(CFG_EARLY_TA_COMPRESS),y)
-early-ta-compress = --compress
-endif
 define process_early_ta
 early-ta-$1-uuid := $(firstword $(subst ., ,$(notdir $1)))
+ifeq ($(CFG_EARLY_TA_COMPRESS),y)
+early-ta-$1-compress = --compress \
+	$$(strip $$(call emb-ts-compress-algo,$$(early-ta-$1-uuid)))
+endif
 gensrcs-y += early-ta-$1
 produce-early-ta-$1 = early_ta_$$(early-ta-$1-uuid).c
-depends-early-ta-$1 = $1 scripts/ts_bin_to_c.py
-recipe-early-ta-$1 = $(PYTHON3) scripts/ts_bin_to_c.py $(early-ta-compress) \
+depends-early-ta-$1 = $1 scripts/ts_bin_to_c.py scripts/lz4_pack.py
+recipe-early-ta-$1 = $(PYTHON3) scripts/ts_bin_to_c.py \
+		$$(early-ta-$1-compress) \
 		--ta $1 --out $(sub-dir-out)/early_ta_$$(early-ta-$1-uuid).c
 endef
 $(foreach f, $(EARLY_TA_PATHS), $(eval $(call process_early_ta,$(f))))
@@ -40,9 +48,10 @@ define process_secure_partition
 sp-$1-uuid := $(firstword $(subst ., ,$(notdir $1)))
 gensrcs-y += sp-$1
 produce-sp-$1 = sp_$$(sp-$1-uuid).c
-depends-sp-$1 = $1 scripts/ts_bin_to_c.py
-recipe-sp-$1 = $(PYTHON3) scripts/ts_bin_to_c.py --compress --sp $1 \
-		--out $(sub-dir-out)/sp_$$(sp-$1-uuid).c
+depends-sp-$1 = $1 scripts/ts_bin_to_c.py scripts/lz4_pack.py
+recipe-sp-$1 = $(PYTHON3) scripts/ts_bin_to_c.py \
+		--compress $$(strip $$(call emb-ts-compress-algo,$$(sp-$1-uuid))) \
+		--sp $1 --out $(sub-dir-out)/sp_$$(sp-$1-uuid).c
 endef
 $(foreach f, $(SP_PATHS), $(eval $(call process_secure_partition,$(f))))
 
@@ -79,8 +88,9 @@ endif
 ifneq ($(CFG_STMM_PATH),)
 gensrcs-y += stmm
 produce-stmm = stmm_hex.c
-depends-stmm = scripts/gen_stmm_hex.py $(CFG_STMM_PATH)
+depends-stmm = scripts/gen_stmm_hex.py scripts/lz4_pack.py $(CFG_STMM_PATH)
 recipe-stmm = scripts/gen_stmm_hex.py --input $(CFG_STMM_PATH) \
+			--compress $(CFG_STMM_COMPRESS_ALGO) \
 			--output $(sub-dir-out)/stmm_hex.c
 cleanfiles += $(sub-dir-out)/stmm_hex.c
 endif
@@ -9,6 +9,7 @@
 #include <compiler.h>
 #include <initcall.h>
 #include <io.h>
+#include <kernel/deferred_init.h>
 #include <kernel/linker.h>
 #include <kernel/msg_param.h>
 #include <kernel/notif.h>
@@ -554,6 +555,9 @@ uint32_t __tee_entry_std(struct optee_msg_arg *arg, uint32_t num_params)
 
 	/* Enable foreign interrupts for STD calls */
 	thread_set_foreign_intr(true);
+
+	deferred_init_schedule();
+
 	switch (arg->cmd) {
 	case OPTEE_MSG_CMD_OPEN_SESSION:
 		entry_open_session(arg, num_params);
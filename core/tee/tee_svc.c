@@ -604,11 +604,39 @@ static TEE_Result alloc_temp_sec_mem(size_t size, struct mobj **mobj,
 	return TEE_SUCCESS;
 }
 
+/*
+ * With CFG_TA_ZERO_COPY_PARAM=y a memref inside the private RAM of the
+ * calling TA is passed by reference to the called TA, the pages backing
+ * it are mapped into the called TA while the call is in progress. Input
+ * memrefs are mapped read-only. utee_param_to_param() has already
+ * checked that the caller has the access rights required by the
+ * parameter type and vm_buf_to_mboj_offs() only finds memory mapped by
+ * the caller. Returns false if the memref must be copied instead.
+ */
+static bool map_private_memref(struct user_ta_ctx *utc,
+			       struct tee_ta_param *param, size_t n)
+{
+	uint32_t param_type = TEE_PARAM_TYPE_GET(param->types, n);
+	struct param_mem *mem = &param->u[n].mem;
+	void *va = (void *)mem->offs;
+
+	if (!IS_ENABLED(CFG_TA_ZERO_COPY_PARAM))
+		return false;
+
+	if (vm_buf_to_mboj_offs(&utc->uctx, va, mem->size, &mem->mobj,
+				&mem->offs))
+		return false;
+
+	mem->readonly = (param_type == TEE_PARAM_TYPE_MEMREF_INPUT);
+	return true;
+}
+
 /*
  * TA invokes some TA with parameter.
  * If some parameters are memory references:
  * - either the memref is inside TA private RAM: TA is not allowed to expose
- *   its private RAM: use a temporary memory buffer and copy the data.
+ *   its private RAM: use a temporary memory buffer and copy the data,
+ *   unless the pages can be mapped with map_private_memref() above.
  * - or the memref is not in the TA private RAM:
  *   - if the memref was mapped to the TA, TA is allowed to expose it.
  *   - if so, converts memref virtual address into a physical address.
@@ -673,6 +701,8 @@ static TEE_Result tee_svc_copy_param(struct ts_session *sess,
 			}
 			/* uTA cannot expose its private memory */
 			if (vm_buf_is_inside_um_private(&utc->uctx, va, s)) {
+				if (map_private_memref(utc, param, n))
+					break;
 				s = ROUNDUP(s, sizeof(uint32_t));
 				if (ADD_OVERFLOW(req_mem, s, &req_mem))
 					return TEE_ERROR_BAD_PARAMETERS;
@@ -9,8 +9,10 @@
 #include <compiler.h>
 #include <config.h>
 #include <crypto/crypto.h>
+#include <kernel/handle.h>
 #include <kernel/tee_ta_manager.h>
 #include <kernel/user_access.h>
+#include <limits.h>
 #include <mm/vm.h>
 #include <stdlib_ext.h>
 #include <string_ext.h>
@@ -43,6 +45,7 @@ enum cryp_state {
 typedef void (*tee_cryp_ctx_finalize_func_t) (void *ctx);
 struct tee_cryp_state {
 	TAILQ_ENTRY(tee_cryp_state) link;
+	int handle;
 	uint32_t algo;
 	uint32_t mode;
 	vaddr_t key1;
@@ -78,6 +81,8 @@ struct tee_cryp_obj_secret {
 #define ATTR_OPS_INDEX_BIGNUM     1
     /* Convert to/from value attribute depending on direction */
 #define ATTR_OPS_INDEX_VALUE      2
+    /* Fixed size 32-byte Curve25519 (X25519/Ed25519) key values */
+#define ATTR_OPS_INDEX_25519      3
 
 struct tee_cryp_obj_type_attrs {
 	uint32_t attr_id;
@@ -383,6 +388,49 @@ static const struct tee_cryp_obj_type_attrs tee_cryp_obj_ecc_keypair_attrs[] = {
 	},
 };
 
+static const struct tee_cryp_obj_type_attrs tee_cryp_obj_x25519_keypair_attrs[] = {
+	{
+	.attr_id = TEE_ATTR_X25519_PRIVATE_VALUE,
+	.flags = TEE_TYPE_ATTR_REQUIRED | TEE_TYPE_ATTR_SIZE_INDICATOR,
+	.ops_index = ATTR_OPS_INDEX_25519,
+	RAW_DATA(struct x25519_keypair, priv)
+	},
+
+	{
+	.attr_id = TEE_ATTR_X25519_PUBLIC_VALUE,
+	.flags = TEE_TYPE_ATTR_REQUIRED,
+	.ops_index = ATTR_OPS_INDEX_25519,
+	RAW_DATA(struct x25519_keypair, pub)
+	},
+};
+
+static const struct tee_cryp_obj_type_attrs
+	tee_cryp_obj_ed25519_pub_key_attrs[] = {
+	{
+	.attr_id = TEE_ATTR_ED25519_PUBLIC_VALUE,
+	.flags = TEE_TYPE_ATTR_REQUIRED | TEE_TYPE_ATTR_SIZE_INDICATOR,
+	.ops_index = ATTR_OPS_INDEX_25519,
+	RAW_DATA(struct ed25519_public_key, pub)
+	},
+};
+
+static const struct tee_cryp_obj_type_attrs
+	tee_cryp_obj_ed25519_keypair_attrs[] = {
+	{
+	.attr_id = TEE_ATTR_ED25519_PRIVATE_VALUE,
+	.flags = TEE_TYPE_ATTR_REQUIRED | TEE_TYPE_ATTR_SIZE_INDICATOR,
+	.ops_index = ATTR_OPS_INDEX_25519,
+	RAW_DATA(struct ed25519_keypair, priv)
+	},
+
+	{
+	.attr_id = TEE_ATTR_ED25519_PUBLIC_VALUE,
+	.flags = TEE_TYPE_ATTR_REQUIRED,
+	.ops_index = ATTR_OPS_INDEX_25519,
+	RAW_DATA(struct ed25519_keypair, pub)
+	},
+};
+
 struct tee_cryp_obj_type_props {
 	TEE_ObjectType obj_type;
 	uint16_t min_size;	/* may not be smaller than this */
@@ -413,6 +461,9 @@ static const struct tee_cryp_obj_type_props tee_cryp_obj_props[] = {
 	PROP(TEE_TYPE_SM4, 128, 128, 128,
 		128 / 8 + sizeof(struct tee_cryp_obj_secret),
 		tee_cryp_obj_secret_value_attrs),
+	PROP(TEE_TYPE_CHACHA20, 8, 256, 256,
+		256 / 8 + sizeof(struct tee_cryp_obj_secret),
+		tee_cryp_obj_secret_value_attrs),
 	PROP(TEE_TYPE_HMAC_MD5, 8, 64, 512,
 		512 / 8 + sizeof(struct tee_cryp_obj_secret),
 		tee_cryp_obj_secret_value_attrs),
@@ -511,6 +562,18 @@ static const struct tee_cryp_obj_type_props tee_cryp_obj_props[] = {
 	PROP(TEE_TYPE_SM2_KEP_KEYPAIR, 1, 256, 256,
 	     sizeof(struct ecc_keypair),
 	     tee_cryp_obj_ecc_keypair_attrs),
+
+	PROP(TEE_TYPE_X25519_KEYPAIR, 8, 256, 256,
+	     sizeof(struct x25519_keypair),
+	     tee_cryp_obj_x25519_keypair_attrs),
+
+	PROP(TEE_TYPE_ED25519_PUBLIC_KEY, 8, 256, 256,
+	     sizeof(struct ed25519_public_key),
+	     tee_cryp_obj_ed25519_pub_key_attrs),
+
+	PROP(TEE_TYPE_ED25519_KEYPAIR, 8, 256, 256,
+	     sizeof(struct ed25519_keypair),
+	     tee_cryp_obj_ed25519_keypair_attrs),
 };
 
 struct attr_ops {
@@ -832,6 +895,88 @@ static void op_attr_value_clear(void *attr)
 	*v = 0;
 }
 
+#define CURVE25519_VALUE_SIZE	32
+
+static TEE_Result op_attr_25519_from_user(void *attr, const void *buffer,
+					  size_t size)
+{
+	if (size != CURVE25519_VALUE_SIZE)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	memcpy(attr, buffer, size);
+	return TEE_SUCCESS;
+}
+
+static TEE_Result op_attr_25519_to_user(void *attr,
+					struct ts_session *sess __unused,
+					void *buffer, uint64_t *size)
+{
+	TEE_Result res = TEE_SUCCESS;
+	uint64_t req_size = CURVE25519_VALUE_SIZE;
+	uint64_t s = 0;
+
+	res = copy_from_user(&s, size, sizeof(s));
+	if (res != TEE_SUCCESS)
+		return res;
+
+	res = copy_to_user(size, &req_size, sizeof(req_size));
+	if (res != TEE_SUCCESS)
+		return res;
+
+	if (s < req_size || !buffer)
+		return TEE_ERROR_SHORT_BUFFER;
+
+	return copy_to_user(buffer, attr, req_size);
+}
+
+static TEE_Result op_attr_25519_to_binary(void *attr, void *data,
+					  size_t data_len, size_t *offs)
+{
+	TEE_Result res = TEE_SUCCESS;
+	size_t next_offs = 0;
+
+	res = op_u32_to_binary_helper(CURVE25519_VALUE_SIZE, data, data_len,
+				      offs);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	if (ADD_OVERFLOW(*offs, CURVE25519_VALUE_SIZE, &next_offs))
+		return TEE_ERROR_OVERFLOW;
+
+	if (data && next_offs <= data_len)
+		memcpy((uint8_t *)data + *offs, attr, CURVE25519_VALUE_SIZE);
+	(*offs) = next_offs;
+
+	return TEE_SUCCESS;
+}
+
+static bool op_attr_25519_from_binary(void *attr, const void *data,
+				      size_t data_len, size_t *offs)
+{
+	uint32_t n = 0;
+
+	if (!op_u32_from_binary_helper(&n, data, data_len, offs))
+		return false;
+
+	if (n != CURVE25519_VALUE_SIZE || (*offs + n) > data_len)
+		return false;
+
+	memcpy(attr, (const uint8_t *)data + *offs, n);
+	(*offs) += n;
+	return true;
+}
+
+static TEE_Result op_attr_25519_from_obj(void *attr, void *src_attr)
+{
+	memcpy(attr, src_attr, CURVE25519_VALUE_SIZE);
+	return TEE_SUCCESS;
+}
+
+static void op_attr_25519_clear(void *attr)
+{
+	memzero_explicit(attr, CURVE25519_VALUE_SIZE);
+}
+
 static const struct attr_ops attr_ops[] = {
 	[ATTR_OPS_INDEX_SECRET] = {
 		.from_user = op_attr_secret_value_from_user,
@@ -860,6 +1005,15 @@ static const struct attr_ops attr_ops[] = {
 		.free = op_attr_value_clear, /* not a typo */
 		.clear = op_attr_value_clear,
 	},
+	[ATTR_OPS_INDEX_25519] = {
+		.from_user = op_attr_25519_from_user,
+		.to_user = op_attr_25519_to_user,
+		.to_binary = op_attr_25519_to_binary,
+		.from_binary = op_attr_25519_from_binary,
+		.from_obj = op_attr_25519_from_obj,
+		.free = op_attr_25519_clear, /* not a typo */
+		.clear = op_attr_25519_clear,
+	},
 };
 
 static TEE_Result get_user_u64_as_size_t(size_t *dst, uint64_t *src)
@@ -1157,6 +1311,9 @@ TEE_Result tee_obj_attr_copy_from(struct tee_obj *o, const struct tee_obj *src)
 		} else if (o->info.objectType == TEE_TYPE_SM2_KEP_PUBLIC_KEY) {
 			if (src->info.objectType != TEE_TYPE_SM2_KEP_KEYPAIR)
 				return TEE_ERROR_BAD_PARAMETERS;
+		} else if (o->info.objectType == TEE_TYPE_ED25519_PUBLIC_KEY) {
+			if (src->info.objectType != TEE_TYPE_ED25519_KEYPAIR)
+				return TEE_ERROR_BAD_PARAMETERS;
 		} else {
 			return TEE_ERROR_BAD_PARAMETERS;
 		}
@@ -1286,6 +1443,11 @@ TEE_Result tee_obj_set_type(struct tee_obj *o, uint32_t obj_type,
 		res = crypto_acipher_alloc_ecc_keypair(o->attr, obj_type,
 						       max_key_size);
 		break;
+	case TEE_TYPE_X25519_KEYPAIR:
+	case TEE_TYPE_ED25519_PUBLIC_KEY:
+	case TEE_TYPE_ED25519_KEYPAIR:
+		/* Fixed size keys, nothing to pre-allocate */
+		break;
 	default:
 		if (obj_type != TEE_TYPE_DATA) {
 			struct tee_cryp_obj_secret *key = o->attr;
@@ -1872,6 +2034,50 @@ static TEE_Result tee_svc_obj_generate_key_ecc(
 	return TEE_SUCCESS;
 }
 
+static TEE_Result tee_svc_obj_generate_key_x25519(
+	struct tee_obj *o, const struct tee_cryp_obj_type_props *type_props,
+	uint32_t key_size, const TEE_Attribute *params, uint32_t param_count)
+{
+	TEE_Result res;
+
+	/* Copy the present attributes into the obj before starting */
+	res = tee_svc_cryp_obj_populate_type(o, type_props, params,
+					     param_count);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	res = crypto_acipher_gen_x25519_key(o->attr, key_size);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	/* Set bits for the generated public and private key */
+	set_attribute(o, type_props, TEE_ATTR_X25519_PRIVATE_VALUE);
+	set_attribute(o, type_props, TEE_ATTR_X25519_PUBLIC_VALUE);
+	return TEE_SUCCESS;
+}
+
+static TEE_Result tee_svc_obj_generate_key_ed25519(
+	struct tee_obj *o, const struct tee_cryp_obj_type_props *type_props,
+	uint32_t key_size, const TEE_Attribute *params, uint32_t param_count)
+{
+	TEE_Result res;
+
+	/* Copy the present attributes into the obj before starting */
+	res = tee_svc_cryp_obj_populate_type(o, type_props, params,
+					     param_count);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	res = crypto_acipher_gen_ed25519_key(o->attr, key_size);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	/* Set bits for the generated public and private key */
+	set_attribute(o, type_props, TEE_ATTR_ED25519_PRIVATE_VALUE);
+	set_attribute(o, type_props, TEE_ATTR_ED25519_PUBLIC_VALUE);
+	return TEE_SUCCESS;
+}
+
 TEE_Result syscall_obj_generate_key(unsigned long obj, unsigned long key_size,
 			const struct utee_attribute *usr_params,
 			unsigned long param_count)
@@ -1928,6 +2134,7 @@ TEE_Result syscall_obj_generate_key(unsigned long obj, unsigned long key_size,
 	case TEE_TYPE_DES:
 	case TEE_TYPE_DES3:
 	case TEE_TYPE_SM4:
+	case TEE_TYPE_CHACHA20:
 	case TEE_TYPE_HMAC_MD5:
 	case TEE_TYPE_HMAC_SHA1:
 	case TEE_TYPE_HMAC_SHA224:
@@ -1992,6 +2199,20 @@ TEE_Result syscall_obj_generate_key(unsigned long obj, unsigned long key_size,
 			goto out;
 		break;
 
+	case TEE_TYPE_X25519_KEYPAIR:
+		res = tee_svc_obj_generate_key_x25519(o, type_props, key_size,
+						      params, param_count);
+		if (res != TEE_SUCCESS)
+			goto out;
+		break;
+
+	case TEE_TYPE_ED25519_KEYPAIR:
+		res = tee_svc_obj_generate_key_ed25519(o, type_props, key_size,
+						       params, param_count);
+		if (res != TEE_SUCCESS)
+			goto out;
+		break;
+
 	default:
 		res = TEE_ERROR_BAD_FORMAT;
 	}
@@ -2005,20 +2226,28 @@ out:
 	return res;
 }
 
+/*
+ * The state id handed out to the TA is the handle of the state in
+ * utc->cryp_state_db plus one, 0 is never a valid state id. Since the
+ * database belongs to the TA context a TA can only reach its own states
+ * and the lookup doesn't depend on the number of allocated states.
+ */
 static TEE_Result tee_svc_cryp_get_state(struct ts_session *sess,
-					 vaddr_t state_id,
+					 unsigned long state_id,
 					 struct tee_cryp_state **state)
 {
-	struct tee_cryp_state *s;
 	struct user_ta_ctx *utc = to_user_ta_ctx(sess->ctx);
+	struct tee_cryp_state *s = NULL;
 
-	TAILQ_FOREACH(s, &utc->cryp_states, link) {
-		if (state_id == (vaddr_t)s) {
-			*state = s;
-			return TEE_SUCCESS;
-		}
-	}
-	return TEE_ERROR_BAD_PARAMETERS;
+	if (!state_id || state_id > INT_MAX)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	s = handle_lookup(&utc->cryp_state_db, state_id - 1);
+	if (!s)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	*state = s;
+	return TEE_SUCCESS;
 }
 
 static void cryp_state_free(struct user_ta_ctx *utc, struct tee_cryp_state *cs)
@@ -2031,6 +2260,8 @@ static void cryp_state_free(struct user_ta_ctx *utc, struct tee_cryp_state *cs)
 		tee_obj_close(utc, o);
 
 	TAILQ_REMOVE(&utc->cryp_states, cs, link);
+	if (cs->handle >= 0)
+		handle_put(&utc->cryp_state_db, cs->handle);
 	if (cs->ctx_finalize != NULL)
 		cs->ctx_finalize(cs->ctx);
 
@@ -2095,6 +2326,9 @@ static TEE_Result tee_svc_cryp_check_key_type(const struct tee_obj *o,
 	case TEE_MAIN_ALGO_SM4:
 		req_key_type = TEE_TYPE_SM4;
 		break;
+	case TEE_MAIN_ALGO_CHACHA20:
+		req_key_type = TEE_TYPE_CHACHA20;
+		break;
 	case TEE_MAIN_ALGO_RSA:
 		req_key_type = TEE_TYPE_RSA_KEYPAIR;
 		if (mode == TEE_MODE_ENCRYPT || mode == TEE_MODE_VERIFY)
@@ -2116,6 +2350,14 @@ static TEE_Result tee_svc_cryp_check_key_type(const struct tee_obj *o,
 	case TEE_MAIN_ALGO_ECDH:
 		req_key_type = TEE_TYPE_ECDH_KEYPAIR;
 		break;
+	case TEE_MAIN_ALGO_ED25519:
+		req_key_type = TEE_TYPE_ED25519_KEYPAIR;
+		if (mode == TEE_MODE_VERIFY)
+			req_key_type2 = TEE_TYPE_ED25519_PUBLIC_KEY;
+		break;
+	case TEE_MAIN_ALGO_X25519:
+		req_key_type = TEE_TYPE_X25519_KEYPAIR;
+		break;
 	case TEE_MAIN_ALGO_SM2_PKE:
 		if (mode == TEE_MODE_ENCRYPT)
 			req_key_type = TEE_TYPE_SM2_PKE_PUBLIC_KEY;
@@ -2169,6 +2411,7 @@ TEE_Result syscall_cryp_state_alloc(unsigned long algo, unsigned long mode,
 	struct tee_cryp_state *cs = NULL;
 	struct tee_obj *o1 = NULL;
 	struct tee_obj *o2 = NULL;
+	uint32_t state_id = 0;
 
 	if (key1 != 0) {
 		res = tee_obj_get(utc, uref_to_vaddr(key1), &o1);
@@ -2195,6 +2438,7 @@ TEE_Result syscall_cryp_state_alloc(unsigned long algo, unsigned long mode,
 	if (!cs)
 		return TEE_ERROR_OUT_OF_MEMORY;
 	TAILQ_INSERT_TAIL(&utc->cryp_states, cs, link);
+	cs->handle = -1;
 	cs->algo = algo;
 	cs->mode = mode;
 	cs->state = CRYP_STATE_UNINITIALIZED;
@@ -2263,7 +2507,14 @@ TEE_Result syscall_cryp_state_alloc(unsigned long algo, unsigned long mode,
 	if (res != TEE_SUCCESS)
 		goto out;
 
-	res = copy_kaddr_to_uref(state, cs);
+	cs->handle = handle_get(&utc->cryp_state_db, cs);
+	if (cs->handle < 0) {
+		res = TEE_ERROR_OUT_OF_MEMORY;
+		goto out;
+	}
+
+	state_id = cs->handle + 1;
+	res = copy_to_user(state, &state_id, sizeof(state_id));
 	if (res != TEE_SUCCESS)
 		goto out;
 
@@ -2290,11 +2541,11 @@ TEE_Result syscall_cryp_state_copy(unsigned long dst, unsigned long src)
 	struct tee_cryp_state *cs_dst = NULL;
 	struct tee_cryp_state *cs_src = NULL;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(dst), &cs_dst);
+	res = tee_svc_cryp_get_state(sess, dst, &cs_dst);
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(src), &cs_src);
+	res = tee_svc_cryp_get_state(sess, src, &cs_src);
 	if (res != TEE_SUCCESS)
 		return res;
 	if (cs_dst->algo != cs_src->algo || cs_dst->mode != cs_src->mode)
@@ -2329,6 +2580,7 @@ void tee_svc_cryp_free_states(struct user_ta_ctx *utc)
 
 	while (!TAILQ_EMPTY(states))
 		cryp_state_free(utc, TAILQ_FIRST(states));
+	handle_db_destroy(&utc->cryp_state_db, NULL);
 }
 
 TEE_Result syscall_cryp_state_free(unsigned long state)
@@ -2337,7 +2589,7 @@ TEE_Result syscall_cryp_state_free(unsigned long state)
 	TEE_Result res = TEE_SUCCESS;
 	struct tee_cryp_state *cs = NULL;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 	cryp_state_free(to_user_ta_ctx(sess->ctx), cs);
@@ -2352,7 +2604,7 @@ TEE_Result syscall_hash_init(unsigned long state,
 	TEE_Result res = TEE_SUCCESS;
 	struct tee_cryp_state *cs = NULL;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -2391,51 +2643,52 @@ TEE_Result syscall_hash_init(unsigned long state,
 	return TEE_SUCCESS;
 }
 
-TEE_Result syscall_hash_update(unsigned long state, const void *chunk,
-			size_t chunk_size)
+static TEE_Result hash_update(struct user_ta_ctx *utc,
+			      struct tee_cryp_state *cs, const void *chunk,
+			      size_t chunk_size)
 {
-	struct ts_session *sess = ts_get_current_session();
-	struct tee_cryp_state *cs = NULL;
 	TEE_Result res = TEE_SUCCESS;
 
-	/* No data, but size provided isn't valid parameters. */
-	if (!chunk && chunk_size)
-		return TEE_ERROR_BAD_PARAMETERS;
-
-	/* Zero length hash is valid, but nothing we need to do. */
-	if (!chunk_size)
-		return TEE_SUCCESS;
-
-	res = vm_check_access_rights(&to_user_ta_ctx(sess->ctx)->uctx,
+	res = vm_check_access_rights(&utc->uctx,
 				     TEE_MEMORY_ACCESS_READ |
 				     TEE_MEMORY_ACCESS_ANY_OWNER,
 				     (uaddr_t)chunk, chunk_size);
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
-	if (res != TEE_SUCCESS)
-		return res;
-
 	if (cs->state != CRYP_STATE_INITIALIZED)
 		return TEE_ERROR_BAD_STATE;
 
 	switch (TEE_ALG_GET_CLASS(cs->algo)) {
 	case TEE_OPERATION_DIGEST:
-		res = crypto_hash_update(cs->ctx, chunk, chunk_size);
-		if (res != TEE_SUCCESS)
-			return res;
-		break;
+		return crypto_hash_update(cs->ctx, chunk, chunk_size);
 	case TEE_OPERATION_MAC:
-		res = crypto_mac_update(cs->ctx, chunk, chunk_size);
-		if (res != TEE_SUCCESS)
-			return res;
-		break;
+		return crypto_mac_update(cs->ctx, chunk, chunk_size);
 	default:
 		return TEE_ERROR_BAD_PARAMETERS;
 	}
+}
 
-	return TEE_SUCCESS;
+TEE_Result syscall_hash_update(unsigned long state, const void *chunk,
+			size_t chunk_size)
+{
+	struct ts_session *sess = ts_get_current_session();
+	struct tee_cryp_state *cs = NULL;
+	TEE_Result res = TEE_SUCCESS;
+
+	/* No data, but size provided isn't valid parameters. */
+	if (!chunk && chunk_size)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	/* Zero length hash is valid, but nothing we need to do. */
+	if (!chunk_size)
+		return TEE_SUCCESS;
+
+	res = tee_svc_cryp_get_state(sess, state, &cs);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	return hash_update(to_user_ta_ctx(sess->ctx), cs, chunk, chunk_size);
 }
 
 TEE_Result syscall_hash_final(unsigned long state, const void *chunk,
@@ -2471,7 +2724,7 @@ TEE_Result syscall_hash_final(unsigned long state, const void *chunk,
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -2539,7 +2792,7 @@ TEE_Result syscall_cipher_init(unsigned long state, const void *iv,
 	TEE_Result res = TEE_SUCCESS;
 	struct tee_obj *o = NULL;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -2585,49 +2838,38 @@ TEE_Result syscall_cipher_init(unsigned long state, const void *iv,
 	return TEE_SUCCESS;
 }
 
-static TEE_Result tee_svc_cipher_update_helper(unsigned long state,
-			bool last_block, const void *src, size_t src_len,
-			void *dst, uint64_t *dst_len)
+/*
+ * @dlen holds the size of @dst on entry and the number of bytes produced,
+ * or needed in case of TEE_ERROR_SHORT_BUFFER, on successful return.
+ */
+static TEE_Result cipher_update(struct user_ta_ctx *utc,
+				struct tee_cryp_state *cs, bool last_block,
+				const void *src, size_t src_len, void *dst,
+				size_t *dlen)
 {
-	struct ts_session *sess = ts_get_current_session();
-	struct tee_cryp_state *cs = NULL;
 	TEE_Result res = TEE_SUCCESS;
-	size_t dlen = 0;
-
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
-	if (res != TEE_SUCCESS)
-		return res;
 
 	if (cs->state != CRYP_STATE_INITIALIZED)
 		return TEE_ERROR_BAD_STATE;
 
-	res = vm_check_access_rights(&to_user_ta_ctx(sess->ctx)->uctx,
+	res = vm_check_access_rights(&utc->uctx,
 				     TEE_MEMORY_ACCESS_READ |
 				     TEE_MEMORY_ACCESS_ANY_OWNER,
 				     (uaddr_t)src, src_len);
 	if (res != TEE_SUCCESS)
 		return res;
 
-	if (!dst_len) {
-		dlen = 0;
-	} else {
-		struct user_mode_ctx *uctx = &to_user_ta_ctx(sess->ctx)->uctx;
-		uint32_t flags = TEE_MEMORY_ACCESS_READ |
-				 TEE_MEMORY_ACCESS_WRITE |
-				 TEE_MEMORY_ACCESS_ANY_OWNER;
-
-		res = get_user_u64_as_size_t(&dlen, dst_len);
-		if (res != TEE_SUCCESS)
-			return res;
-
-		res = vm_check_access_rights(uctx, flags, (uaddr_t)dst, dlen);
-		if (res != TEE_SUCCESS)
-			return res;
-	}
+	res = vm_check_access_rights(&utc->uctx,
+				     TEE_MEMORY_ACCESS_READ |
+				     TEE_MEMORY_ACCESS_WRITE |
+				     TEE_MEMORY_ACCESS_ANY_OWNER,
+				     (uaddr_t)dst, *dlen);
+	if (res != TEE_SUCCESS)
+		return res;
 
-	if (dlen < src_len) {
-		res = TEE_ERROR_SHORT_BUFFER;
-		goto out;
+	if (*dlen < src_len) {
+		*dlen = src_len;
+		return TEE_ERROR_SHORT_BUFFER;
 	}
 
 	if (src_len > 0) {
@@ -2641,12 +2883,39 @@ static TEE_Result tee_svc_cipher_update_helper(unsigned long state,
 		cs->ctx_finalize = NULL;
 	}
 
-out:
+	if (res == TEE_SUCCESS)
+		*dlen = src_len;
+
+	return res;
+}
+
+static TEE_Result tee_svc_cipher_update_helper(unsigned long state,
+			bool last_block, const void *src, size_t src_len,
+			void *dst, uint64_t *dst_len)
+{
+	struct ts_session *sess = ts_get_current_session();
+	struct tee_cryp_state *cs = NULL;
+	TEE_Result res = TEE_SUCCESS;
+	size_t dlen = 0;
+
+	res = tee_svc_cryp_get_state(sess, state, &cs);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	if (dst_len) {
+		res = get_user_u64_as_size_t(&dlen, dst_len);
+		if (res != TEE_SUCCESS)
+			return res;
+	}
+
+	res = cipher_update(to_user_ta_ctx(sess->ctx), cs, last_block, src,
+			    src_len, dst, &dlen);
+
 	if ((res == TEE_SUCCESS || res == TEE_ERROR_SHORT_BUFFER) &&
 	    dst_len != NULL) {
 		TEE_Result res2;
 
-		res2 = put_user_u64(dst_len, src_len);
+		res2 = put_user_u64(dst_len, dlen);
 		if (res2 != TEE_SUCCESS)
 			res = res2;
 	}
@@ -2930,7 +3199,7 @@ TEE_Result syscall_cryp_derive_key(unsigned long state,
 	TEE_Attribute *params = NULL;
 	size_t alloc_size = 0;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3062,6 +3331,27 @@ TEE_Result syscall_cryp_derive_key(unsigned long state,
 
 		/* free the public key */
 		crypto_acipher_free_ecc_public_key(&key_public);
+	} else if (cs->algo == TEE_ALG_X25519) {
+		uint8_t *pt_secret = NULL;
+		size_t pt_secret_len = 0;
+
+		if (param_count != 1 ||
+		    params[0].attributeID != TEE_ATTR_X25519_PUBLIC_VALUE ||
+		    params[0].content.ref.length != CURVE25519_VALUE_SIZE) {
+			res = TEE_ERROR_BAD_PARAMETERS;
+			goto out;
+		}
+
+		pt_secret = (uint8_t *)(sk + 1);
+		pt_secret_len = sk->alloc_size;
+		res = crypto_acipher_x25519_shared_secret(ko->attr,
+						params[0].content.ref.buffer,
+						pt_secret, &pt_secret_len);
+		if (res == TEE_SUCCESS) {
+			sk->key_size = pt_secret_len;
+			so->info.handleFlags |= TEE_HANDLE_FLAG_INITIALIZED;
+			set_attribute(so, type_props, TEE_ATTR_SECRET_VALUE);
+		}
 	}
 #if defined(CFG_CRYPTO_HKDF)
 	else if (TEE_ALG_GET_MAIN_ALG(cs->algo) == TEE_MAIN_ALGO_HKDF) {
@@ -3229,7 +3519,7 @@ TEE_Result syscall_authenc_init(unsigned long state, const void *nonce,
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3266,7 +3556,7 @@ TEE_Result syscall_authenc_update_aad(unsigned long state,
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3284,19 +3574,13 @@ TEE_Result syscall_authenc_update_aad(unsigned long state,
 	return TEE_SUCCESS;
 }
 
-TEE_Result syscall_authenc_update_payload(unsigned long state,
-					  const void *src_data,
-					  size_t src_len, void *dst_data,
-					  uint64_t *dst_len)
+/* @dlen is used as in cipher_update() */
+static TEE_Result authenc_update_payload(struct user_ta_ctx *utc,
+					 struct tee_cryp_state *cs,
+					 const void *src_data, size_t src_len,
+					 void *dst_data, size_t *dlen)
 {
-	struct ts_session *sess = ts_get_current_session();
-	struct tee_cryp_state *cs = NULL;
 	TEE_Result res = TEE_SUCCESS;
-	size_t dlen = 0;
-
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
-	if (res != TEE_SUCCESS)
-		return res;
 
 	if (cs->state != CRYP_STATE_INITIALIZED)
 		return TEE_ERROR_BAD_STATE;
@@ -3304,33 +3588,50 @@ TEE_Result syscall_authenc_update_payload(unsigned long state,
 	if (TEE_ALG_GET_CLASS(cs->algo) != TEE_OPERATION_AE)
 		return TEE_ERROR_BAD_STATE;
 
-	res = vm_check_access_rights(&to_user_ta_ctx(sess->ctx)->uctx,
+	res = vm_check_access_rights(&utc->uctx,
 				     TEE_MEMORY_ACCESS_READ |
 				     TEE_MEMORY_ACCESS_ANY_OWNER,
 				     (uaddr_t)src_data, src_len);
 	if (res != TEE_SUCCESS)
 		return res;
 
-	res = get_user_u64_as_size_t(&dlen, dst_len);
-	if (res != TEE_SUCCESS)
-		return res;
-
-	res = vm_check_access_rights(&to_user_ta_ctx(sess->ctx)->uctx,
+	res = vm_check_access_rights(&utc->uctx,
 				     TEE_MEMORY_ACCESS_READ |
 				     TEE_MEMORY_ACCESS_WRITE |
 				     TEE_MEMORY_ACCESS_ANY_OWNER,
-				     (uaddr_t)dst_data, dlen);
+				     (uaddr_t)dst_data, *dlen);
 	if (res != TEE_SUCCESS)
 		return res;
 
-	if (dlen < src_len) {
-		res = TEE_ERROR_SHORT_BUFFER;
-		goto out;
+	if (*dlen < src_len) {
+		*dlen = src_len;
+		return TEE_ERROR_SHORT_BUFFER;
 	}
 
-	res = crypto_authenc_update_payload(cs->ctx, cs->mode, src_data,
-					    src_len, dst_data, &dlen);
-out:
+	return crypto_authenc_update_payload(cs->ctx, cs->mode, src_data,
+					     src_len, dst_data, dlen);
+}
+
+TEE_Result syscall_authenc_update_payload(unsigned long state,
+					  const void *src_data,
+					  size_t src_len, void *dst_data,
+					  uint64_t *dst_len)
+{
+	struct ts_session *sess = ts_get_current_session();
+	struct tee_cryp_state *cs = NULL;
+	TEE_Result res = TEE_SUCCESS;
+	size_t dlen = 0;
+
+	res = tee_svc_cryp_get_state(sess, state, &cs);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	res = get_user_u64_as_size_t(&dlen, dst_len);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	res = authenc_update_payload(to_user_ta_ctx(sess->ctx), cs, src_data,
+				     src_len, dst_data, &dlen);
 	if (res == TEE_SUCCESS || res == TEE_ERROR_SHORT_BUFFER) {
 		TEE_Result res2 = put_user_u64(dst_len, dlen);
 
@@ -3341,6 +3642,104 @@ out:
 	return res;
 }
 
+static TEE_Result cryp_update(struct ts_session *sess,
+			      struct utee_cryp_update *upd)
+{
+	struct user_ta_ctx *utc = to_user_ta_ctx(sess->ctx);
+	struct tee_cryp_state *cs = NULL;
+	TEE_Result res = TEE_SUCCESS;
+	size_t src_len = 0;
+	uaddr_t src = 0;
+	uaddr_t dst = 0;
+	size_t dlen = 0;
+
+	/* Pointers and sizes are 64-bit also for 32-bit TAs */
+	if (ADD_OVERFLOW(0, upd->src, &src) ||
+	    ADD_OVERFLOW(0, upd->src_len, &src_len) ||
+	    ADD_OVERFLOW(0, upd->dst, &dst) ||
+	    ADD_OVERFLOW(0, upd->dst_len, &dlen))
+		return TEE_ERROR_OVERFLOW;
+
+	if (!src && src_len)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	res = tee_svc_cryp_get_state(sess, upd->state, &cs);
+	if (res != TEE_SUCCESS)
+		return res;
+
+	switch (upd->kind) {
+	case UTEE_CRYP_UPDATE_HASH:
+		dlen = 0;
+		if (src_len)
+			res = hash_update(utc, cs, (void *)src, src_len);
+		break;
+	case UTEE_CRYP_UPDATE_CIPHER:
+		if (TEE_ALG_GET_CLASS(cs->algo) != TEE_OPERATION_CIPHER)
+			return TEE_ERROR_BAD_STATE;
+		res = cipher_update(utc, cs, false /* last_block */,
+				    (void *)src, src_len, (void *)dst, &dlen);
+		break;
+	case UTEE_CRYP_UPDATE_AE:
+		res = authenc_update_payload(utc, cs, (void *)src, src_len,
+					     (void *)dst, &dlen);
+		break;
+	default:
+		return TEE_ERROR_BAD_PARAMETERS;
+	}
+
+	if (res == TEE_SUCCESS || res == TEE_ERROR_SHORT_BUFFER)
+		upd->dst_len = dlen;
+
+	return res;
+}
+
+/*
+ * Feeds a batch of records to different states with a single user to
+ * kernel transition, each update is equivalent to the corresponding
+ * syscall_hash_update(), syscall_cipher_update() or
+ * syscall_authenc_update_payload() call.
+ */
+TEE_Result syscall_cryp_update_vec(struct utee_cryp_update *upd,
+				   unsigned long count)
+{
+	struct ts_session *sess = ts_get_current_session();
+	struct utee_cryp_update *kupd = NULL;
+	TEE_Result res2 = TEE_SUCCESS;
+	TEE_Result res = TEE_SUCCESS;
+	size_t alloc_size = 0;
+	size_t n = 0;
+
+	if (!count)
+		return TEE_SUCCESS;
+	if (count > UTEE_CRYP_UPDATE_MAX_COUNT)
+		return TEE_ERROR_BAD_PARAMETERS;
+
+	alloc_size = count * sizeof(*kupd);
+	kupd = malloc(alloc_size);
+	if (!kupd)
+		return TEE_ERROR_OUT_OF_MEMORY;
+
+	res = copy_from_user(kupd, upd, alloc_size);
+	if (res != TEE_SUCCESS)
+		goto out;
+
+	for (n = 0; n < count; n++) {
+		res = cryp_update(sess, kupd + n);
+		kupd[n].res = res;
+		if (res != TEE_SUCCESS) {
+			n++;
+			break;
+		}
+	}
+
+	res2 = copy_to_user(upd, kupd, n * sizeof(*kupd));
+	if (res2 != TEE_SUCCESS)
+		res = res2;
+out:
+	free(kupd);
+	return res;
+}
+
 TEE_Result syscall_authenc_enc_final(unsigned long state, const void *src_data,
 				     size_t src_len, void *dst_data,
 				     uint64_t *dst_len, void *tag,
@@ -3353,7 +3752,7 @@ TEE_Result syscall_authenc_enc_final(unsigned long state, const void *src_data,
 	size_t dlen = 0;
 	size_t tlen = 0;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3437,7 +3836,7 @@ TEE_Result syscall_authenc_dec_final(unsigned long state,
 	TEE_Result res = TEE_SUCCESS;
 	size_t dlen = 0;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3519,6 +3918,27 @@ static int pkcs1_get_salt_len(const TEE_Attribute *params, uint32_t num_params,
 	return default_len;
 }
 
+/*
+ * Only pure Ed25519 is implemented, Ed25519ph and Ed25519ctx are rejected
+ * instead of silently producing a pure Ed25519 signature.
+ */
+static TEE_Result check_ed25519_params(const TEE_Attribute *params,
+				       uint32_t num_params)
+{
+	size_t n = 0;
+
+	for (n = 0; n < num_params; n++) {
+		if (params[n].attributeID == TEE_ATTR_EDDSA_PREHASH &&
+		    params[n].content.value.a)
+			return TEE_ERROR_NOT_SUPPORTED;
+		if (params[n].attributeID == TEE_ATTR_EDDSA_CTX &&
+		    params[n].content.ref.length)
+			return TEE_ERROR_NOT_SUPPORTED;
+	}
+
+	return TEE_SUCCESS;
+}
+
 TEE_Result syscall_asymm_operate(unsigned long state,
 			const struct utee_attribute *usr_params,
 			size_t num_params, const void *src_data, size_t src_len,
@@ -3537,7 +3957,7 @@ TEE_Result syscall_asymm_operate(unsigned long state,
 	TEE_Attribute *params = NULL;
 	size_t alloc_size = 0;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3678,6 +4098,17 @@ TEE_Result syscall_asymm_operate(unsigned long state,
 		res = crypto_acipher_ecc_sign(cs->algo, o->attr, src_data,
 					      src_len, dst_data, &dlen);
 		break;
+	case TEE_ALG_ED25519:
+		if (cs->mode != TEE_MODE_SIGN) {
+			res = TEE_ERROR_BAD_PARAMETERS;
+			break;
+		}
+		res = check_ed25519_params(params, num_params);
+		if (res != TEE_SUCCESS)
+			break;
+		res = crypto_acipher_ed25519_sign(o->attr, src_data, src_len,
+						  dst_data, &dlen);
+		break;
 	default:
 		res = TEE_ERROR_BAD_PARAMETERS;
 		break;
@@ -3712,7 +4143,7 @@ TEE_Result syscall_asymm_verify(unsigned long state,
 	int salt_len = 0;
 	size_t alloc_size = 0;
 
-	res = tee_svc_cryp_get_state(sess, uref_to_vaddr(state), &cs);
+	res = tee_svc_cryp_get_state(sess, state, &cs);
 	if (res != TEE_SUCCESS)
 		return res;
 
@@ -3818,6 +4249,25 @@ TEE_Result syscall_asymm_verify(unsigned long state,
 						data_len, sig, sig_len);
 		break;
 
+	case TEE_MAIN_ALGO_ED25519:
+		res = check_ed25519_params(params, num_params);
+		if (res != TEE_SUCCESS)
+			break;
+		if (o->info.objectType == TEE_TYPE_ED25519_KEYPAIR) {
+			struct ed25519_keypair *key = o->attr;
+
+			res = crypto_acipher_ed25519_verify(key->pub, data,
+							    data_len, sig,
+							    sig_len);
+		} else {
+			struct ed25519_public_key *key = o->attr;
+
+			res = crypto_acipher_ed25519_verify(key->pub, data,
+							    data_len, sig,
+							    sig_len);
+		}
+		break;
+
 	default:
 		res = TEE_ERROR_NOT_SUPPORTED;
 	}
@@ -29,5 +29,7 @@ TEE_Result _ldelf_set_prot(unsigned long va, size_t num_bytes,
 TEE_Result _ldelf_remap(unsigned long old_va, vaddr_t *new_va, size_t num_bytes,
 			size_t pad_begin, size_t pad_end);
 TEE_Result _ldelf_gen_rnd_num(void *buf, size_t num_bytes);
+TEE_Result _ldelf_share_reloc(unsigned long va, size_t num_bytes,
+			      unsigned long ref_va);
 
 #endif /* LDELF_SYSCALLS_H */
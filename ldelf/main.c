@@ -164,6 +164,13 @@ void ldelf(struct ldelf_arg *arg)
 		arg->ftrace_entry = (vaddr_t)(void *)ftrace_dump;
 #endif
 
+	/*
+	 * Done last since any later write to the writeable segments makes
+	 * a private copy of the page.
+	 */
+	TAILQ_FOREACH(elf, &main_elf_queue, link)
+		ta_elf_share_relocated(elf);
+
 	TAILQ_FOREACH(elf, &main_elf_queue, link)
 		DMSG("ELF (%pUl) at %#"PRIxVA,
 		     (void *)&elf->uuid, elf->load_addr);
@@ -4,6 +4,8 @@ srcs-$(CFG_ARM64_$(sm)) += start_a64.S
 srcs-$(CFG_ARM32_$(sm)) += syscalls_a32.S
 srcs-$(CFG_ARM64_$(sm)) += syscalls_a64.S
 srcs-$(CFG_ARM64_$(sm)) += tlsdesc_rel_a64.S
+srcs-$(CFG_ARM32_$(sm)) += plt_lazy_a32.S
+srcs-$(CFG_ARM64_$(sm)) += plt_lazy_a64.S
 srcs-y += dl.c
 srcs-y += main.c
 srcs-y += sys.c
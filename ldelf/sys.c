@@ -11,6 +11,7 @@
 
 int trace_level = TRACE_LEVEL;
 const char trace_ext_prefix[]  = "LD";
+bool sys_lazy_binding;
 
 void __panic(const char *file __maybe_unused, const int line __maybe_unused,
 	     const char *func __maybe_unused)
@@ -87,3 +88,8 @@ TEE_Result sys_gen_random_num(void *buf, size_t blen)
 {
 	return _ldelf_gen_rnd_num(buf, blen);
 }
+
+TEE_Result sys_share_reloc(vaddr_t va, size_t num_bytes, vaddr_t ref_va)
+{
+	return _ldelf_share_reloc(va, num_bytes, ref_va);
+}
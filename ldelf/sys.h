@@ -8,6 +8,7 @@
 #define SYS_H
 
 #include <compiler.h>
+#include <config.h>
 #include <ldelf_syscalls.h>
 #include <stddef.h>
 #include <tee_api_types.h>
@@ -28,9 +29,18 @@
 void __noreturn __panic(const char *file, const int line, const char *func);
 void __noreturn sys_return_cleanup(void);
 
+/*
+ * Set while a lazily bound PLT entry is resolved on behalf of a running
+ * TA. There is no ldelf invocation to return from then, so errors panic
+ * the TA instead.
+ */
+extern bool sys_lazy_binding;
+
 #define err(res, ...) \
 	do { \
 		trace_printf_helper(TRACE_ERROR, true, __VA_ARGS__); \
+		if (IS_ENABLED(CFG_TA_LAZY_BINDING) && sys_lazy_binding) \
+			panic(); \
 		_ldelf_return(res); \
 	} while (0)
 
@@ -48,5 +58,6 @@ TEE_Result sys_set_prot(vaddr_t va, size_t num_bytes, uint32_t flags);
 TEE_Result sys_remap(vaddr_t old_va, vaddr_t *new_va, size_t num_bytes,
 		     size_t pad_begin, size_t pad_end);
 TEE_Result sys_gen_random_num(void *buf, size_t blen);
+TEE_Result sys_share_reloc(vaddr_t va, size_t num_bytes, vaddr_t ref_va);
 
 #endif /*SYS_H*/
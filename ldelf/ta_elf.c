@@ -191,8 +191,8 @@ static void read_dyn(struct ta_elf *elf, vaddr_t addr,
 	}
 }
 
-static void save_hashtab_from_segment(struct ta_elf *elf, unsigned int type,
-				      vaddr_t addr, size_t memsz)
+static void save_dyn_info_from_segment(struct ta_elf *elf, unsigned int type,
+				       vaddr_t addr, size_t memsz)
 {
 	size_t dyn_entsize = 0;
 	size_t num_dyns = 0;
@@ -215,9 +215,52 @@ static void save_hashtab_from_segment(struct ta_elf *elf, unsigned int type,
 
 	for (n = 0; n < num_dyns; n++) {
 		read_dyn(elf, addr, n, &tag, &val);
-		if (tag == DT_HASH) {
+		switch (tag) {
+		case DT_HASH:
 			elf->hashtab = (void *)(val + elf->load_addr);
 			break;
+		case DT_GNU_HASH:
+			elf->gnu_hashtab = (void *)(val + elf->load_addr);
+			break;
+		case DT_PLTGOT:
+			elf->pltgot = val;
+			break;
+		case DT_JMPREL:
+			elf->jmprel = val;
+			break;
+		case DT_PLTRELSZ:
+			elf->pltrelsz = val;
+			break;
+		case DT_RELA:
+		case DT_REL:
+			elf->rel_addr = val;
+			break;
+		case DT_RELACOUNT:
+		case DT_RELCOUNT:
+			elf->relative_count = val;
+			break;
+		case DT_RELR:
+			elf->relr = val;
+			break;
+		case DT_RELRSZ:
+			elf->relrsz = val;
+			break;
+		case DT_RELRENT:
+			elf->relrent = val;
+			break;
+		case DT_BIND_NOW:
+			elf->bind_now = true;
+			break;
+		case DT_FLAGS:
+			if (val & DF_BIND_NOW)
+				elf->bind_now = true;
+			break;
+		case DT_FLAGS_1:
+			if (val & DF_1_BIND_NOW)
+				elf->bind_now = true;
+			break;
+		default:
+			break;
 		}
 	}
 }
@@ -262,6 +305,48 @@ static void check_hashtab(struct ta_elf *elf, void *ptr, size_t num_buckets,
 	check_range(elf, "DT_HASH", ptr, sz);
 }
 
+static void check_gnu_hashtab(struct ta_elf *elf)
+{
+	/*
+	 * The DT_GNU_HASH table starts with four words: nbuckets,
+	 * symoffset, bloom_size and bloom_shift. They are followed by
+	 * bloom_size bloom filter words of the native word size of the
+	 * ELF class, nbuckets buckets and one chain word per symbol from
+	 * symoffset to the end of the dynamic symbol table.
+	 */
+	uint32_t *hashtab = elf->gnu_hashtab;
+	size_t bloom_word_sz = 0;
+	size_t num_chains = 0;
+	size_t num_words = 0;
+	size_t sz = 0;
+
+	if (elf->is_32bit)
+		bloom_word_sz = sizeof(Elf32_Addr);
+	else
+		bloom_word_sz = sizeof(Elf64_Addr);
+
+	if (!IS_ALIGNED((vaddr_t)hashtab, bloom_word_sz))
+		err(TEE_ERROR_BAD_FORMAT, "Bad alignment of DT_GNU_HASH %p",
+		    (void *)hashtab);
+
+	check_range(elf, "DT_GNU_HASH", hashtab, 4 * sizeof(uint32_t));
+
+	if (!hashtab[0] || !hashtab[2] || !IS_POWER_OF_TWO(hashtab[2]))
+		err(TEE_ERROR_BAD_FORMAT, "Bad DT_GNU_HASH header");
+	if (hashtab[1] > elf->num_dynsyms)
+		err(TEE_ERROR_BAD_FORMAT, "DT_GNU_HASH symoffset out of range");
+	num_chains = elf->num_dynsyms - hashtab[1];
+
+	if (MUL_OVERFLOW(hashtab[2], bloom_word_sz, &sz) ||
+	    ADD_OVERFLOW(hashtab[0], num_chains, &num_words) ||
+	    ADD_OVERFLOW(num_words, 4, &num_words) ||
+	    MUL_OVERFLOW(num_words, sizeof(uint32_t), &num_words) ||
+	    ADD_OVERFLOW(sz, num_words, &sz))
+		err(TEE_ERROR_BAD_FORMAT, "DT_GNU_HASH overflow");
+
+	check_range(elf, "DT_GNU_HASH", hashtab, sz);
+}
+
 static void save_hashtab(struct ta_elf *elf)
 {
 	uint32_t *hashtab = NULL;
@@ -271,18 +356,25 @@ static void save_hashtab(struct ta_elf *elf)
 		Elf32_Phdr *phdr = elf->phdr;
 
 		for (n = 0; n < elf->e_phnum; n++)
-			save_hashtab_from_segment(elf, phdr[n].p_type,
-						  phdr[n].p_vaddr,
-						  phdr[n].p_memsz);
+			save_dyn_info_from_segment(elf, phdr[n].p_type,
+						   phdr[n].p_vaddr,
+						   phdr[n].p_memsz);
 	} else {
 		Elf64_Phdr *phdr = elf->phdr;
 
 		for (n = 0; n < elf->e_phnum; n++)
-			save_hashtab_from_segment(elf, phdr[n].p_type,
-						  phdr[n].p_vaddr,
-						  phdr[n].p_memsz);
+			save_dyn_info_from_segment(elf, phdr[n].p_type,
+						   phdr[n].p_vaddr,
+						   phdr[n].p_memsz);
 	}
 
+	if (elf->gnu_hashtab)
+		check_gnu_hashtab(elf);
+
+	/* DT_HASH is optional when DT_GNU_HASH is available */
+	if (!elf->hashtab && elf->gnu_hashtab)
+		return;
+
 	check_hashtab(elf, elf->hashtab, 0, 0);
 	hashtab = elf->hashtab;
 	check_hashtab(elf, elf->hashtab, hashtab[0], hashtab[1]);
@@ -427,6 +519,39 @@ static void save_symtab(struct ta_elf *elf)
 	save_soname(elf);
 }
 
+/*
+ * scripts/sign_encrypt.py --prelink-addr records the address the TA has
+ * been prelinked for in a PT_OPTEE_PRELINK program header. The program
+ * headers are in the first page which is already mapped, so the address
+ * is known before any segment is mapped.
+ */
+static void read_prelink_base(struct ta_elf *elf)
+{
+	size_t n = 0;
+	vaddr_t base = 0;
+
+	for (n = 0; n < elf->e_phnum; n++) {
+		if (elf->is_32bit) {
+			Elf32_Phdr *phdr = elf->phdr;
+
+			if (phdr[n].p_type != PT_OPTEE_PRELINK)
+				continue;
+			base = phdr[n].p_vaddr;
+		} else {
+			Elf64_Phdr *phdr = elf->phdr;
+
+			if (phdr[n].p_type != PT_OPTEE_PRELINK)
+				continue;
+			base = phdr[n].p_vaddr;
+		}
+
+		if (base & SMALL_PAGE_MASK)
+			err(TEE_ERROR_BAD_FORMAT, "Unaligned prelink base");
+		elf->prelinked = true;
+		elf->prelink_base = base;
+	}
+}
+
 static void init_elf(struct ta_elf *elf)
 {
 	TEE_Result res = TEE_SUCCESS;
@@ -471,6 +596,7 @@ static void init_elf(struct ta_elf *elf)
 		err(TEE_ERROR_NOT_SUPPORTED, "Cannot read program headers");
 
 	elf->phdr = (void *)(va + elf->e_phoff);
+	read_prelink_base(elf);
 }
 
 static size_t roundup(size_t v)
@@ -758,6 +884,14 @@ static void populate_segments(struct ta_elf *elf)
 			elf->max_addr = va + num_bytes;
 		} else {
 			uint32_t flags =  0;
+			/*
+			 * With ASLR disabled a prelinked TA is mapped at
+			 * the address it's been prelinked for if possible,
+			 * its relative relocations are then already applied.
+			 */
+			bool at_prelink_base = !IS_ENABLED(CFG_TA_ASLR) &&
+					       elf->prelinked &&
+					       !elf->load_addr;
 			size_t filesz = seg->filesz;
 			size_t memsz = seg->memsz;
 			size_t offset = seg->offset;
@@ -804,7 +938,14 @@ static void populate_segments(struct ta_elf *elf)
 				offset += SMALL_PAGE_SIZE;
 			}
 
-			if (!elf->load_addr) {
+			if (at_prelink_base) {
+				/*
+				 * If mapping at the prelinked address
+				 * fails we'll retry at any address.
+				 */
+				va = elf->prelink_base + vaddr;
+				pad_begin = 0;
+			} else if (!elf->load_addr) {
 				va = 0;
 				pad_begin = get_pad_begin();
 				/*
@@ -832,6 +973,11 @@ static void populate_segments(struct ta_elf *elf)
 				if (pad_begin && res == TEE_ERROR_OUT_OF_MEMORY)
 					res = sys_map_zi(memsz, 0, &va, 0,
 							 pad_end);
+				if (res && at_prelink_base) {
+					va = 0;
+					res = sys_map_zi(memsz, 0, &va, 0,
+							 pad_end);
+				}
 				if (res)
 					err(res, "sys_map_zi");
 				res = sys_copy_from_ta_bin((void *)va, filesz,
@@ -850,6 +996,13 @@ static void populate_segments(struct ta_elf *elf)
 							     elf->handle,
 							     offset, 0,
 							     pad_end);
+				if (res && at_prelink_base) {
+					va = 0;
+					res = sys_map_ta_bin(&va, filesz, flags,
+							     elf->handle,
+							     offset, 0,
+							     pad_end);
+				}
 				if (res)
 					err(res, "sys_map_ta_bin");
 			}
@@ -1294,6 +1447,36 @@ void ta_elf_finalize_mappings(struct ta_elf *elf)
 	}
 }
 
+/*
+ * With ASLR disabled all instances of a TA are loaded at the same address
+ * and their writeable segments are identical once relocated, until the TA
+ * starts to execute. Offer them to TEE core to be shared copy-on-write
+ * with other instances. The file is identified by TEE core via the
+ * read-only mapping at the load address.
+ */
+void ta_elf_share_relocated(struct ta_elf *elf)
+{
+	TEE_Result res = TEE_SUCCESS;
+	struct segment *seg = NULL;
+
+	if (!IS_ENABLED(CFG_TA_SHARE_RELOC_PAGES) ||
+	    IS_ENABLED(CFG_TA_ASLR) || elf->is_legacy)
+		return;
+
+	TAILQ_FOREACH(seg, &elf->segs, link) {
+		vaddr_t va = rounddown(elf->load_addr + seg->vaddr);
+		size_t num_bytes = roundup(elf->load_addr + seg->vaddr +
+					   seg->memsz) - va;
+
+		if (!(seg->flags & PF_W))
+			continue;
+
+		res = sys_share_reloc(va, num_bytes, elf->load_addr);
+		if (res && res != TEE_ERROR_NOT_SUPPORTED)
+			err(res, "sys_share_reloc");
+	}
+}
+
 static void __printf(3, 4) print_wrapper(void *pctx, print_func_t print_func,
 					 const char *fmt, ...)
 {
@@ -25,6 +25,13 @@ struct segment {
 
 TAILQ_HEAD(segment_head, segment);
 
+/*
+ * Program header added after the existing ones by scripts/sign_encrypt.py
+ * --prelink-addr, p_vaddr is the load address the R_*_RELATIVE relocations
+ * of DT_RELA or DT_REL and the DT_RELR relocations have been applied for.
+ */
+#define PT_OPTEE_PRELINK	0x6fff0000
+
 struct ta_elf {
 	bool is_main;
 	bool is_32bit;	/* Initialized from Elf32_Ehdr/Elf64_Ehdr */
@@ -59,6 +66,28 @@ struct ta_elf {
 
 	/* DT_HASH hash table for faster resolution of external symbols */
 	void *hashtab;
+	/* DT_GNU_HASH hash table, preferred over DT_HASH when present */
+	void *gnu_hashtab;
+
+	/* DT_PLTGOT, DT_JMPREL and DT_PLTRELSZ, used for lazy binding */
+	vaddr_t pltgot;
+	vaddr_t jmprel;
+	size_t pltrelsz;
+	/* DT_RELA or DT_REL and DT_RELACOUNT or DT_RELCOUNT */
+	vaddr_t rel_addr;
+	size_t relative_count;
+	/* DT_RELR, DT_RELRSZ and DT_RELRENT, packed relative relocations */
+	vaddr_t relr;
+	size_t relrsz;
+	size_t relrent;
+	/* PT_OPTEE_PRELINK */
+	bool prelinked;
+	vaddr_t prelink_base;
+
+	/* Linked with -z now, all symbols are to be resolved at load */
+	bool bind_now;
+	/* PLT entries are resolved on first call instead of at load */
+	bool lazy_bind;
 
 	/* DT_SONAME */
 	char *soname;
@@ -107,6 +136,7 @@ void ta_elf_finalize_load_main(uint64_t *entry);
 void ta_elf_load_dependency(struct ta_elf *elf, bool is_32bit);
 void ta_elf_relocate(struct ta_elf *elf);
 void ta_elf_finalize_mappings(struct ta_elf *elf);
+void ta_elf_share_relocated(struct ta_elf *elf);
 
 void ta_elf_print_mappings(void *pctx, print_func_t print_func,
 			   struct ta_elf_queue *elf_queue, size_t num_maps,
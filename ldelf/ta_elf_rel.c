@@ -5,6 +5,7 @@
 
 #include <assert.h>
 #include <compiler.h>
+#include <config.h>
 #include <confine_array_index.h>
 #include <elf32.h>
 #include <elf64.h>
@@ -32,6 +33,47 @@ static uint32_t elf_hash(const char *name)
 	return h;
 }
 
+static uint32_t gnu_hash(const char *name)
+{
+	const unsigned char *p = (const unsigned char *)name;
+	uint32_t h = 5381;
+
+	while (*p)
+		h = (h << 5) + h + *p++;
+
+	return h;
+}
+
+/*
+ * A symbol name together with its hashes. The hashes are computed on
+ * first use since most modules only need one of them.
+ */
+struct sym_name {
+	const char *name;
+	uint32_t elf_hash;
+	uint32_t gnu_hash;
+	bool have_elf_hash;
+	bool have_gnu_hash;
+};
+
+static uint32_t get_elf_hash(struct sym_name *sn)
+{
+	if (!sn->have_elf_hash) {
+		sn->elf_hash = elf_hash(sn->name);
+		sn->have_elf_hash = true;
+	}
+	return sn->elf_hash;
+}
+
+static uint32_t get_gnu_hash(struct sym_name *sn)
+{
+	if (!sn->have_gnu_hash) {
+		sn->gnu_hash = gnu_hash(sn->name);
+		sn->have_gnu_hash = true;
+	}
+	return sn->gnu_hash;
+}
+
 static bool __resolve_sym(struct ta_elf *elf, unsigned int st_bind,
 			  unsigned int st_type, size_t st_shndx,
 			  size_t st_name, size_t st_value, const char *name,
@@ -78,65 +120,158 @@ static bool __resolve_sym(struct ta_elf *elf, unsigned int st_bind,
 	return true;
 }
 
-static TEE_Result resolve_sym_helper(uint32_t hash, const char *name,
-				     vaddr_t *val, struct ta_elf *elf,
-				     bool weak_ok)
+static bool resolve_sym_idx(struct ta_elf *elf, size_t n, const char *name,
+			    vaddr_t *val, bool weak_ok)
 {
 	/*
-	 * Using uint32_t here for convenience because both Elf64_Word
-	 * and Elf32_Word are 32-bit types
+	 * We're loading values from sym[] which later will be used to
+	 * load something.
+	 * => Spectre V1 pattern, need to cap the index against
+	 * speculation.
 	 */
-	uint32_t *hashtab = elf->hashtab;
-	uint32_t nbuckets = hashtab[0];
-	uint32_t nchains = hashtab[1];
-	uint32_t *bucket = &hashtab[2];
-	uint32_t *chain = &bucket[nbuckets];
-	size_t n = 0;
+	n = confine_array_index(n, elf->num_dynsyms);
 
 	if (elf->is_32bit) {
 		Elf32_Sym *sym = elf->dynsymtab;
 
-		for (n = bucket[hash % nbuckets]; n; n = chain[n]) {
-			if (n >= nchains || n >= elf->num_dynsyms)
-				err(TEE_ERROR_BAD_FORMAT,
-				    "Index out of range");
-			/*
-			 * We're loading values from sym[] which later
-			 * will be used to load something.
-			 * => Spectre V1 pattern, need to cap the index
-			 * against speculation.
-			 */
-			n = confine_array_index(n, elf->num_dynsyms);
-			if (__resolve_sym(elf,
-					  ELF32_ST_BIND(sym[n].st_info),
-					  ELF32_ST_TYPE(sym[n].st_info),
-					  sym[n].st_shndx,
-					  sym[n].st_name,
-					  sym[n].st_value, name, val, weak_ok))
-				return TEE_SUCCESS;
-		}
+		return __resolve_sym(elf, ELF32_ST_BIND(sym[n].st_info),
+				     ELF32_ST_TYPE(sym[n].st_info),
+				     sym[n].st_shndx, sym[n].st_name,
+				     sym[n].st_value, name, val, weak_ok);
 	} else {
 		Elf64_Sym *sym = elf->dynsymtab;
 
-		for (n = bucket[hash % nbuckets]; n; n = chain[n]) {
-			if (n >= nchains || n >= elf->num_dynsyms)
-				err(TEE_ERROR_BAD_FORMAT,
-				    "Index out of range");
-			/*
-			 * We're loading values from sym[] which later
-			 * will be used to load something.
-			 * => Spectre V1 pattern, need to cap the index
-			 * against speculation.
-			 */
-			n = confine_array_index(n, elf->num_dynsyms);
-			if (__resolve_sym(elf,
-					  ELF64_ST_BIND(sym[n].st_info),
-					  ELF64_ST_TYPE(sym[n].st_info),
-					  sym[n].st_shndx,
-					  sym[n].st_name,
-					  sym[n].st_value, name, val, weak_ok))
-				return TEE_SUCCESS;
+		return __resolve_sym(elf, ELF64_ST_BIND(sym[n].st_info),
+				     ELF64_ST_TYPE(sym[n].st_info),
+				     sym[n].st_shndx, sym[n].st_name,
+				     sym[n].st_value, name, val, weak_ok);
+	}
+}
+
+/*
+ * Looks up a symbol using the DT_GNU_HASH table. The bloom filter lets
+ * most lookups of symbols not defined in @elf return without touching
+ * the buckets or the symbol table. The layout of the table is checked
+ * in check_gnu_hashtab().
+ */
+static TEE_Result resolve_sym_gnu(struct sym_name *sn, vaddr_t *val,
+				  struct ta_elf *elf, bool weak_ok)
+{
+	uint32_t *hashtab = elf->gnu_hashtab;
+	uint32_t nbuckets = hashtab[0];
+	uint32_t symoffset = hashtab[1];
+	uint32_t bloom_size = hashtab[2];
+	uint32_t bloom_shift = hashtab[3];
+	uint32_t hash = get_gnu_hash(sn);
+	uint32_t *bucket = NULL;
+	uint32_t *chain = NULL;
+	uint32_t h2 = 0;
+	size_t n = 0;
+
+	if (elf->is_32bit) {
+		uint32_t *bloom = &hashtab[4];
+		uint32_t word = bloom[(hash / 32) & (bloom_size - 1)];
+		uint32_t mask = BIT32(hash % 32) |
+				BIT32((hash >> bloom_shift) % 32);
+
+		if ((word & mask) != mask)
+			return TEE_ERROR_ITEM_NOT_FOUND;
+		bucket = &bloom[bloom_size];
+	} else {
+		uint64_t *bloom = (uint64_t *)&hashtab[4];
+		uint64_t word = bloom[(hash / 64) & (bloom_size - 1)];
+		uint64_t mask = BIT64(hash % 64) |
+				BIT64((hash >> bloom_shift) % 64);
+
+		if ((word & mask) != mask)
+			return TEE_ERROR_ITEM_NOT_FOUND;
+		bucket = (uint32_t *)&bloom[bloom_size];
+	}
+	chain = &bucket[nbuckets];
+
+	n = bucket[hash % nbuckets];
+	if (!n)
+		return TEE_ERROR_ITEM_NOT_FOUND;
+
+	while (true) {
+		if (n < symoffset || n >= elf->num_dynsyms)
+			err(TEE_ERROR_BAD_FORMAT, "Index out of range");
+		h2 = chain[confine_array_index(n - symoffset,
+					       elf->num_dynsyms - symoffset)];
+		if ((h2 | 1) == (hash | 1) &&
+		    resolve_sym_idx(elf, n, sn->name, val, weak_ok))
+			return TEE_SUCCESS;
+		/* The lowest bit marks the end of the chain */
+		if (h2 & 1)
+			break;
+		n++;
+	}
+
+	return TEE_ERROR_ITEM_NOT_FOUND;
+}
+
+/*
+ * Undefined symbols are not part of the DT_GNU_HASH table, only symbols
+ * from index symoffset and onwards are. Weak undefined symbols are
+ * instead found by scanning the symbols below symoffset, which is only
+ * done as a last resort when no module defines the symbol.
+ */
+static TEE_Result resolve_weak_undef_gnu(struct sym_name *sn, vaddr_t *val,
+					 struct ta_elf *elf)
+{
+	uint32_t *hashtab = elf->gnu_hashtab;
+	size_t n = 0;
+
+	for (n = 1; n < hashtab[1]; n++) {
+		unsigned int st_bind = 0;
+		size_t st_shndx = 0;
+
+		if (elf->is_32bit) {
+			Elf32_Sym *sym = elf->dynsymtab;
+
+			st_bind = ELF32_ST_BIND(sym[n].st_info);
+			st_shndx = sym[n].st_shndx;
+		} else {
+			Elf64_Sym *sym = elf->dynsymtab;
+
+			st_bind = ELF64_ST_BIND(sym[n].st_info);
+			st_shndx = sym[n].st_shndx;
 		}
+		if (st_bind == STB_WEAK && st_shndx == SHN_UNDEF &&
+		    resolve_sym_idx(elf, n, sn->name, val, true /* weak_ok */))
+			return TEE_SUCCESS;
+	}
+
+	return TEE_ERROR_ITEM_NOT_FOUND;
+}
+
+static TEE_Result resolve_sym_helper(struct sym_name *sn, vaddr_t *val,
+				     struct ta_elf *elf, bool weak_ok)
+{
+	/*
+	 * Using uint32_t here for convenience because both Elf64_Word
+	 * and Elf32_Word are 32-bit types
+	 */
+	uint32_t *hashtab = elf->hashtab;
+	uint32_t nbuckets = 0;
+	uint32_t nchains = 0;
+	uint32_t *bucket = NULL;
+	uint32_t *chain = NULL;
+	size_t n = 0;
+
+	if (elf->gnu_hashtab)
+		return resolve_sym_gnu(sn, val, elf, weak_ok);
+
+	nbuckets = hashtab[0];
+	nchains = hashtab[1];
+	bucket = &hashtab[2];
+	chain = &bucket[nbuckets];
+
+	for (n = bucket[get_elf_hash(sn) % nbuckets]; n; n = chain[n]) {
+		if (n >= nchains || n >= elf->num_dynsyms)
+			err(TEE_ERROR_BAD_FORMAT, "Index out of range");
+		if (resolve_sym_idx(elf, n, sn->name, val, weak_ok))
+			return TEE_SUCCESS;
 	}
 
 	return TEE_ERROR_ITEM_NOT_FOUND;
@@ -154,28 +289,28 @@ TEE_Result ta_elf_resolve_sym(const char *name, vaddr_t *val,
 			      struct ta_elf **found_elf,
 			      struct ta_elf *elf)
 {
-	uint32_t hash = elf_hash(name);
+	struct sym_name sn = { .name = name };
 
 	if (elf) {
 		/* Search global symbols */
-		if (!resolve_sym_helper(hash, name, val, elf,
-					false /* !weak_ok */))
+		if (!resolve_sym_helper(&sn, val, elf, false /* !weak_ok */))
 			goto success;
 		/* Search weak symbols */
-		if (!resolve_sym_helper(hash, name, val, elf,
-					true /* weak_ok */))
+		if (!resolve_sym_helper(&sn, val, elf, true /* weak_ok */))
 			goto success;
 	}
 
 	TAILQ_FOREACH(elf, &main_elf_queue, link) {
-		if (!resolve_sym_helper(hash, name, val, elf,
-					false /* !weak_ok */))
+		if (!resolve_sym_helper(&sn, val, elf, false /* !weak_ok */))
 			goto success;
-		if (!resolve_sym_helper(hash, name, val, elf,
-					true /* weak_ok */))
+		if (!resolve_sym_helper(&sn, val, elf, true /* weak_ok */))
 			goto success;
 	}
 
+	TAILQ_FOREACH(elf, &main_elf_queue, link)
+		if (elf->gnu_hashtab && !resolve_weak_undef_gnu(&sn, val, elf))
+			goto success;
+
 	return TEE_ERROR_ITEM_NOT_FOUND;
 
 success:
@@ -252,6 +387,51 @@ static void e32_tls_resolve(const Elf32_Sym *sym_tab, size_t num_syms,
 	resolve_sym(name, val, NULL);
 }
 
+/*
+ * The linker sorts the R_*_RELATIVE relocations first in DT_RELA or
+ * DT_REL and records how many they are in DT_RELACOUNT or DT_RELCOUNT.
+ * Those are already applied if the ELF was prelinked by
+ * scripts/sign_encrypt.py for the address it's loaded at.
+ */
+static size_t num_prelinked_rels(struct ta_elf *elf, vaddr_t sh_addr,
+				 size_t num_rels)
+{
+	if (!elf->prelinked || elf->prelink_base != elf->load_addr ||
+	    !elf->rel_addr || sh_addr != elf->rel_addr)
+		return 0;
+
+	return MIN(elf->relative_count, num_rels);
+}
+
+static bool is_jmprel(struct ta_elf *elf, vaddr_t rel)
+{
+	vaddr_t jmprel = elf->load_addr + elf->jmprel;
+
+	return rel >= jmprel && rel - jmprel < elf->pltrelsz;
+}
+
+/*
+ * When @elf is bound lazily the PLT relocations are only checked here,
+ * the symbol is resolved by ta_elf_lazy_bind() when first called. Until
+ * then the GOT entry points to the first PLT entry which calls
+ * plt_lazy_resolve() via GOT[2].
+ */
+static bool e32_defer_rel(struct ta_elf *elf, const Elf32_Sym *sym_tab,
+			  size_t num_syms, const char *str_tab,
+			  size_t str_tab_size, Elf32_Rel *rel,
+			  Elf32_Addr *where)
+{
+	const char *name = NULL;
+
+	if (!elf->lazy_bind || sym_tab != elf->dynsymtab ||
+	    !is_jmprel(elf, (vaddr_t)rel))
+		return false;
+
+	e32_get_sym_name(sym_tab, num_syms, str_tab, str_tab_size, rel, &name);
+	*where += elf->load_addr;
+	return true;
+}
+
 static void e32_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 {
 	Elf32_Shdr *shdr = elf->shdr;
@@ -321,6 +501,7 @@ static void e32_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 	rel = (Elf32_Rel *)(elf->load_addr + shdr[rel_sidx].sh_addr);
 
 	rel_end = rel + shdr[rel_sidx].sh_size / sizeof(Elf32_Rel);
+	rel += num_prelinked_rels(elf, shdr[rel_sidx].sh_addr, rel_end - rel);
 	for (; rel < rel_end; rel++) {
 		struct ta_elf *mod = NULL;
 		Elf32_Addr *where = NULL;
@@ -363,13 +544,18 @@ static void e32_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 			*where += sym_tab[sym_idx].st_value - rel->r_offset;
 			break;
 		case R_ARM_RELATIVE:
-			*where += elf->load_addr;
+			/* Prelinked addends already include prelink_base */
+			*where += elf->load_addr - elf->prelink_base;
 			break;
 		case R_ARM_GLOB_DAT:
 		case R_ARM_JUMP_SLOT:
 			if (!sym_tab)
 				err(TEE_ERROR_BAD_FORMAT,
 				    "Missing symbol table");
+			if (ELF32_R_TYPE(rel->r_info) == R_ARM_JUMP_SLOT &&
+			    e32_defer_rel(elf, sym_tab, num_syms, str_tab,
+					  str_tab_size, rel, where))
+				break;
 			e32_process_dyn_rel(sym_tab, num_syms, str_tab,
 					    str_tab_size, rel, where);
 			break;
@@ -397,6 +583,73 @@ static void e32_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 	}
 }
 
+/*
+ * DT_RELR holds R_*_RELATIVE relocations packed as an array of words. An
+ * even word is the offset of the next word to relocate. An odd word is a
+ * bitmap where bit n + 1 tells if the nth word following the last
+ * location is to be relocated, each bitmap covers 31 or 63 words.
+ */
+static void check_relr(struct ta_elf *elf, size_t entsize)
+{
+	vaddr_t end = 0;
+
+	if (elf->relrent && elf->relrent != entsize)
+		err(TEE_ERROR_BAD_FORMAT, "Bad DT_RELRENT");
+	if (!IS_ALIGNED(elf->relr, entsize) || elf->relrsz % entsize)
+		err(TEE_ERROR_BAD_FORMAT, "Bad DT_RELR alignment");
+	if (ADD_OVERFLOW(elf->relr, elf->relrsz, &end) ||
+	    end > elf->max_addr - elf->load_addr)
+		err(TEE_ERROR_BAD_FORMAT, "DT_RELR out of range");
+}
+
+static void check_relr_range(struct ta_elf *elf, vaddr_t offs, size_t len)
+{
+	vaddr_t end = 0;
+
+	if (ADD_OVERFLOW(offs, len, &end) ||
+	    end > elf->max_addr - elf->load_addr)
+		err(TEE_ERROR_BAD_FORMAT, "Relocation offset out of range");
+}
+
+static void e32_relocate_relr(struct ta_elf *elf, Elf32_Addr delta)
+{
+	const Elf32_Addr *relr = NULL;
+	const Elf32_Addr *relr_end = NULL;
+	Elf32_Addr *where = NULL;
+	const size_t nbits = sizeof(Elf32_Addr) * 8 - 1;
+
+	check_relr(elf, sizeof(Elf32_Addr));
+	relr = (const Elf32_Addr *)(elf->load_addr + elf->relr);
+	relr_end = relr + elf->relrsz / sizeof(Elf32_Addr);
+
+	for (; relr < relr_end; relr++) {
+		uint32_t bits = *relr;
+		Elf32_Addr *w = NULL;
+
+		if (!(bits & 1)) {
+			if (!IS_ALIGNED(bits, sizeof(Elf32_Addr)))
+				err(TEE_ERROR_BAD_FORMAT,
+				    "Unaligned relocation offset");
+			check_relr_range(elf, bits, sizeof(Elf32_Addr));
+			where = (Elf32_Addr *)(elf->load_addr + bits);
+			*where++ += delta;
+			continue;
+		}
+
+		if (!where)
+			err(TEE_ERROR_BAD_FORMAT, "DT_RELR bitmap first");
+		bits >>= 1;
+		if (bits)
+			check_relr_range(elf, (vaddr_t)where - elf->load_addr,
+					 (32 - __builtin_clz(bits)) *
+					 sizeof(Elf32_Addr));
+		for (w = where; bits; bits >>= 1, w++)
+			if (bits & 1)
+				*w += delta;
+		where += nbits;
+	}
+}
+
 #ifdef ARM64
 static void e64_get_sym_name(const Elf64_Sym *sym_tab, size_t num_syms,
 			     const char *str_tab, size_t str_tab_size,
@@ -480,6 +733,24 @@ static void e64_process_tlsdesc_rela(const Elf64_Sym *sym_tab, size_t num_syms,
 				   rela, where + 1, elf);
 }
 
+/* See e32_defer_rel() */
+static bool e64_defer_rela(struct ta_elf *elf, const Elf64_Sym *sym_tab,
+			   size_t num_syms, const char *str_tab,
+			   size_t str_tab_size, Elf64_Rela *rela,
+			   Elf64_Addr *where)
+{
+	const char *name = NULL;
+
+	if (!elf->lazy_bind || sym_tab != elf->dynsymtab ||
+	    !is_jmprel(elf, (vaddr_t)rela))
+		return false;
+
+	e64_get_sym_name(sym_tab, num_syms, str_tab, str_tab_size, rela,
+			 &name);
+	*where += elf->load_addr;
+	return true;
+}
+
 static void e64_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 {
 	Elf64_Shdr *shdr = elf->shdr;
@@ -549,6 +820,8 @@ static void e64_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 	rela = (Elf64_Rela *)(elf->load_addr + shdr[rel_sidx].sh_addr);
 
 	rela_end = rela + shdr[rel_sidx].sh_size / sizeof(Elf64_Rela);
+	rela += num_prelinked_rels(elf, shdr[rel_sidx].sh_addr,
+				   rela_end - rela);
 	for (; rela < rela_end; rela++) {
 		Elf64_Addr *where = NULL;
 		size_t sym_idx = 0;
@@ -588,6 +861,10 @@ static void e64_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 			break;
 		case R_AARCH64_GLOB_DAT:
 		case R_AARCH64_JUMP_SLOT:
+			if (ELF64_R_TYPE(rela->r_info) == R_AARCH64_JUMP_SLOT &&
+			    e64_defer_rela(elf, sym_tab, num_syms, str_tab,
+					   str_tab_size, rela, where))
+				break;
 			e64_process_dyn_rela(sym_tab, num_syms, str_tab,
 					     str_tab_size, rela, where);
 			break;
@@ -607,18 +884,168 @@ static void e64_relocate(struct ta_elf *elf, unsigned int rel_sidx)
 		}
 	}
 }
+
+static void e64_relocate_relr(struct ta_elf *elf, Elf64_Addr delta)
+{
+	const Elf64_Addr *relr = NULL;
+	const Elf64_Addr *relr_end = NULL;
+	Elf64_Addr *where = NULL;
+	const size_t nbits = sizeof(Elf64_Addr) * 8 - 1;
+
+	check_relr(elf, sizeof(Elf64_Addr));
+	relr = (const Elf64_Addr *)(elf->load_addr + elf->relr);
+	relr_end = relr + elf->relrsz / sizeof(Elf64_Addr);
+
+	for (; relr < relr_end; relr++) {
+		uint64_t bits = *relr;
+		Elf64_Addr *w = NULL;
+
+		if (!(bits & 1)) {
+			if (!IS_ALIGNED(bits, sizeof(Elf64_Addr)))
+				err(TEE_ERROR_BAD_FORMAT,
+				    "Unaligned relocation offset");
+			check_relr_range(elf, bits, sizeof(Elf64_Addr));
+			where = (Elf64_Addr *)(elf->load_addr + bits);
+			*where++ += delta;
+			continue;
+		}
+
+		if (!where)
+			err(TEE_ERROR_BAD_FORMAT, "DT_RELR bitmap first");
+		bits >>= 1;
+		if (bits)
+			check_relr_range(elf, (vaddr_t)where - elf->load_addr,
+					 (64 - __builtin_clzll(bits)) *
+					 sizeof(Elf64_Addr));
+		for (w = where; bits; bits >>= 1, w++)
+			if (bits & 1)
+				*w += delta;
+		where += nbits;
+	}
+}
 #else /*ARM64*/
 static void __noreturn e64_relocate(struct ta_elf *elf __unused,
 				    unsigned int rel_sidx __unused)
 {
 	err(TEE_ERROR_NOT_SUPPORTED, "arm64 not supported");
 }
+
+static void __noreturn e64_relocate_relr(struct ta_elf *elf __unused,
+					 uint64_t delta __unused)
+{
+	err(TEE_ERROR_NOT_SUPPORTED, "arm64 not supported");
+}
 #endif /*ARM64*/
 
+/* Helper function written in assembly, entered from the first PLT entry */
+void plt_lazy_resolve(void);
+
+/*
+ * Called by plt_lazy_resolve() the first time a function is called via a
+ * PLT entry of @elf. Resolves relocation @idx of DT_JMPREL, updates the
+ * GOT entry so that subsequent calls go straight to the function and
+ * returns the address of the function.
+ */
+vaddr_t ta_elf_lazy_bind(struct ta_elf *elf, size_t idx);
+
+vaddr_t ta_elf_lazy_bind(struct ta_elf *elf, size_t idx)
+{
+#ifdef ARM64
+	Elf64_Rela *rel = (Elf64_Rela *)(elf->load_addr + elf->jmprel);
+#else
+	Elf32_Rel *rel = (Elf32_Rel *)(elf->load_addr + elf->jmprel);
+#endif
+	size_t num_rels = elf->pltrelsz / sizeof(*rel);
+	const char *name = NULL;
+	vaddr_t *where = NULL;
+	vaddr_t val = 0;
+
+	sys_lazy_binding = true;
+
+	if (idx >= num_rels)
+		err(TEE_ERROR_BAD_FORMAT, "PLT relocation out of range");
+	rel += confine_array_index(idx, num_rels);
+
+#ifdef ARM64
+	if (ELF64_R_TYPE(rel->r_info) != R_AARCH64_JUMP_SLOT)
+		err(TEE_ERROR_BAD_FORMAT, "Unexpected PLT relocation type");
+	e64_get_sym_name(elf->dynsymtab, elf->num_dynsyms, elf->dynstr,
+			 elf->dynstr_size, rel, &name);
+#else
+	if (ELF32_R_TYPE(rel->r_info) != R_ARM_JUMP_SLOT)
+		err(TEE_ERROR_BAD_FORMAT, "Unexpected PLT relocation type");
+	e32_get_sym_name(elf->dynsymtab, elf->num_dynsyms, elf->dynstr,
+			 elf->dynstr_size, rel, &name);
+#endif
+
+	if (rel->r_offset > elf->max_addr - elf->load_addr - sizeof(*where))
+		err(TEE_ERROR_BAD_FORMAT, "Relocation offset out of range");
+	where = (vaddr_t *)(elf->load_addr + rel->r_offset);
+
+	resolve_sym(name, &val, NULL);
+	*where = val;
+
+	sys_lazy_binding = false;
+
+	return val;
+}
+
+/*
+ * Lazy binding requires a DT_JMPREL table and a GOT where GOT[1] and
+ * GOT[2] are reserved for the resolver. The resolver runs in ldelf so the
+ * TA must use the same register width as ldelf.
+ */
+static bool can_bind_lazily(struct ta_elf *elf)
+{
+	size_t rel_size = 0;
+	vaddr_t end = 0;
+
+	if (!IS_ENABLED(CFG_TA_LAZY_BINDING) || elf->bind_now)
+		return false;
+	if (!elf->pltgot || !elf->jmprel || !elf->pltrelsz ||
+	    !elf->dynsymtab)
+		return false;
+
+#ifdef ARM64
+	if (elf->is_32bit)
+		return false;
+	rel_size = sizeof(Elf64_Rela);
+#else
+	rel_size = sizeof(Elf32_Rel);
+#endif
+
+	if (elf->pltrelsz % rel_size)
+		err(TEE_ERROR_BAD_FORMAT, "Bad DT_PLTRELSZ");
+	if (ADD_OVERFLOW(elf->jmprel, elf->pltrelsz, &end) ||
+	    end > elf->max_addr - elf->load_addr)
+		err(TEE_ERROR_BAD_FORMAT, "DT_JMPREL out of range");
+	if (!IS_ALIGNED_WITH_TYPE(elf->pltgot, vaddr_t) ||
+	    ADD_OVERFLOW(elf->pltgot, 3 * sizeof(vaddr_t), &end) ||
+	    end > elf->max_addr - elf->load_addr)
+		err(TEE_ERROR_BAD_FORMAT, "DT_PLTGOT out of range");
+
+	return true;
+}
+
 void ta_elf_relocate(struct ta_elf *elf)
 {
 	size_t n = 0;
 
+	elf->lazy_bind = can_bind_lazily(elf);
+
+	/*
+	 * DT_RELR is already applied if the ELF was prelinked by
+	 * scripts/sign_encrypt.py for the address it's loaded at.
+	 */
+	if (elf->relr && elf->relrsz && elf->load_addr != elf->prelink_base) {
+		if (elf->is_32bit)
+			e32_relocate_relr(elf, elf->load_addr -
+					       elf->prelink_base);
+		else
+			e64_relocate_relr(elf, elf->load_addr -
+					       elf->prelink_base);
+	}
+
 	if (elf->is_32bit) {
 		Elf32_Shdr *shdr = elf->shdr;
 
@@ -633,4 +1060,12 @@ void ta_elf_relocate(struct ta_elf *elf)
 				e64_relocate(elf, n);
 
 	}
+
+	if (elf->lazy_bind) {
+		vaddr_t *got = (vaddr_t *)(elf->load_addr + elf->pltgot);
+
+		/* GOT[1] and GOT[2] are used by the first PLT entry */
+		got[1] = (vaddr_t)elf;
+		got[2] = (vaddr_t)plt_lazy_resolve;
+	}
 }
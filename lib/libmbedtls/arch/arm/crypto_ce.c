@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: BSD-2-Clause
+/*
+ * Copyright (c) 2026, agent
+ */
+
+/*
+ * Block functions of mbed TLS implemented with the ARMv8 Cryptographic
+ * Extensions, using the assembly routines of the core in
+ * core/arch/arm/crypto. The VFP/NEON unit is enabled lazily by the core
+ * for user mode so it is used here as any other instruction.
+ */
+
+#include <mbedtls/aes.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/sha1.h>
+#include <mbedtls/sha256.h>
+#include <stdint.h>
+#include <string.h>
+#include <utee_defines.h>
+
+/* Prototypes for assembly functions, see core/arch/arm/crypto */
+uint32_t ce_aes_sub(uint32_t in);
+void ce_aes_invert(void *dst, const void *src);
+void ce_aes_ecb_encrypt(uint8_t out[], uint8_t const in[], uint8_t const rk[],
+			int rounds, int blocks, int first);
+void ce_aes_ecb_decrypt(uint8_t out[], uint8_t const in[], uint8_t const rk[],
+			int rounds, int blocks, int first);
+
+void sha1_ce_transform(uint32_t state[5], const void *src,
+		       unsigned int block_count);
+void sha256_ce_transform(uint32_t state[8], const void *src,
+			 unsigned int block_count);
+
+struct internal_ghash_key {
+	uint64_t h[2];
+	uint64_t h2[2];
+	uint64_t h3[2];
+	uint64_t h4[2];
+};
+
+void pmull_ghash_update_p64(int blocks, uint64_t dg[2], const uint8_t *src,
+			    const struct internal_ghash_key *ghash_key,
+			    const uint8_t *head);
+void pmull_ghash_update_p8(int blocks, uint64_t dg[2], const uint8_t *src,
+			   const struct internal_ghash_key *ghash_key,
+			   const uint8_t *head);
+
+/* Used by the hooks in mbedtls/library/gcm.c */
+void mbedtls_internal_gcm_mult(unsigned char output[16],
+			       const unsigned char x[16],
+			       uint64_t hh, uint64_t hl);
+
+struct aes_block {
+	uint8_t b[TEE_AES_BLOCK_SIZE];
+};
+
+static uint32_t ror32(uint32_t val, unsigned int shift)
+{
+	return (val >> shift) | (val << (32 - shift));
+}
+
+/* Same key schedule as in core/arch/arm/crypto/aes_armv8a_ce.c */
+static void expand_enc_key(uint32_t *enc_key, size_t key_len)
+{
+	/* The AES key schedule round constants */
+	static uint8_t const rcon[] = {
+		0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36,
+	};
+	unsigned int kwords = key_len / sizeof(uint32_t);
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(rcon); i++) {
+		uint32_t *rki = enc_key + i * kwords;
+		uint32_t *rko = rki + kwords;
+
+		rko[0] = ror32(ce_aes_sub(rki[kwords - 1]), 8) ^
+			 rcon[i] ^ rki[0];
+		rko[1] = rko[0] ^ rki[1];
+		rko[2] = rko[1] ^ rki[2];
+		rko[3] = rko[2] ^ rki[3];
+
+		if (key_len == 24) {
+			if (i >= 7)
+				break;
+			rko[4] = rko[3] ^ rki[4];
+			rko[5] = rko[4] ^ rki[5];
+		} else if (key_len == 32) {
+			if (i >= 6)
+				break;
+			rko[4] = ce_aes_sub(rko[3]) ^ rki[4];
+			rko[5] = rko[4] ^ rki[5];
+			rko[6] = rko[5] ^ rki[6];
+			rko[7] = rko[6] ^ rki[7];
+		}
+	}
+}
+
+static int set_enc_key(mbedtls_aes_context *ctx, const unsigned char *key,
+		       unsigned int keybits)
+{
+	size_t key_len = keybits / 8;
+
+	if (!ctx || !key)
+		return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+	if (keybits != 128 && keybits != 192 && keybits != 256)
+		return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+
+	ctx->nr = 10 + ((key_len / 8) - 2) * 2;
+	ctx->rk = ctx->buf;
+	memset(ctx->buf, 0, sizeof(ctx->buf));
+	memcpy(ctx->buf, key, key_len);
+	expand_enc_key(ctx->rk, key_len);
+
+	return 0;
+}
+
+int mbedtls_aes_setkey_enc(mbedtls_aes_context *ctx, const unsigned char *key,
+			   unsigned int keybits)
+{
+	return set_enc_key(ctx, key, keybits);
+}
+
+int mbedtls_aes_setkey_dec(mbedtls_aes_context *ctx, const unsigned char *key,
+			   unsigned int keybits)
+{
+	mbedtls_aes_context enc_ctx = { };
+	struct aes_block *key_enc = NULL;
+	struct aes_block *key_dec = NULL;
+	unsigned int i = 0;
+	int j = 0;
+	int res = 0;
+
+	res = set_enc_key(&enc_ctx, key, keybits);
+	if (res)
+		return res;
+
+	ctx->nr = enc_ctx.nr;
+	ctx->rk = ctx->buf;
+
+	/*
+	 * Generate the decryption keys for the Equivalent Inverse Cipher,
+	 * as make_dec_key() in core/arch/arm/crypto/aes_armv8a_ce.c
+	 */
+	key_enc = (struct aes_block *)enc_ctx.rk;
+	key_dec = (struct aes_block *)ctx->rk;
+	j = ctx->nr;
+	key_dec[0] = key_enc[j];
+	for (i = 1, j--; j > 0; i++, j--)
+		ce_aes_invert(key_dec + i, key_enc + j);
+	key_dec[i] = key_enc[0];
+
+	mbedtls_platform_zeroize(&enc_ctx, sizeof(enc_ctx));
+
+	return 0;
+}
+
+int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx,
+				 const unsigned char input[16],
+				 unsigned char output[16])
+{
+	ce_aes_ecb_encrypt(output, input, (const uint8_t *)ctx->rk, ctx->nr,
+			   1, 1);
+
+	return 0;
+}
+
+int mbedtls_internal_aes_decrypt(mbedtls_aes_context *ctx,
+				 const unsigned char input[16],
+				 unsigned char output[16])
+{
+	ce_aes_ecb_decrypt(output, input, (const uint8_t *)ctx->rk, ctx->nr,
+			   1, 1);
+
+	return 0;
+}
+
+void mbedtls_internal_gcm_mult(unsigned char output[16],
+			       const unsigned char x[16],
+			       uint64_t hh, uint64_t hl)
+{
+	struct internal_ghash_key key = { };
+	uint64_t dg[2] = { };
+	uint64_t out[2] = { };
+
+	/*
+	 * H in the reflected representation used by the PMULL routines,
+	 * see ghash_reflect() in core/arch/arm/crypto/aes-gcm-ce.c. Only
+	 * the first power of H is used when hashing a single block.
+	 */
+	key.h[0] = (hl << 1) | (hh >> 63);
+	key.h[1] = (hh << 1) | (hl >> 63);
+	if (hh >> 63)
+		key.h[1] ^= 0xc200000000000000ULL;
+
+#ifdef CFG_HWSUPP_PMULT_64
+	pmull_ghash_update_p64(1, dg, x, &key, NULL);
+#else
+	pmull_ghash_update_p8(1, dg, x, &key, NULL);
+#endif
+
+	out[0] = TEE_U64_TO_BIG_ENDIAN(dg[1]);
+	out[1] = TEE_U64_TO_BIG_ENDIAN(dg[0]);
+	memcpy(output, out, sizeof(out));
+}
+
+int mbedtls_internal_sha1_process(mbedtls_sha1_context *ctx,
+				  const unsigned char data[64])
+{
+	if (!ctx || !data)
+		return MBEDTLS_ERR_SHA1_BAD_INPUT_DATA;
+
+	sha1_ce_transform(ctx->state, data, 1);
+
+	return 0;
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
+				    const unsigned char data[64])
+{
+	if (!ctx || !data)
+		return MBEDTLS_ERR_SHA256_BAD_INPUT_DATA;
+
+	sha256_ce_transform(ctx->state, data, 1);
+
+	return 0;
+}
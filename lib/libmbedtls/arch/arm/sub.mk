@@ -0,0 +1,17 @@
+# The Cryptographic Extensions routines of the core in
+# core/arch/arm/crypto, each .S file here includes the core one.
+srcs-y += crypto_ce.c
+
+srcs-$(CFG_ARM64_$(sm)) += aes_modes_armv8a_ce_a64.S
+aflags-aes_modes_armv8a_ce_a64.S-y += -DINTERLEAVE=4
+srcs-$(CFG_ARM32_$(sm)) += aes_modes_armv8a_ce_a32.S
+
+srcs-$(CFG_ARM64_$(sm)) += sha1_armv8a_ce_a64.S
+srcs-$(CFG_ARM32_$(sm)) += sha1_armv8a_ce_a32.S
+srcs-$(CFG_ARM64_$(sm)) += sha256_armv8a_ce_a64.S
+srcs-$(CFG_ARM32_$(sm)) += sha256_armv8a_ce_a32.S
+
+srcs-$(CFG_ARM64_$(sm)) += ghash-ce-core_a64.S
+# For the mov_imm macro in <arm64_macros.S>
+incdirs-ghash-ce-core_a64.S-y += ../../../../core/arch/arm/include
+srcs-$(CFG_ARM32_$(sm)) += ghash-ce-core_a32.S
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <tee/tee_cryp_utl.h>
 #include <utee_defines.h>
+#include <util.h>
 
 #include "mbed_helpers.h"
 
@@ -126,6 +127,254 @@ static void mbd_rsa_free(mbedtls_rsa_context *rsa)
 	mbedtls_rsa_free(rsa);
 }
 
+/* The table of private_exp_mod() has 1 << PRIVATE_EXP_WSIZE entries */
+#define PRIVATE_EXP_WSIZE	4
+
+static unsigned char ct_is_equal(size_t a, size_t b)
+{
+	size_t d = a ^ b;
+
+	/* The top bit of d | -d is set unless d is zero */
+	return 1 ^ ((d | (0 - d)) >> (sizeof(d) * 8 - 1));
+}
+
+/*
+ * X = A^E mod N for a private exponent E, A must be below N. Unlike
+ * mbedtls_mpi_exp_mod() the exponent is processed in fixed windows: each
+ * window costs PRIVATE_EXP_WSIZE squarings and one multiplication by a
+ * table entry read with constant-time conditional assignments, so the
+ * sequence of operations and memory accesses only depends on the bit
+ * length of E.
+ */
+static int private_exp_mod(mbedtls_mpi *X, const mbedtls_mpi *A,
+			   const mbedtls_mpi *E, const mbedtls_mpi *N)
+{
+	mbedtls_mpi W[BIT(PRIVATE_EXP_WSIZE)] = { };
+	mbedtls_mpi RR = { };
+	mbedtls_mpi WW = { };
+	mbedtls_mpi T = { };
+	mbedtls_mpi_uint mm = 0;
+	size_t nlimbs = N->n;
+	size_t rbits = nlimbs * sizeof(mbedtls_mpi_uint) * 8;
+	size_t bit = 0;
+	size_t win = 0;
+	size_t n = 0;
+	int mres = 0;
+
+	for (n = 0; n < ARRAY_SIZE(W); n++)
+		mbedtls_mpi_init(W + n);
+	mbedtls_mpi_init(&RR);
+	mbedtls_mpi_init(&WW);
+	mbedtls_mpi_init(&T);
+
+	mbedtls_mpi_montg_init(&mm, N);
+
+	/* RR = R^2 mod N with R = 2^rbits */
+	mres = mbedtls_mpi_lset(&RR, 1);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_shift_l(&RR, 2 * rbits);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mod_mpi(&RR, &RR, N);
+	if (mres)
+		goto out;
+
+	/*
+	 * The Montgomery operations write as many limbs as N has, copies
+	 * don't shrink the destination so this is done only once.
+	 */
+	mres = mbedtls_mpi_grow(&T, nlimbs * 2 + 2);
+	if (!mres)
+		mres = mbedtls_mpi_grow(&WW, nlimbs + 1);
+	if (!mres)
+		mres = mbedtls_mpi_grow(X, nlimbs + 1);
+	for (n = 0; !mres && n < ARRAY_SIZE(W); n++)
+		mres = mbedtls_mpi_grow(W + n, nlimbs + 1);
+	if (mres)
+		goto out;
+
+	/* W[n] = A^n * R mod N */
+	mres = mbedtls_mpi_copy(W, &RR);
+	if (mres)
+		goto out;
+	mbedtls_mpi_montred(W, N, mm, &T);
+
+	mres = mbedtls_mpi_copy(W + 1, A);
+	if (mres)
+		goto out;
+	mbedtls_mpi_montmul(W + 1, &RR, N, mm, &T);
+
+	for (n = 2; n < ARRAY_SIZE(W); n++) {
+		mres = mbedtls_mpi_copy(W + n, W + n - 1);
+		if (mres)
+			goto out;
+		mbedtls_mpi_montmul(W + n, W + 1, N, mm, &T);
+	}
+
+	mres = mbedtls_mpi_copy(X, W);
+	if (mres)
+		goto out;
+
+	bit = ROUNDUP(mbedtls_mpi_bitlen(E), PRIVATE_EXP_WSIZE);
+	while (bit) {
+		win = 0;
+		for (n = 0; n < PRIVATE_EXP_WSIZE; n++) {
+			bit--;
+			mbedtls_mpi_montmul(X, X, N, mm, &T);
+			win = (win << 1) | mbedtls_mpi_get_bit(E, bit);
+		}
+
+		for (n = 0; n < ARRAY_SIZE(W); n++) {
+			mres = mbedtls_mpi_safe_cond_assign(&WW, W + n,
+							   ct_is_equal(n, win));
+			if (mres)
+				goto out;
+		}
+		mbedtls_mpi_montmul(X, &WW, N, mm, &T);
+	}
+
+	mbedtls_mpi_montred(X, N, mm, &T);
+out:
+	for (n = 0; n < ARRAY_SIZE(W); n++)
+		mbedtls_mpi_free(W + n);
+	mbedtls_mpi_free(&RR);
+	mbedtls_mpi_free(&WW);
+	mbedtls_mpi_free(&T);
+
+	return mres;
+}
+
+/*
+ * T = T^D mod N. With the CRT parameters of the key this is done with two
+ * exponentiations of half the size modulo P and Q, which is about four
+ * times faster. Keys imported without them use D.
+ */
+static int private_exp(mbedtls_rsa_context *rsa, mbedtls_mpi *T)
+{
+	mbedtls_mpi TP = { };
+	mbedtls_mpi TQ = { };
+	int mres = 0;
+
+	if (!mbedtls_mpi_size(&rsa->P))
+		return private_exp_mod(T, T, &rsa->D, &rsa->N);
+
+	mbedtls_mpi_init(&TP);
+	mbedtls_mpi_init(&TQ);
+
+	/* TP = T^DP mod P, TQ = T^DQ mod Q */
+	mres = mbedtls_mpi_mod_mpi(&TP, T, &rsa->P);
+	if (mres)
+		goto out;
+	mres = private_exp_mod(&TP, &TP, &rsa->DP, &rsa->P);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mod_mpi(&TQ, T, &rsa->Q);
+	if (mres)
+		goto out;
+	mres = private_exp_mod(&TQ, &TQ, &rsa->DQ, &rsa->Q);
+	if (mres)
+		goto out;
+
+	/* T = TQ + ((TP - TQ) * QP mod P) * Q */
+	mres = mbedtls_mpi_sub_mpi(&TP, &TP, &TQ);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mul_mpi(T, &TP, &rsa->QP);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mod_mpi(&TP, T, &rsa->P);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mul_mpi(T, &TP, &rsa->Q);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_add_mpi(T, T, &TQ);
+out:
+	mbedtls_mpi_free(&TP);
+	mbedtls_mpi_free(&TQ);
+
+	return mres;
+}
+
+/*
+ * Raw RSA private key operation on @rsa->len bytes with private_exp(). The
+ * input is blinded with a random r: (in * r^E)^D * r^-1 = in^D mod N. The
+ * result is checked with the public exponent, a fault in one of the CRT
+ * halves would otherwise give away a factor of N.
+ */
+static int mbd_rsa_private(mbedtls_rsa_context *rsa, const uint8_t *in,
+			   uint8_t *out)
+{
+	mbedtls_mpi T = { };
+	mbedtls_mpi I = { };
+	mbedtls_mpi R = { };
+	mbedtls_mpi Ri = { };
+	int mres = 0;
+
+	mbedtls_mpi_init(&T);
+	mbedtls_mpi_init(&I);
+	mbedtls_mpi_init(&R);
+	mbedtls_mpi_init(&Ri);
+
+	mres = mbedtls_mpi_read_binary(&T, in, rsa->len);
+	if (mres)
+		goto out;
+	if (mbedtls_mpi_cmp_mpi(&T, &rsa->N) >= 0) {
+		mres = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+		goto out;
+	}
+
+	/* r < N, without an inverse N is a multiple of r */
+	mres = mbedtls_mpi_fill_random(&R, rsa->len - 1, mbd_rand, NULL);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_inv_mod(&Ri, &R, &rsa->N);
+	if (mres)
+		goto out;
+
+	mres = mbedtls_mpi_exp_mod(&R, &R, &rsa->E, &rsa->N, NULL);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mul_mpi(&T, &T, &R);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mod_mpi(&T, &T, &rsa->N);
+	if (mres)
+		goto out;
+
+	mres = mbedtls_mpi_copy(&I, &T);
+	if (mres)
+		goto out;
+	mres = private_exp(rsa, &T);
+	if (mres)
+		goto out;
+
+	mres = mbedtls_mpi_exp_mod(&R, &T, &rsa->E, &rsa->N, NULL);
+	if (mres)
+		goto out;
+	if (mbedtls_mpi_cmp_mpi(&R, &I)) {
+		mres = MBEDTLS_ERR_RSA_VERIFY_FAILED;
+		goto out;
+	}
+
+	mres = mbedtls_mpi_mul_mpi(&T, &T, &Ri);
+	if (mres)
+		goto out;
+	mres = mbedtls_mpi_mod_mpi(&T, &T, &rsa->N);
+	if (mres)
+		goto out;
+
+	mres = mbedtls_mpi_write_binary(&T, out, rsa->len);
+out:
+	mbedtls_mpi_free(&T);
+	mbedtls_mpi_free(&I);
+	mbedtls_mpi_free(&R);
+	mbedtls_mpi_free(&Ri);
+
+	return mres;
+}
+
 TEE_Result crypto_acipher_alloc_rsa_keypair(struct rsa_keypair *s,
 					    size_t key_size_bits)
 {
@@ -321,9 +570,9 @@ TEE_Result crypto_acipher_rsanopad_decrypt(struct rsa_keypair *key,
 	memset(buf, 0, blen);
 	memcpy(buf + rsa.len - src_len, src, src_len);
 
-	lmd_res = mbedtls_rsa_private(&rsa, NULL, NULL, buf, buf);
+	lmd_res = mbd_rsa_private(&rsa, buf, buf);
 	if (lmd_res != 0) {
-		FMSG("mbedtls_rsa_private() returned 0x%x", -lmd_res);
+		FMSG("mbd_rsa_private() returned 0x%x", -lmd_res);
 		res = get_tee_result(lmd_res);
 		goto out;
 	}
@@ -11,6 +11,9 @@
 #endif
 #define MBEDTLS_BIGNUM_C
 #define MBEDTLS_GENPRIME
+#if defined(CFG_CORE_CRYPTO_MPI_ACCEL)
+#define MBEDTLS_MPI_MONTMUL_ALT
+#endif
 
 /* Test if Mbedtls is the primary crypto lib */
 #ifdef CFG_CRYPTOLIB_NAME_mbedtls
@@ -15,6 +15,21 @@
 #define MBEDTLS_CIPHER_C
 #define MBEDTLS_DES_C
 #define MBEDTLS_AES_C
+#define MBEDTLS_GCM_C
+
+#if defined(CFG_TA_MBEDTLS_ARM_CE)
+/*
+ * Only the block functions are replaced, the contexts keep the layout of
+ * the generic implementation. See lib/libmbedtls/arch/arm/crypto_ce.c
+ */
+#define MBEDTLS_AES_SETKEY_ENC_ALT
+#define MBEDTLS_AES_SETKEY_DEC_ALT
+#define MBEDTLS_AES_ENCRYPT_ALT
+#define MBEDTLS_AES_DECRYPT_ALT
+#define MBEDTLS_GCM_MULT_ALT
+#define MBEDTLS_SHA1_PROCESS_ALT
+#define MBEDTLS_SHA256_PROCESS_ALT
+#endif
 
 #define MBEDTLS_SHA1_C
 #define MBEDTLS_SHA256_C
@@ -57,6 +57,10 @@
 #include <mempool.h>
 #include <util.h>
 
+#if defined(MBEDTLS_MPI_MONTMUL_ALT)
+#include <crypto/crypto_accel.h>
+#endif
+
 #define MPI_VALIDATE_RET( cond )                                       \
     MBEDTLS_INTERNAL_VALIDATE_RET( cond, MBEDTLS_ERR_MPI_BAD_INPUT_DATA )
 #define MPI_VALIDATE( cond )                                           \
@@ -2227,6 +2231,12 @@ static void mpi_montmul( mbedtls_mpi *A, const mbedtls_mpi *B, const mbedtls_mpi
     n = N->n;
     m = ( B->n < n ) ? B->n : n;
 
+#if defined(MBEDTLS_MPI_MONTMUL_ALT)
+    if( n >= 2 && m == n )
+        /* d = (A * B + u * N) / R in n + 1 limbs, no final subtraction */
+        crypto_accel_mpi_montmul( d, A->p, B->p, N->p, mm, n );
+    else
+#endif
     for( i = 0; i < n; i++ )
     {
         /*
@@ -58,6 +58,16 @@
 #define GCM_VALIDATE( cond ) \
     MBEDTLS_INTERNAL_VALIDATE( cond )
 
+#if defined(MBEDTLS_GCM_MULT_ALT)
+/*
+ * Sets output to x times H, with H given as the two big-endian halves
+ * computed by gcm_gen_table().
+ */
+void mbedtls_internal_gcm_mult( unsigned char output[16],
+                                const unsigned char x[16],
+                                uint64_t hh, uint64_t hl );
+#endif
+
 /*
  * 32-bit integer manipulation macros (big endian)
  */
@@ -123,6 +133,11 @@ static int gcm_gen_table( mbedtls_gcm_context *ctx )
     ctx->HL[8] = vl;
     ctx->HH[8] = vh;
 
+#if defined(MBEDTLS_GCM_MULT_ALT)
+    /* Only h is needed by mbedtls_internal_gcm_mult() */
+    return( 0 );
+#endif
+
 #if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64)
     /* With CLMUL support, we need only h, not the rest of the table */
     if( mbedtls_aesni_has_support( MBEDTLS_AESNI_CLMUL ) )
@@ -219,6 +234,11 @@ static void gcm_mult( mbedtls_gcm_context *ctx, const unsigned char x[16],
     unsigned char lo, hi, rem;
     uint64_t zh, zl;
 
+#if defined(MBEDTLS_GCM_MULT_ALT)
+    mbedtls_internal_gcm_mult( output, x, ctx->HH[8], ctx->HL[8] );
+    return;
+#endif
+
 #if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64)
     if( mbedtls_aesni_has_support( MBEDTLS_AESNI_CLMUL ) ) {
         unsigned char h[16];
@@ -129,3 +129,7 @@ cflags-lib-y += -Wno-declaration-after-statement
 ifeq ($(CFG_CRYPTOLIB_NAME_mbedtls),y)
 subdirs-$(sm-core) += core
 endif
+
+ifneq ($(sm),core)
+subdirs-$(CFG_TA_MBEDTLS_ARM_CE) += arch/$(ARCH)
+endif
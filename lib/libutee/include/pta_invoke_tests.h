@@ -103,5 +103,44 @@
  */
 #define PTA_INVOKE_TESTS_CMD_MEMREF_NULL	10
 
+/*
+ * Crypto performance tests keyed by algorithm. Keys and contexts are set up
+ * before the measurement starts, which uses the system time and only has
+ * millisecond resolution so the repetition count should be chosen
+ * accordingly.
+ *
+ * [in]     value[0].a	Algorithm, one of TEE_ALG_AES_ECB_NOPAD,
+ *			TEE_ALG_AES_CBC_NOPAD, TEE_ALG_AES_CTR,
+ *			TEE_ALG_AES_XTS, TEE_ALG_AES_GCM,
+ *			TEE_ALG_CHACHA20_POLY1305, TEE_ALG_ECDH_P256,
+ *			TEE_ALG_ECDH_P384, TEE_ALG_X25519,
+ *			TEE_ALG_ECDSA_P256, TEE_ALG_ECDSA_P384,
+ *			TEE_ALG_ED25519 or
+ *			TEE_ALG_RSASSA_PKCS1_V1_5_SHA256
+ * [in]     value[0].b	TEE_MODE_ENCRYPT or TEE_MODE_DECRYPT for ciphers,
+ *			TEE_MODE_SIGN or TEE_MODE_VERIFY for signatures,
+ *			PTA_INVOKE_TESTS_BENCH_KEY_* for TEE_ALG_ECDH_P256,
+ *			ignored for other key agreement
+ * [in]     value[1].a	repetition count
+ * [in]     value[1].b	key size in bits for ciphers and RSA, ignored
+ *			otherwise. RSA keys are generated with public
+ *			exponent 65537 and a size that is a multiple of 64.
+ * [out]    value[2].a	elapsed time in microseconds
+ * [out]    value[2].b	picoseconds per processed byte for ciphers,
+ *			operations per second otherwise
+ * [in/out] memref[3]	buffer processed in place by ciphers, must be
+ *			TEE_PARAM_TYPE_NONE otherwise
+ */
+#define PTA_INVOKE_TESTS_CMD_CRYPTO_BENCH	11
+
+/*
+ * Private key of the TEE_ALG_ECDH_P256 crypto bench, either a generated
+ * one or one of the scalars 1 and n - 1. Those are the extremes in bit
+ * weight, comparing the two shows whether the time depends on the key.
+ */
+#define PTA_INVOKE_TESTS_BENCH_KEY_RANDOM	0
+#define PTA_INVOKE_TESTS_BENCH_KEY_ONE		1
+#define PTA_INVOKE_TESTS_BENCH_KEY_N_MINUS_1	2
+
 #endif /*__PTA_INVOKE_TESTS_H*/
 
@@ -198,6 +198,8 @@
 #define TEE_ALG_ECDH_P384                       0x80004042
 #define TEE_ALG_ECDH_P521                       0x80005042
 #define TEE_ALG_SM2_PKE                         0x80000045
+#define TEE_ALG_ED25519                         0x70006043
+#define TEE_ALG_X25519                          0x80000044
 #define TEE_ALG_SM3                             0x50000007
 #define TEE_ALG_ILLEGAL_VALUE                   0xEFFFFFFF
 
@@ -229,6 +231,9 @@
 #define TEE_TYPE_SM2_KEP_KEYPAIR            0xA1000046
 #define TEE_TYPE_SM2_PKE_PUBLIC_KEY         0xA0000047
 #define TEE_TYPE_SM2_PKE_KEYPAIR            0xA1000047
+#define TEE_TYPE_ED25519_PUBLIC_KEY         0xA0000043
+#define TEE_TYPE_ED25519_KEYPAIR            0xA1000043
+#define TEE_TYPE_X25519_KEYPAIR             0xA1000044
 #define TEE_TYPE_GENERIC_SECRET             0xA0000000
 #define TEE_TYPE_CORRUPTED_OBJECT           0xA00000BE
 #define TEE_TYPE_DATA                       0xA00000BF
@@ -268,6 +273,12 @@
 #define TEE_ATTR_SM2_KEP_CONFIRMATION_OUT   0xD0000846
 #define TEE_ATTR_ECC_EPHEMERAL_PUBLIC_VALUE_X 0xD0000946 /* Missing in 1.2.1 */
 #define TEE_ATTR_ECC_EPHEMERAL_PUBLIC_VALUE_Y 0xD0000A46 /* Missing in 1.2.1 */
+#define TEE_ATTR_EDDSA_PREHASH              0xF0000004
+#define TEE_ATTR_EDDSA_CTX                  0xD0000643
+#define TEE_ATTR_ED25519_PUBLIC_VALUE       0xD0000743
+#define TEE_ATTR_ED25519_PRIVATE_VALUE      0xC0000843
+#define TEE_ATTR_X25519_PUBLIC_VALUE        0xD0000944
+#define TEE_ATTR_X25519_PRIVATE_VALUE       0xC0000A44
 
 #define TEE_ATTR_FLAG_PUBLIC		(1 << 28)
 #define TEE_ATTR_FLAG_VALUE		(1 << 29)
@@ -289,6 +300,14 @@
 #define TEE_ECC_CURVE_NIST_P384             0x00000004
 #define TEE_ECC_CURVE_NIST_P521             0x00000005
 #define TEE_ECC_CURVE_SM2                   0x00000300
+/*
+ * GP Internal Core API v1.3 assigns 0x300 to Curve25519, but that value
+ * is already used by TEE_ECC_CURVE_SM2 above, so an OP-TEE specific value
+ * is used instead. It's only used with TEE_IsAlgorithmSupported() for
+ * TEE_ALG_X25519 and TEE_ALG_ED25519, these keys don't carry a
+ * TEE_ATTR_ECC_CURVE attribute.
+ */
+#define TEE_ECC_CURVE_25519                 0xF0000300
 
 
 /* Panicked Functions Identification */
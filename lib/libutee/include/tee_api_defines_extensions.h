@@ -70,6 +70,16 @@
 #define TEE_ATTR_PBKDF2_ITERATION_COUNT     0xF00003C2
 #define TEE_ATTR_PBKDF2_DKM_LENGTH          0xF00004C2
 
+/*
+ * ChaCha20-Poly1305 authenticated encryption
+ * RFC 8439 section 2.8, 256-bit key, 96-bit nonce and 128-bit tag
+ * https://www.ietf.org/rfc/rfc8439.txt
+ */
+
+#define TEE_ALG_CHACHA20_POLY1305           0x400000C3
+
+#define TEE_TYPE_CHACHA20                   0xA00000C3
+
 /*
  * PKCS#1 v1.5 RSASSA pre-hashed sign/verify
  */
@@ -78,4 +78,41 @@ TEE_Result tee_invoke_supp_plugin(const TEE_UUID *uuid, uint32_t cmd,
 				  uint32_t sub_cmd, void *buf, size_t len,
 				  size_t *outlen);
 
+/*
+ * struct tee_crypto_update - One update of tee_crypto_update_multiple()
+ * @operation:	Digest, MAC, cipher or AE operation
+ * @src:	Input data
+ * @src_len:	Length of @src
+ * @dst:	Output buffer, ignored for digest and MAC operations
+ * @dst_len:	[in] size of @dst, [out] number of bytes written to @dst, or
+ *		the required size if @res is TEE_ERROR_SHORT_BUFFER
+ * @res:	[out] TEE_SUCCESS or TEE_ERROR_SHORT_BUFFER
+ */
+struct tee_crypto_update {
+	TEE_OperationHandle operation;
+	const void *src;
+	uint32_t src_len;
+	void *dst;
+	uint32_t dst_len;
+	TEE_Result res;
+};
+
+/*
+ * tee_crypto_update_multiple() - Update several operations at once
+ * @upd:	Array of updates
+ * @count:	Number of updates in @upd
+ *
+ * Each update is equivalent to TEE_DigestUpdate(), TEE_MACUpdate(),
+ * TEE_CipherUpdate() or TEE_AEUpdate(), depending on the class of the
+ * operation, and the updates are done in the order of @upd. Updates that
+ * don't need to be buffered in the TA are passed to the TEE Core in
+ * batches, saving one system call per update. The functions above panic
+ * for the same reasons.
+ *
+ * Return TEE_SUCCESS if all updates are done or TEE_ERROR_SHORT_BUFFER if
+ * at least one of them had a too small output buffer and was skipped.
+ */
+TEE_Result tee_crypto_update_multiple(struct tee_crypto_update *upd,
+				      size_t count);
+
 #endif
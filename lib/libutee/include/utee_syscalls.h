@@ -148,6 +148,14 @@ TEE_Result _utee_authenc_dec_final(unsigned long state, const void *src_data,
 				   uint64_t *dest_len, const void *tag,
 				   size_t tag_len);
 
+/*
+ * Processes @count updates in a single call, in order. Stops at the first
+ * update that doesn't return TEE_SUCCESS and returns that result, the
+ * following updates are left untouched.
+ */
+TEE_Result _utee_cryp_update_vec(struct utee_cryp_update *upd,
+				 unsigned long count);
+
 TEE_Result _utee_asymm_operate(unsigned long state,
 			       const struct utee_attribute *params,
 			       unsigned long num_params, const void *src_data,
@@ -47,4 +47,33 @@ struct utee_attribute {
 	uint32_t attribute_id;
 };
 
+/* Update kinds of struct utee_cryp_update */
+#define UTEE_CRYP_UPDATE_HASH		0	/* Digest or MAC update */
+#define UTEE_CRYP_UPDATE_CIPHER		1	/* Cipher update */
+#define UTEE_CRYP_UPDATE_AE		2	/* AE payload update */
+
+/* Maximum number of updates in one call to _utee_cryp_update_vec() */
+#define UTEE_CRYP_UPDATE_MAX_COUNT	64
+
+/*
+ * One update passed to _utee_cryp_update_vec()
+ * @src:	input data, a pointer
+ * @src_len:	length of @src
+ * @dst:	output buffer, a pointer, unused with UTEE_CRYP_UPDATE_HASH
+ * @dst_len:	[in] size of @dst, [out] number of bytes written to @dst
+ * @state:	cryptographic state from _utee_cryp_state_alloc()
+ * @kind:	one of UTEE_CRYP_UPDATE_*
+ * @res:	[out] result of the update
+ */
+struct utee_cryp_update {
+	uint64_t src;
+	uint64_t src_len;
+	uint64_t dst;
+	uint64_t dst_len;
+	uint32_t state;
+	uint32_t kind;
+	uint32_t res;
+	uint32_t pad;
+};
+
 #endif /* UTEE_TYPES_H */
@@ -84,6 +84,8 @@ TEE_Result TEE_AllocateOperation(TEE_OperationHandle *operation,
 	case TEE_ALG_ECDH_P256:
 	case TEE_ALG_SM2_PKE:
 	case TEE_ALG_SM2_DSA_SM3:
+	case TEE_ALG_ED25519:
+	case TEE_ALG_X25519:
 		if (maxKeySize != 256)
 			return TEE_ERROR_NOT_SUPPORTED;
 		break;
@@ -94,6 +96,11 @@ TEE_Result TEE_AllocateOperation(TEE_OperationHandle *operation,
 			return TEE_ERROR_NOT_SUPPORTED;
 		break;
 
+	case TEE_ALG_CHACHA20_POLY1305:
+		if (maxKeySize != 256)
+			return TEE_ERROR_NOT_SUPPORTED;
+		break;
+
 	case TEE_ALG_ECDSA_P384:
 	case TEE_ALG_ECDH_P384:
 		if (maxKeySize != 384)
@@ -135,6 +142,7 @@ TEE_Result TEE_AllocateOperation(TEE_OperationHandle *operation,
 		fallthrough;
 	case TEE_ALG_AES_CTR:
 	case TEE_ALG_AES_GCM:
+	case TEE_ALG_CHACHA20_POLY1305:
 		if (mode == TEE_MODE_ENCRYPT)
 			req_key_usage = TEE_USAGE_ENCRYPT;
 		else if (mode == TEE_MODE_DECRYPT)
@@ -166,6 +174,7 @@ TEE_Result TEE_AllocateOperation(TEE_OperationHandle *operation,
 	case TEE_ALG_ECDSA_P384:
 	case TEE_ALG_ECDSA_P521:
 	case TEE_ALG_SM2_DSA_SM3:
+	case TEE_ALG_ED25519:
 		if (mode == TEE_MODE_SIGN) {
 			with_private_key = true;
 			req_key_usage = TEE_USAGE_SIGN;
@@ -210,6 +219,7 @@ TEE_Result TEE_AllocateOperation(TEE_OperationHandle *operation,
 	case TEE_ALG_ECDH_P256:
 	case TEE_ALG_ECDH_P384:
 	case TEE_ALG_ECDH_P521:
+	case TEE_ALG_X25519:
 	case TEE_ALG_HKDF_MD5_DERIVE_KEY:
 	case TEE_ALG_HKDF_SHA1_DERIVE_KEY:
 	case TEE_ALG_HKDF_SHA224_DERIVE_KEY:
@@ -1332,6 +1342,13 @@ TEE_Result TEE_AEInit(TEE_OperationHandle operation, const void *nonce,
 		}
 	}
 
+	/* RFC 8439 defines a single 128-bit tag for ChaCha20-Poly1305 */
+	if (operation->info.algorithm == TEE_ALG_CHACHA20_POLY1305 &&
+	    tagLen != 128) {
+		res = TEE_ERROR_NOT_SUPPORTED;
+		goto out;
+	}
+
 	res = _utee_authenc_init(operation->state, nonce, nonceLen, tagLen / 8,
 				 AADLen, payloadLen);
 	if (res != TEE_SUCCESS)
@@ -1448,6 +1465,167 @@ out:
 	return res;
 }
 
+/* Cryptographic Operations API - Batched updates extension */
+
+/* Number of updates passed to the TEE Core in one system call */
+#define CRYP_UPDATE_BATCH	16
+
+struct cryp_update_batch {
+	struct utee_cryp_update vec[CRYP_UPDATE_BATCH];
+	struct tee_crypto_update *upd[CRYP_UPDATE_BATCH];
+	size_t count;
+};
+
+static void cryp_update_flush(struct cryp_update_batch *b)
+{
+	TEE_Result res = TEE_SUCCESS;
+	size_t n = 0;
+
+	if (!b->count)
+		return;
+
+	/*
+	 * The output buffers have been checked already, as in
+	 * TEE_CipherUpdate() errors are fatal since the operations can't
+	 * be resynchronized.
+	 */
+	res = _utee_cryp_update_vec(b->vec, b->count);
+	if (res != TEE_SUCCESS)
+		TEE_Panic(res);
+
+	for (n = 0; n < b->count; n++)
+		b->upd[n]->dst_len = b->vec[n].dst_len;
+
+	b->count = 0;
+}
+
+static void cryp_update_add(struct cryp_update_batch *b,
+			    struct tee_crypto_update *upd, uint32_t kind)
+{
+	struct utee_cryp_update *v = b->vec + b->count;
+
+	v->src = (uintptr_t)upd->src;
+	v->src_len = upd->src_len;
+	v->dst = (uintptr_t)upd->dst;
+	v->dst_len = upd->dst_len;
+	v->state = upd->operation->state;
+	v->kind = kind;
+	v->res = TEE_SUCCESS;
+	b->upd[b->count] = upd;
+	b->count++;
+
+	upd->res = TEE_SUCCESS;
+
+	if (b->count == CRYP_UPDATE_BATCH)
+		cryp_update_flush(b);
+}
+
+/*
+ * Returns true if an update of @len bytes bypasses the block buffering
+ * in tee_buffer_update(), that is, if it's passed as is to the TEE Core.
+ */
+static bool update_is_unbuffered(TEE_OperationHandle op, size_t len)
+{
+	if (op->block_size <= 1)
+		return true;
+
+	return !op->buffer_two_blocks && !op->buffer_offs &&
+	       !(len % op->block_size);
+}
+
+static void cryp_update_add_output(struct cryp_update_batch *b,
+				   struct tee_crypto_update *upd,
+				   uint32_t kind)
+{
+	if (!upd->src_len) {
+		upd->dst_len = 0;
+		upd->res = TEE_SUCCESS;
+	} else if (upd->dst_len < upd->src_len) {
+		upd->dst_len = upd->src_len;
+		upd->res = TEE_ERROR_SHORT_BUFFER;
+	} else {
+		cryp_update_add(b, upd, kind);
+	}
+}
+
+TEE_Result tee_crypto_update_multiple(struct tee_crypto_update *upd,
+				      size_t count)
+{
+	struct cryp_update_batch b = { };
+	TEE_Result ret = TEE_SUCCESS;
+	size_t n = 0;
+
+	if (!upd && count)
+		TEE_Panic(0);
+
+	for (n = 0; n < count; n++) {
+		struct tee_crypto_update *u = upd + n;
+		TEE_OperationHandle op = u->operation;
+
+		if (op == TEE_HANDLE_NULL || (!u->src && u->src_len))
+			TEE_Panic(0);
+
+		switch (op->info.operationClass) {
+		case TEE_OPERATION_DIGEST:
+			op->operationState = TEE_OPERATION_STATE_ACTIVE;
+			u->dst_len = 0;
+			u->res = TEE_SUCCESS;
+			if (u->src_len)
+				cryp_update_add(&b, u, UTEE_CRYP_UPDATE_HASH);
+			break;
+		case TEE_OPERATION_MAC:
+			if (!(op->info.handleState &
+			      TEE_HANDLE_FLAG_INITIALIZED) ||
+			    op->operationState != TEE_OPERATION_STATE_ACTIVE)
+				TEE_Panic(0);
+			u->dst_len = 0;
+			u->res = TEE_SUCCESS;
+			if (u->src_len)
+				cryp_update_add(&b, u, UTEE_CRYP_UPDATE_HASH);
+			break;
+		case TEE_OPERATION_CIPHER:
+			if (!(op->info.handleState &
+			      TEE_HANDLE_FLAG_INITIALIZED) ||
+			    op->operationState != TEE_OPERATION_STATE_ACTIVE)
+				TEE_Panic(0);
+			if (update_is_unbuffered(op, u->src_len)) {
+				cryp_update_add_output(&b, u,
+						       UTEE_CRYP_UPDATE_CIPHER);
+			} else {
+				cryp_update_flush(&b);
+				u->res = TEE_CipherUpdate(op, u->src, u->src_len,
+							  u->dst, &u->dst_len);
+			}
+			break;
+		case TEE_OPERATION_AE:
+			if (!(op->info.handleState &
+			      TEE_HANDLE_FLAG_INITIALIZED))
+				TEE_Panic(0);
+			if (update_is_unbuffered(op, u->src_len)) {
+				cryp_update_add_output(&b, u,
+						       UTEE_CRYP_UPDATE_AE);
+				if (u->res == TEE_SUCCESS)
+					op->operationState =
+						TEE_OPERATION_STATE_ACTIVE;
+			} else {
+				cryp_update_flush(&b);
+				u->res = TEE_AEUpdate(op, u->src, u->src_len,
+						      u->dst, &u->dst_len);
+			}
+			break;
+		default:
+			TEE_Panic(0);
+		}
+
+		if (u->res == TEE_ERROR_SHORT_BUFFER)
+			ret = TEE_ERROR_SHORT_BUFFER;
+	}
+
+	cryp_update_flush(&b);
+
+	return ret;
+}
+
 TEE_Result TEE_AEEncryptFinal(TEE_OperationHandle operation,
 			      const void *srcData, uint32_t srcLen,
 			      void *destData, uint32_t *destLen, void *tag,
@@ -1960,6 +2138,10 @@ TEE_Result TEE_IsAlgorithmSupported(uint32_t alg, uint32_t element)
 		if (alg == TEE_ALG_SM3)
 			goto check_element_none;
 	}
+	if (IS_ENABLED(CFG_CRYPTO_CHACHA20_POLY1305)) {
+		if (alg == TEE_ALG_CHACHA20_POLY1305)
+			goto check_element_none;
+	}
 	if (IS_ENABLED(CFG_CRYPTO_SM4)) {
 		if (IS_ENABLED(CFG_CRYPTO_ECB)) {
 			if (alg == TEE_ALG_SM4_ECB_NOPAD)
@@ -2067,6 +2249,14 @@ TEE_Result TEE_IsAlgorithmSupported(uint32_t alg, uint32_t element)
 		if (alg == TEE_ALG_SM2_PKE && element == TEE_ECC_CURVE_SM2)
 			return TEE_SUCCESS;
 	}
+	if (IS_ENABLED(CFG_CRYPTO_X25519)) {
+		if (alg == TEE_ALG_X25519 && element == TEE_ECC_CURVE_25519)
+			return TEE_SUCCESS;
+	}
+	if (IS_ENABLED(CFG_CRYPTO_ED25519)) {
+		if (alg == TEE_ALG_ED25519 && element == TEE_ECC_CURVE_25519)
+			return TEE_SUCCESS;
+	}
 
 	return TEE_ERROR_NOT_SUPPORTED;
 check_element_none:
@@ -112,6 +112,18 @@ CFG_WITH_SOFTWARE_PRNG ?= y
 # Number of threads
 CFG_NUM_THREADS ?= 2
 
+# CFG_CORE_THREAD_ADMISSION, when enabled, standard calls refused because
+# all threads are busy are remembered in a queue of
+# CFG_CORE_THREAD_ADMISSION_QUEUE_SIZE entries. Threads becoming free are
+# then reserved for the queued calls, the first of them retried by the
+# normal world gets the thread, instead of going to whichever new call
+# happens to come first.
+# Queued calls not retried within CFG_CORE_THREAD_ADMISSION_TIMEOUT_MS
+# milliseconds are dropped. Statistics are available via the stats PTA.
+CFG_CORE_THREAD_ADMISSION ?= n
+CFG_CORE_THREAD_ADMISSION_QUEUE_SIZE ?= 16
+CFG_CORE_THREAD_ADMISSION_TIMEOUT_MS ?= 100
+
 # API implementation version
 CFG_TEE_API_VERSION ?= GPD-1.1-dev
 
@@ -310,6 +322,20 @@ CFG_REE_FS_TA ?= y
 CFG_REE_FS_TA_BUFFERED ?= n
 $(eval $(call cfg-depends-all,CFG_REE_FS_TA_BUFFERED,CFG_REE_FS_TA))
 
+# Cache of TA binaries loaded from the REE filesystem
+#
+# When CFG_REE_FS_TA_CACHE=y the verified, and if needed decrypted, TA
+# binaries buffered with CFG_REE_FS_TA_BUFFERED=y are kept in the "Secure
+# DDR" pool once closed, using at most CFG_REE_FS_TA_CACHE_SIZE bytes. The
+# signed header is still loaded via tee-supplicant and verified each time
+# a TA is opened, a cached binary is only used if the UUID, the digest of
+# the binary and the TA version match that header. The TA version
+# database is still checked against the cached binary. Cached binaries
+# are evicted when the "Secure DDR" pool runs out of memory.
+CFG_REE_FS_TA_CACHE ?= n
+CFG_REE_FS_TA_CACHE_SIZE ?= 0x100000
+$(eval $(call cfg-depends-all,CFG_REE_FS_TA_CACHE,CFG_REE_FS_TA_BUFFERED))
+
 # When CFG_REE_FS=y and CFG_RPMB_FS=y:
 # Allow secure storage in the REE FS to be entirely deleted without causing
 # anti-rollback errors. That is, rm /data/tee/dirf.db or rm -rf /data/tee (or
@@ -361,12 +387,29 @@ endif
 
 ifeq ($(CFG_EMBEDDED_TS),y)
 $(call force,CFG_ZLIB,y)
+$(call force,CFG_LZ4,y)
 endif
 
 # By default the early TAs are compressed in the TEE binary, it is possible to
 # not compress them with CFG_EARLY_TA_COMPRESS=n
 CFG_EARLY_TA_COMPRESS ?= y
 
+# CFG_EMBEDDED_TS_COMPRESS_ALGO selects how early TAs and secure partitions
+# are compressed in the TEE binary:
+# deflate: best compression ratio
+# lz4: larger images, but several times faster to decompress
+# The algorithm can be selected for a specific TA or SP by setting
+# EMBEDDED_TS_COMPRESS_ALGO_<uuid>, for instance:
+# EMBEDDED_TS_COMPRESS_ALGO_8aaaf200-2450-11e4-abe2-0002a5d5c51b=lz4
+CFG_EMBEDDED_TS_COMPRESS_ALGO ?= deflate
+
+# CFG_EMBEDDED_TS_CACHE_SIZE is the maximum number of bytes of heap used to
+# keep decompressed early TAs and secure partitions for subsequent opens.
+# Each image is decompressed once and unused images are evicted least
+# recently used first when room is needed. Images which don't fit, or if
+# the heap is exhausted, are decompressed on each open as when this is 0.
+CFG_EMBEDDED_TS_CACHE_SIZE ?= 0
+
 # Enable paging, requires SRAM, can't be enabled by default
 CFG_WITH_PAGER ?= n
 
@@ -546,10 +589,70 @@ ifeq (y-y,$(CFG_TA_GPROF_SUPPORT)-$(CFG_ULIBS_SHARED))
 $(error CFG_TA_GPROF_SUPPORT and CFG_ULIBS_SHARED are currently incompatible)
 endif
 
+# CFG_TA_LAZY_BINDING
+# When enabled ldelf leaves the PLT relocations (R_ARM_JUMP_SLOT and
+# R_AARCH64_JUMP_SLOT) of a TA and its shared libraries unresolved at load
+# time. Each entry is instead resolved by ldelf the first time the function
+# is called. This shortens load time of TAs importing many functions they
+# don't use, at the cost of a small delay on the first call of each. Modules
+# linked with -z now are still bound at load time as are 32-bit TAs loaded
+# by a 64-bit ldelf. Leave disabled to have all symbols resolved, and
+# checked, before the TA runs.
+CFG_TA_LAZY_BINDING ?= n
+
+# CFG_TA_RELR
+# When enabled TAs and shared libraries are linked with
+# -z pack-relative-relocs, storing their R_*_RELATIVE relocations in the
+# compact DT_RELR format instead of one DT_RELA or DT_REL entry each. This
+# makes the ELF smaller and faster to relocate. Requires binutils 2.38 or
+# later, and TAs built this way can only be loaded by an ldelf with DT_RELR
+# support.
+CFG_TA_RELR ?= n
+
+# CFG_BOOT_PROFILE
+# When enabled each preinitcall, initcall and finalcall, and each DT driver
+# probe including re-probes of deferred drivers, is timed with the generic
+# counter. The first CFG_BOOT_PROFILE_ENTRIES calls are recorded and
+# printed just before the primary CPU switches to normal world boot. They
+# can also be retrieved with the stats pseudo TA. Intended for development
+# only.
+CFG_BOOT_PROFILE ?= n
+CFG_BOOT_PROFILE_ENTRIES ?= 256
+
 # CFG_GP_SOCKETS
 # Enable Global Platform Sockets support
 CFG_GP_SOCKETS ?= y
 
+# CFG_TA_ZERO_COPY_PARAM
+# When a TA invokes another TA with memory references pointing into its
+# own private memory the buffers are by default copied into a temporary
+# secure buffer and copied back when the call returns. With this option
+# enabled the pages of the calling TA are instead mapped into the called
+# TA for the duration of the call, read-only for input memrefs. Note that
+# the called TA gains access to the complete pages covered by the memrefs,
+# not only to the buffers. This is incompatible with paged user TAs.
+CFG_TA_ZERO_COPY_PARAM ?= n
+
+ifeq (y-y,$(CFG_PAGED_USER_TA)-$(CFG_TA_ZERO_COPY_PARAM))
+$(error CFG_PAGED_USER_TA and CFG_TA_ZERO_COPY_PARAM are incompatible)
+endif
+
+# CFG_TA_SHARE_RELOC_PAGES
+# When enabled and TAs are loaded at a deterministic address, that is with
+# CFG_TA_ASLR=n, the writeable segments (.data, .got, .bss) of a TA are
+# shared between instances once ldelf has relocated them. The first
+# instance of a TA donates its relocated pages as a read-only snapshot,
+# later instances with identical pages map the snapshot instead of keeping
+# their own copy. A page gets a private copy on the first write to it.
+# The number of shared pages is reported by the stats pseudo TA. The
+# private copies are made by the abort handler so this is incompatible
+# with the pager.
+CFG_TA_SHARE_RELOC_PAGES ?= n
+
+ifeq (y-y,$(CFG_WITH_PAGER)-$(CFG_TA_SHARE_RELOC_PAGES))
+$(error CFG_WITH_PAGER and CFG_TA_SHARE_RELOC_PAGES are incompatible)
+endif
+
 # Enable Secure Data Path support in OP-TEE core (TA may be invoked with
 # invocation parameters referring to specific secure memories).
 CFG_SECURE_DATA_PATH ?= n
@@ -699,7 +802,11 @@ CFG_WITH_STMM_SP ?= n
 endif
 ifeq ($(CFG_WITH_STMM_SP),y)
 $(call force,CFG_ZLIB,y)
+$(call force,CFG_LZ4,y)
 endif
+# CFG_STMM_COMPRESS_ALGO selects how the StandaloneMM image is compressed
+# in the TEE binary, deflate or lz4. See CFG_EMBEDDED_TS_COMPRESS_ALGO.
+CFG_STMM_COMPRESS_ALGO ?= deflate
 
 # When enabled checks that buffers passed to the GP Internal Core API
 # comply with the rules added as annotations as part of the definition of
@@ -799,5 +906,16 @@ endif
 # CFG_CORE_ASYNC_NOTIF_GIC_INTID defined.
 CFG_CORE_ASYNC_NOTIF ?= n
 
+# CFG_DEFERRED_DRIVER_INIT
+# When enabled driver initializations registered with
+# driver_init_deferred() or deferred_init_add() are run in an asynchronous
+# notification bottom half requested on the first yielding call from
+# normal world instead of during boot. This lets normal world boot
+# continue while slow devices are brought up. Consumers of such a device
+# call deferred_init_wait() before using it, which also initializes the
+# device on demand. See core/include/kernel/deferred_init.h.
+CFG_DEFERRED_DRIVER_INIT ?= n
+$(eval $(call cfg-depends-all,CFG_DEFERRED_DRIVER_INIT,CFG_CORE_ASYNC_NOTIF))
+
 $(eval $(call cfg-enable-all-depends,CFG_MEMPOOL_REPORT_LAST_OFFSET, \
 	 CFG_WITH_STATS))
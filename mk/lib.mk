@@ -62,11 +62,15 @@ ifeq ($(CFG_ULIBS_SHARED),y)
 ifeq ($(sm)-$(CFG_TA_BTI),ta_arm64-y)
 lib-ldflags$(libuuid) += $$(call ld-option,-z force-bti) --fatal-warnings
 endif
+ifeq ($(CFG_TA_RELR),y)
+lib-ldflags$(libuuid) += -z pack-relative-relocs
+endif
 $(lib-shlibfile): $(objs) $(lib-needed-so-files)
 	@$(cmd-echo-silent) '  LD      $$@'
 	@mkdir -p $$(dir $$@)
 	$$(q)$$(LD$(sm)) $(lib-ldflags) -shared -z max-page-size=4096 \
 		$(call ld-option,-z separate-loadable-segments) \
+		$(call ld-option,--hash-style=both) \
 		$$(lib-ldflags$(libuuid)) \
 		--soname=$(libuuid) -o $$@ $$(filter-out %.so,$$^) $(lib-Ll-args)
 
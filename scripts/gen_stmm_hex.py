@@ -5,6 +5,7 @@
 #
 
 import argparse
+import lz4_pack
 import sys
 import zlib
 
@@ -20,6 +21,10 @@ def get_args():
                         required=True, type=argparse.FileType('w'),
                         help='The output stmm_hex.c')
 
+    parser.add_argument('--compress',
+                        default='deflate', choices=['deflate', 'lz4'],
+                        help='Compression algorithm of the image')
+
     return parser.parse_args()
 
 
@@ -30,7 +35,10 @@ def main():
 
     bytes = inf.read()
     uncompressed_size = len(bytes)
-    bytes = zlib.compress(bytes)
+    if args.compress == 'lz4':
+        bytes = lz4_pack.compress(bytes)
+    else:
+        bytes = zlib.compress(bytes)
     size = len(bytes)
 
     outf.write('/* Automatically generated, do no edit */\n')
@@ -50,6 +58,8 @@ def main():
     outf.write('const unsigned int stmm_image_size = sizeof(stmm_image);\n')
     outf.write('const unsigned int stmm_image_uncompressed_size = '
                '{:d};\n'.format(uncompressed_size))
+    outf.write('const unsigned int stmm_image_lz4 = '
+               '{:d};\n'.format(args.compress == 'lz4'))
 
     inf.close()
     outf.close()
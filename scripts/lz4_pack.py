@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: BSD-2-Clause
+#
+# Copyright (c) 2026, agent
+#
+# Compresses data with the LZ4 block format into independently compressed
+# blocks as described in core/include/kernel/lz4.h.
+#
+
+import argparse
+import struct
+
+BLOCK_SIZE = 32 * 1024
+STORED = 0x80000000
+
+MIN_MATCH = 4
+# The last match must start at least 12 bytes before the end of the block
+MF_LIMIT = 12
+# The last 5 bytes of a block are always literals
+LAST_LITERALS = 5
+MAX_OFFSET = 0xffff
+
+
+def _write_len(out, n):
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+
+def _emit(out, literals, offset, match_len):
+    lit_len = len(literals)
+    token = min(lit_len, 15) << 4
+    if offset:
+        token |= min(match_len - MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        _write_len(out, lit_len - 15)
+    out += literals
+    if offset:
+        out += struct.pack('<H', offset)
+        if match_len - MIN_MATCH >= 15:
+            _write_len(out, match_len - MIN_MATCH - 15)
+
+
+def compress_block(src):
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    n = len(src)
+
+    while i < n - MF_LIMIT:
+        key = src[i:i + MIN_MATCH]
+        cand = table.get(key)
+        table[key] = i
+        if cand is None or i - cand > MAX_OFFSET:
+            i += 1
+            continue
+
+        match_len = MIN_MATCH
+        max_len = n - LAST_LITERALS - i
+        while match_len < max_len and src[cand + match_len] == \
+                src[i + match_len]:
+            match_len += 1
+
+        _emit(out, src[anchor:i], i - cand, match_len)
+        i += match_len
+        anchor = i
+
+    _emit(out, src[anchor:], 0, 0)
+    return bytes(out)
+
+
+def compress(data):
+    out = bytearray()
+    for n in range(0, len(data), BLOCK_SIZE):
+        blk = data[n:n + BLOCK_SIZE]
+        c = compress_block(blk)
+        if len(c) >= len(blk):
+            out += struct.pack('<I', len(blk) | STORED)
+            out += blk
+        else:
+            out += struct.pack('<I', len(c))
+            out += c
+    return bytes(out)
+
+
+def _decompress_block(src, dst_len):
+    out = bytearray()
+    i = 0
+    while True:
+        token = src[i]
+        i += 1
+        n = token >> 4
+        if n == 15:
+            while True:
+                b = src[i]
+                i += 1
+                n += b
+                if b != 255:
+                    break
+        out += src[i:i + n]
+        i += n
+        if i == len(src):
+            break
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        n = token & 0xf
+        if n == 15:
+            while True:
+                b = src[i]
+                i += 1
+                n += b
+                if b != 255:
+                    break
+        n += MIN_MATCH
+        for _ in range(n):
+            out.append(out[-offset])
+    if len(out) != dst_len:
+        raise Exception('Bad block size')
+    return bytes(out)
+
+
+def decompress(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        (hdr,) = struct.unpack_from('<I', data, i)
+        i += 4
+        blk_len = hdr & ~STORED
+        blk_size = min(size - len(out), BLOCK_SIZE)
+        if hdr & STORED:
+            out += data[i:i + blk_len]
+        else:
+            out += _decompress_block(data[i:i + blk_len], blk_size)
+        i += blk_len
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Round trip test of the LZ4 block compression')
+    parser.add_argument('file', help='File to compress')
+    args = parser.parse_args()
+
+    with open(args.file, 'rb') as f:
+        data = f.read()
+    c = compress(data)
+    if decompress(c, len(data)) != data:
+        raise Exception('Round trip failed')
+    print('{}: {} -> {} bytes'.format(args.file, len(data), len(c)))
+
+
+if __name__ == "__main__":
+    main()
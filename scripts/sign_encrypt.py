@@ -19,6 +19,10 @@ SHDR_ENCRYPTED_TA = 2
 SHDR_MAGIC = 0x4f545348
 SHDR_SIZE = 20
 
+# Program header recording the load address of a prelinked TA, must match
+# PT_OPTEE_PRELINK in ldelf/ta_elf.h
+PT_OPTEE_PRELINK = 0x6fff0000
+
 
 def uuid_parse(s):
     from uuid import UUID
@@ -51,8 +55,9 @@ def get_args(logger):
         ' TA image file.\n' +
         '                 Takes arguments --uuid, --ta-version, --in, --out,' +
         ' --key,\n' +
-        '                 --enc-key (optional) and' +
-        ' --enc-key-type (optional).\n' +
+        '                 --enc-key (optional), --enc-key-type (optional)' +
+        ' and\n' +
+        '                 --prelink-addr (optional).\n' +
         '     digest      Generate loadable TA binary image digest' +
         ' for offline\n' +
         '                 signing. Takes arguments --uuid, --ta-version,' +
@@ -126,6 +131,13 @@ def get_args(logger):
     parser.add_argument(
         '--out', required=False, dest='outf',
         help='Name of application output file, defaults to <UUID>.ta')
+    parser.add_argument(
+        '--prelink-addr', required=False, type=int_parse,
+        help='Apply the relative relocations of the TA for this load\n' +
+        'address. ldelf skips them when the TA is loaded there, which\n' +
+        'requires ASLR to be disabled. The address is recorded in a\n' +
+        'program header added in the first page, which requires the\n' +
+        'ELF header not to be part of a load segment (main TAs).')
     parser.add_argument('--algo', required=False, choices=list(algo.keys()),
                         default='TEE_ALG_RSASSA_PKCS1_PSS_MGF1_SHA256',
                         help='The hash and signature algorithm, ' +
@@ -166,6 +178,157 @@ def get_args(logger):
     return parsed
 
 
+def prelink_elf(img, base):
+    import struct
+
+    ELFCLASS32 = 1
+    ELFCLASS64 = 2
+    ET_DYN = 3
+    PT_LOAD = 1
+    PT_DYNAMIC = 2
+    PT_PHDR = 6
+    PF_R = 4
+    SHT_NOBITS = 8
+    DT_NULL = 0
+    DT_RELA = 7
+    DT_RELASZ = 8
+    DT_REL = 17
+    DT_RELSZ = 18
+    DT_RELRSZ = 35
+    DT_RELR = 36
+    R_ARM_RELATIVE = 23
+    R_AARCH64_RELATIVE = 1027
+
+    if img[:4] != b'\x7fELF':
+        raise Exception('Input is not an ELF file')
+    if img[5] != 1:
+        raise Exception('Only little endian ELF files can be prelinked')
+
+    if img[4] == ELFCLASS32:
+        ehdr_fmt, phdr_fmt, dyn_fmt = '<HHIIIIIHHHHHH', '<IIIIIIII', '<iI'
+        shdr_fmt = '<IIIIII'
+        word_fmt = '<I'
+        word_mask = 0xffffffff
+    elif img[4] == ELFCLASS64:
+        ehdr_fmt, phdr_fmt, dyn_fmt = '<HHIQQQIHHHHHH', '<IIQQQQQQ', '<qQ'
+        shdr_fmt = '<IIQQQQ'
+        word_fmt = '<Q'
+        word_mask = 0xffffffffffffffff
+    else:
+        raise Exception('Unknown ELF class {}'.format(img[4]))
+
+    if base & 0xfff:
+        raise Exception('Prelink address must be page aligned')
+
+    (e_type, _, _, _, e_phoff, e_shoff, _, _, e_phentsize,
+     e_phnum, e_shentsize, e_shnum, _) = struct.unpack_from(ehdr_fmt, img, 16)
+    if e_type != ET_DYN:
+        raise Exception('Only position independent ELF files can be ' +
+                        'prelinked')
+
+    loads = []
+    dyn = None
+    for n in range(e_phnum):
+        phdr = struct.unpack_from(phdr_fmt, img, e_phoff + n * e_phentsize)
+        if img[4] == ELFCLASS32:
+            p_type, p_offset, p_vaddr, _, p_filesz = phdr[:5]
+        else:
+            p_type, _, p_offset, p_vaddr, _, p_filesz = phdr[:6]
+        if p_type == PT_LOAD:
+            loads.append((p_vaddr, p_offset, p_filesz))
+        elif p_type == PT_DYNAMIC:
+            dyn = (p_offset, p_filesz)
+        elif p_type == PT_PHDR:
+            raise Exception('Program headers in a load segment, can\'t ' +
+                            'add one')
+        elif p_type == PT_OPTEE_PRELINK:
+            raise Exception('ELF file is already prelinked')
+
+    # ldelf reads the program headers from the first page of the file,
+    # the new one is added in the padding up to the first segment.
+    phdr_offs = e_phoff + e_phnum * e_phentsize
+    phdr_end = phdr_offs + e_phentsize
+    used = [(p_offset, p_filesz) for (_, p_offset, p_filesz) in loads]
+    for n in range(e_shnum):
+        (_, sh_type, _, _, sh_offset, sh_size) = \
+            struct.unpack_from(shdr_fmt, img, e_shoff + n * e_shentsize)
+        if sh_type != SHT_NOBITS:
+            used.append((sh_offset, sh_size))
+    used.append((e_shoff, e_shnum * e_shentsize))
+    if phdr_end > 4096 or any(offs < phdr_end and offs + size > phdr_offs
+                              for (offs, size) in used if size):
+        raise Exception('No room for a program header in the first page')
+
+    def va_to_offs(va, size):
+        for (p_vaddr, p_offset, p_filesz) in loads:
+            if va >= p_vaddr and va + size <= p_vaddr + p_filesz:
+                return va - p_vaddr + p_offset
+        raise Exception('Address 0x{:x} not in file'.format(va))
+
+    if dyn is None:
+        raise Exception('No dynamic section found')
+
+    dyn_size = struct.calcsize(dyn_fmt)
+    tags = {}
+    for n in range(dyn[1] // dyn_size):
+        (tag, val) = struct.unpack_from(dyn_fmt, img, dyn[0] + n * dyn_size)
+        if tag == DT_NULL:
+            break
+        tags[tag] = val
+
+    out = bytearray(img)
+    word_size = struct.calcsize(word_fmt)
+    if img[4] == ELFCLASS32 and DT_REL in tags:
+        for n in range(tags[DT_RELSZ] // 8):
+            offs = va_to_offs(tags[DT_REL] + n * 8, 8)
+            (r_offset, r_info) = struct.unpack_from('<II', img, offs)
+            if r_info & 0xff != R_ARM_RELATIVE:
+                continue
+            where = va_to_offs(r_offset, word_size)
+            (val,) = struct.unpack_from(word_fmt, img, where)
+            struct.pack_into(word_fmt, out, where, (val + base) & word_mask)
+    elif img[4] == ELFCLASS64 and DT_RELA in tags:
+        for n in range(tags[DT_RELASZ] // 24):
+            offs = va_to_offs(tags[DT_RELA] + n * 24, 24)
+            (r_offset, r_info, r_addend) = struct.unpack_from('<QQq', img,
+                                                              offs)
+            if r_info & 0xffffffff != R_AARCH64_RELATIVE:
+                continue
+            where = va_to_offs(r_offset, word_size)
+            struct.pack_into(word_fmt, out, where,
+                             (r_addend + base) & word_mask)
+
+    def relocate_word(va):
+        where = va_to_offs(va, word_size)
+        (val,) = struct.unpack_from(word_fmt, img, where)
+        struct.pack_into(word_fmt, out, where, (val + base) & word_mask)
+
+    if DT_RELR in tags:
+        where = None
+        for n in range(tags[DT_RELRSZ] // word_size):
+            offs = va_to_offs(tags[DT_RELR] + n * word_size, word_size)
+            (entry,) = struct.unpack_from(word_fmt, img, offs)
+            if not entry & 1:
+                relocate_word(entry)
+                where = entry + word_size
+                continue
+            if where is None:
+                raise Exception('DT_RELR bitmap without address')
+            for bit in range(word_size * 8 - 1):
+                if entry & (2 << bit):
+                    relocate_word(where + bit * word_size)
+            where += (word_size * 8 - 1) * word_size
+
+    if img[4] == ELFCLASS32:
+        phdr = (PT_OPTEE_PRELINK, 0, base, base, 0, 0, PF_R, 4)
+    else:
+        phdr = (PT_OPTEE_PRELINK, PF_R, 0, base, base, 0, 0, 8)
+    struct.pack_into(phdr_fmt, out, phdr_offs, *phdr)
+    struct.pack_into('<H', out, 16 + struct.calcsize(ehdr_fmt[:10]),
+                     e_phnum + 1)
+    return bytes(out)
+
+
 def main():
     from cryptography import exceptions
     from cryptography.hazmat.backends import default_backend
@@ -204,6 +367,9 @@ def main():
     with open(args.inf, 'rb') as f:
         img = f.read()
 
+    if args.prelink_addr is not None and args.command != 'verify':
+        img = prelink_elf(img, args.prelink_addr)
+
     chosen_hash = hashes.SHA256()
     h = hashes.Hash(chosen_hash, default_backend())
 
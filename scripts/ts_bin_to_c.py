@@ -8,6 +8,7 @@
 import argparse
 import array
 from elftools.elf.elffile import ELFFile
+import lz4_pack
 import os
 import re
 import struct
@@ -39,9 +40,11 @@ def get_args():
     parser.add_argument(
         '--compress',
         dest="compress",
-        action="store_true",
-        help='Compress the image using the DEFLATE '
-        'algorithm')
+        nargs='?',
+        const='deflate',
+        choices=['deflate', 'lz4'],
+        help='Compress the image using the DEFLATE (default) '
+        'or the LZ4 algorithm')
 
     return parser.parse_args()
 
@@ -100,7 +103,9 @@ def main():
     with open(ts, 'rb') as _ts:
         bytes = _ts.read()
         uncompressed_size = len(bytes)
-        if args.compress:
+        if args.compress == 'lz4':
+            bytes = lz4_pack.compress(bytes)
+        elif args.compress:
             bytes = zlib.compress(bytes)
         size = len(bytes)
 
@@ -147,6 +152,10 @@ def main():
     if args.compress:
         f.write('\t.uncompressed_size = '
                 '{:d},\n'.format(uncompressed_size))
+        if args.compress == 'lz4':
+            f.write('\t.compression = EMB_TS_COMP_LZ4,\n')
+        else:
+            f.write('\t.compression = EMB_TS_COMP_DEFLATE,\n')
     f.write('};\n')
     f.close()
 
@@ -35,6 +35,11 @@ ifeq ($(sm)-$(CFG_TA_BTI),ta_arm64-y)
 link-ldflags += $(call ld-option,-z force-bti) --fatal-warnings
 endif
 link-ldflags += --as-needed # Do not add dependency on unused shlib
+# DT_GNU_HASH for faster symbol lookup, DT_HASH for older ldelf
+link-ldflags += $(call ld-option,--hash-style=both)
+ifeq ($(CFG_TA_RELR),y)
+link-ldflags += -z pack-relative-relocs
+endif
 link-ldflags += $(link-ldflags$(sm))
 
 $(link-out-dir$(sm))/dyn_list:
@@ -113,6 +118,7 @@ $(link-out-dir$(sm))/$(user-ta-uuid).ta: \
 	@$(cmd-echo-silent) '  $$(cmd-echo$(user-ta-uuid)) $$@'
 	$(q)$(SIGN_ENC) --key $(TA_SIGN_KEY) $$(crypt-args$(user-ta-uuid)) \
 		--uuid $(user-ta-uuid) --ta-version $(user-ta-version) \
+		$(if $(user-ta-prelink-addr),--prelink-addr $(user-ta-prelink-addr)) \
 		--in $$< --out $$@
 endef
 
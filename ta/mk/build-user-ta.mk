@@ -21,6 +21,7 @@ link-out-dir$(sm) := $(out-dir)/$(patsubst %/,%, $(dir $(ta-mk-file)))
 
 # Default if ta-mk-file defines none
 user-ta-version := 0
+user-ta-prelink-addr :=
 
 include $(ta-mk-file)
 ifeq ($(user-ta-uuid),)
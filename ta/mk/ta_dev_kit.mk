@@ -21,6 +21,7 @@ link-out-dir$(sm) := $(out-dir)
 
 user-ta-uuid := $(BINARY)
 user-ta-version := $(if $(CFG_TA_VERSION),$(CFG_TA_VERSION),0)
+user-ta-prelink-addr := $(CFG_TA_PRELINK_ADDR)
 user-ta-ldadd := $(LDADD)
 libname := $(LIBNAME)
 shlibname := $(SHLIBNAME)